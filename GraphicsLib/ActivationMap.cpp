@@ -0,0 +1,324 @@
+#include "ActivationMap.h"
+#include "Shader.h"
+#include <iostream>
+#include <fstream>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <math.h>
+
+const static unsigned int ACTIVATION_MAP_MAGIC = 0x4D41534D; /* "MSAM" */
+//Version 2 marches through the tetrahedra, maps of version 1 were marched along the edges only.
+const static unsigned int ACTIVATION_MAP_VERSION = 2;
+
+struct ActivationMapHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned long long inputHash;
+	unsigned int count;
+};
+
+
+ActivationMap::ActivationMap() :
+latest_time(0.0f)
+{
+}
+
+
+ActivationMap::~ActivationMap()
+{
+}
+
+
+bool ActivationMap::build(const vector<Vector3f> &positions, const vector<Vector2f> &edges, const vector<unsigned int> &tetrahedrons,
+	const vector<unsigned int> &sites, float velocity) {
+	size_t count = positions.size();
+	if (count == 0 || sites.empty() || velocity <= 0.0f) {
+		cerr << "[ActivationMap:build] Error: Needs particles, at least one pacing site and a positive velocity." << endl;
+		return false;
+	}
+
+	/* Neighbours of node p are neighbours[offsets[p]] up to neighbours[offsets[p + 1]], with the travel times along the edges. */
+	vector<unsigned int> offsets(count + 1, 0);
+	for (size_t i = 0; i < edges.size(); i++) {
+		size_t p0 = static_cast<size_t>(edges[i][0]);
+		size_t p1 = static_cast<size_t>(edges[i][1]);
+		if (p0 >= count || p1 >= count) {
+			cerr << "[ActivationMap:build] Error: Edge " << i << " refers to a particle out of " << count << "." << endl;
+			return false;
+		}
+		offsets[p0 + 1]++;
+		offsets[p1 + 1]++;
+	}
+	for (size_t p = 0; p < count; p++)
+		offsets[p + 1] += offsets[p];
+
+	vector<unsigned int> neighbours(offsets[count]);
+	vector<float> travel_times(offsets[count]);
+	vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i < edges.size(); i++) {
+		unsigned int p0 = static_cast<unsigned int>(edges[i][0]);
+		unsigned int p1 = static_cast<unsigned int>(edges[i][1]);
+		float time = Vector3f::Norm(positions[p1] - positions[p0]) / velocity;
+		neighbours[cursor[p0]] = p1; travel_times[cursor[p0]++] = time;
+		neighbours[cursor[p1]] = p0; travel_times[cursor[p1]++] = time;
+	}
+
+	/* The tetrahedra of node p are node_tets[tet_offsets[p]] up to node_tets[tet_offsets[p + 1]]. */
+	size_t tet_count = tetrahedrons.size() / 4;
+	vector<unsigned int> tet_offsets(count + 1, 0);
+	for (size_t i = 0; i < tet_count * 4; i++) {
+		if (tetrahedrons[i] >= count) {
+			cerr << "[ActivationMap:build] Error: Tetrahedron " << i / 4 << " refers to a particle out of " << count << "." << endl;
+			return false;
+		}
+		tet_offsets[tetrahedrons[i] + 1]++;
+	}
+	for (size_t p = 0; p < count; p++)
+		tet_offsets[p + 1] += tet_offsets[p];
+
+	vector<unsigned int> node_tets(tet_offsets[count]);
+	cursor.assign(tet_offsets.begin(), tet_offsets.end() - 1);
+	for (size_t i = 0; i < tet_count * 4; i++)
+		node_tets[cursor[tetrahedrons[i]]++] = static_cast<unsigned int>(i / 4);
+
+	/* The heap may hold outdated entries of a node, they are skipped once the node is settled. */
+	typedef pair<float, unsigned int> Arrival;
+	priority_queue< Arrival, vector<Arrival>, greater<Arrival> > front;
+	vector<bool> settled(count, false);
+	const float unreached = -1.0f;
+	this->times.assign(count, unreached);
+
+	for (size_t i = 0; i < sites.size(); i++) {
+		if (sites[i] >= count) {
+			cerr << "[ActivationMap:build] Error: Pacing site " << sites[i] << " is not one of the " << count << " particles." << endl;
+			return false;
+		}
+		this->times[sites[i]] = 0.0f;
+		front.push(Arrival(0.0f, sites[i]));
+	}
+
+	this->latest_time = 0.0f;
+	while (!front.empty()) {
+		Arrival arrival = front.top();
+		front.pop();
+
+		unsigned int p = arrival.second;
+		if (settled[p]) continue;
+		settled[p] = true;
+		this->latest_time = arrival.first;
+
+		/* Along the edges, the wave through p alone. */
+		for (unsigned int i = offsets[p]; i < offsets[p + 1]; i++) {
+			unsigned int q = neighbours[i];
+			float time = arrival.first + travel_times[i];
+			if (!settled[q] && (this->times[q] == unreached || time < this->times[q])) {
+				this->times[q] = time;
+				front.push(Arrival(time, q));
+			}
+		}
+
+		/* Through the tetrahedra, the waves through p and the other settled nodes of each one. */
+		for (unsigned int i = tet_offsets[p]; i < tet_offsets[p + 1]; i++) {
+			const unsigned int *tet = &tetrahedrons[4 * node_tets[i]];
+			for (size_t j = 0; j < 4; j++) {
+				unsigned int q = tet[j];
+				if (q == p || settled[q])
+					continue;
+
+				//The settled nodes of the tetrahedron besides p, at most the two left.
+				unsigned int others[2];
+				int other_count = 0;
+				for (size_t k = 0; k < 4; k++)
+					if (tet[k] != p && tet[k] != q && settled[tet[k]])
+						others[other_count++] = tet[k];
+
+				Vector3f known[3] = { positions[p] };
+				float known_times[3] = { arrival.first };
+				float best = -1.0f;
+
+				//The edges (p, a), (p, b) and the face (p, a, b).
+				for (int k = 0; k < other_count; k++) {
+					known[1] = positions[others[k]];
+					known_times[1] = this->times[others[k]];
+					float time = ActivationMap::_planeWaveTime(positions[q], known, known_times, 2, velocity);
+					if (time >= 0.0f && (best < 0.0f || time < best))
+						best = time;
+				}
+
+				if (other_count == 2) {
+					known[1] = positions[others[0]];
+					known[2] = positions[others[1]];
+					known_times[1] = this->times[others[0]];
+					known_times[2] = this->times[others[1]];
+					float time = ActivationMap::_planeWaveTime(positions[q], known, known_times, 3, velocity);
+					if (time >= 0.0f && (best < 0.0f || time < best))
+						best = time;
+				}
+
+				if (best >= 0.0f && (this->times[q] == unreached || best < this->times[q])) {
+					this->times[q] = best;
+					front.push(Arrival(best, q));
+				}
+			}
+		}
+	}
+
+	for (size_t p = 0; p < count; p++)
+		if (this->times[p] == unreached)
+			this->times[p] = this->latest_time;
+
+	return true;
+}
+
+
+bool ActivationMap::buildCached(const string &cache_path, const vector<Vector3f> &positions, const vector<Vector2f> &edges,
+	const vector<unsigned int> &tetrahedrons, const vector<unsigned int> &sites, float velocity) {
+	if (cache_path.empty())
+		return this->build(positions, edges, tetrahedrons, sites, velocity);
+
+	unsigned long long hash = ActivationMap::_inputHash(positions, edges, tetrahedrons, sites, velocity);
+	if (this->_load(cache_path, hash, positions.size()))
+		return true;
+
+	if (!this->build(positions, edges, tetrahedrons, sites, velocity))
+		return false;
+
+	this->_save(cache_path, hash);
+	return true;
+}
+
+
+const vector<float>& ActivationMap::getTimes() const {
+	return this->times;
+}
+
+
+float ActivationMap::getLatestTime() const {
+	return this->latest_time;
+}
+
+
+void ActivationMap::getEdgeTimes(const vector<Vector2f> &edges, vector<float> &times) const {
+	times.resize(edges.size());
+	for (size_t i = 0; i < edges.size(); i++)
+		times[i] = 0.5f * (this->times[static_cast<size_t>(edges[i][0])] + this->times[static_cast<size_t>(edges[i][1])]);
+}
+
+
+unsigned long long ActivationMap::_inputHash(const vector<Vector3f> &positions, const vector<Vector2f> &edges, const vector<unsigned int> &tetrahedrons,
+	const vector<unsigned int> &sites, float velocity) {
+	unsigned long long hash = Shader::Hash(string(reinterpret_cast<const char*>(&velocity), sizeof(float)));
+	for (size_t i = 0; i < positions.size(); i++)
+		hash = Shader::Hash(string(reinterpret_cast<const char*>(positions[i].constData()), 3 * sizeof(float)), hash);
+	for (size_t i = 0; i < edges.size(); i++)
+		hash = Shader::Hash(string(reinterpret_cast<const char*>(edges[i].constData()), 2 * sizeof(float)), hash);
+	if (!tetrahedrons.empty())
+		hash = Shader::Hash(string(reinterpret_cast<const char*>(&tetrahedrons[0]), tetrahedrons.size() * sizeof(unsigned int)), hash);
+	if (!sites.empty())
+		hash = Shader::Hash(string(reinterpret_cast<const char*>(&sites[0]), sites.size() * sizeof(unsigned int)), hash);
+	return hash;
+}
+
+
+float ActivationMap::_planeWaveTime(const Vector3f &x, const Vector3f *known, const float *known_times, int known_count, float velocity) {
+	if (known_count == 1)
+		return known_times[0] + Vector3f::Norm(x - known[0]) / velocity;
+
+	/*	The times are linear over the simplex of the known nodes, with the gradient g in its plane (or line).
+	*	The wave reaching x leaves the simplex at y, where the in-plane part of the unit direction from y to x
+	*	is velocity * g. With x0 the foot of x on the plane and h its height, y = x0 - velocity * g * |x - y|
+	*	and |x - y| = h / sqrt(1 - |velocity * g|^2). Only a y inside the simplex is a valid update, the
+	*	edges and vertices of the simplex are tried separately.	*/
+	Vector3f e1 = known[1] - known[0];
+	Vector3f a = x - known[0];
+	float dt1 = known_times[1] - known_times[0];
+
+	if (known_count == 2) {
+		float length2 = Vector3f::Dot(e1, e1);
+		if (length2 <= 0.0f)
+			return -1.0f;
+
+		float alpha = dt1 / length2;
+		float s0 = Vector3f::Dot(a, e1) / length2;
+		float h = Vector3f::Norm(a - e1 * s0);
+		float w2 = velocity * velocity * alpha * dt1;
+		if (w2 >= 1.0f)
+			return -1.0f;
+
+		float distance = h / sqrtf(1.0f - w2);
+		float s = s0 - velocity * distance * alpha;
+		if (s < 0.0f || s > 1.0f)
+			return -1.0f;
+
+		return known_times[0] + s * dt1 + distance / velocity;
+	}
+
+	Vector3f e2 = known[2] - known[0];
+	float dt2 = known_times[2] - known_times[0];
+	float g11 = Vector3f::Dot(e1, e1), g12 = Vector3f::Dot(e1, e2), g22 = Vector3f::Dot(e2, e2);
+	float det = g11 * g22 - g12 * g12;
+	if (det <= 1e-12f * g11 * g22)
+		return -1.0f;
+
+	//Gradient g = alpha e1 + beta e2 with g.e1 = dt1 and g.e2 = dt2, and the foot x0 = known[0] + s0 e1 + r0 e2.
+	float alpha = (g22 * dt1 - g12 * dt2) / det;
+	float beta = (g11 * dt2 - g12 * dt1) / det;
+	float ae1 = Vector3f::Dot(a, e1), ae2 = Vector3f::Dot(a, e2);
+	float s0 = (g22 * ae1 - g12 * ae2) / det;
+	float r0 = (g11 * ae2 - g12 * ae1) / det;
+	float h = Vector3f::Norm(a - e1 * s0 - e2 * r0);
+	float w2 = velocity * velocity * (alpha * dt1 + beta * dt2);
+	if (w2 >= 1.0f)
+		return -1.0f;
+
+	float distance = h / sqrtf(1.0f - w2);
+	float s = s0 - velocity * distance * alpha;
+	float r = r0 - velocity * distance * beta;
+	if (s < 0.0f || r < 0.0f || s + r > 1.0f)
+		return -1.0f;
+
+	return known_times[0] + s * dt1 + r * dt2 + distance / velocity;
+}
+
+
+bool ActivationMap::_load(const string &path, unsigned long long hash, size_t node_count) {
+	ifstream file(path.c_str(), ios::binary);
+	if (!file.is_open()) return false;
+
+	ActivationMapHeader header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(ActivationMapHeader));
+	if (!file) return false;
+
+	if (header.magic != ACTIVATION_MAP_MAGIC || header.version != ACTIVATION_MAP_VERSION) return false;
+	if (header.inputHash != hash || header.count != node_count || node_count == 0) return false;
+
+	vector<float> loaded(node_count);
+	file.read(reinterpret_cast<char*>(&loaded[0]), node_count * sizeof(float));
+	if (!file) return false;
+
+	this->times.swap(loaded);
+	this->latest_time = 0.0f;
+	for (size_t p = 0; p < node_count; p++)
+		this->latest_time = max(this->latest_time, this->times[p]);
+	return true;
+}
+
+
+bool ActivationMap::_save(const string &path, unsigned long long hash) const {
+	ActivationMapHeader header;
+	header.magic = ACTIVATION_MAP_MAGIC;
+	header.version = ACTIVATION_MAP_VERSION;
+	header.inputHash = hash;
+	header.count = static_cast<unsigned int>(this->times.size());
+
+	ofstream file(path.c_str(), ios::binary | ios::trunc);
+	if (!file.is_open()) {
+		cerr << "[ActivationMap:_save] Error: Cannot write activation map: " << path << endl;
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(ActivationMapHeader));
+	file.write(reinterpret_cast<const char*>(&this->times[0]), this->times.size() * sizeof(float));
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "ActivationWaveform.h"
+#include <iostream>
+#include <math.h>
+
+static const float PI = 3.14159265358979f;
+
+//3 t^2 - 2 t^3, 0 at 0 and 1 at 1 with zero slope at both.
+static inline float smoothstep(float t) {
+	return t * t * (3.0f - 2.0f * t);
+}
+
+
+ActivationWaveform::ActivationWaveform() :
+systole(0.3f),
+relaxation(0.2f)
+{
+}
+
+
+ActivationWaveform::~ActivationWaveform()
+{
+}
+
+
+bool ActivationWaveform::setAnalytic(float systole, float relaxation) {
+	if (systole <= 0.0f || relaxation <= 0.0f || systole + relaxation > 1.0f) {
+		cerr << "[ActivationWaveform:setAnalytic] Error: The systole (" << systole << ") and relaxation (" << relaxation << ") must be positive and fit into one cycle." << endl;
+		return false;
+	}
+
+	this->systole = systole;
+	this->relaxation = relaxation;
+	this->key_phases.clear();
+	this->key_levels.clear();
+	return true;
+}
+
+
+bool ActivationWaveform::setKeyframes(const vector<float> &phases, const vector<float> &levels) {
+	if (phases.empty() || phases.size() != levels.size()) {
+		cerr << "[ActivationWaveform:setKeyframes] Error: " << phases.size() << " phases for " << levels.size() << " levels." << endl;
+		return false;
+	}
+
+	for (size_t i = 0; i < phases.size(); i++) {
+		if (phases[i] < 0.0f || phases[i] >= 1.0f || (i > 0 && phases[i] <= phases[i - 1])) {
+			cerr << "[ActivationWaveform:setKeyframes] Error: Phase " << i << " (" << phases[i] << ") is not increasing within [0, 1)." << endl;
+			return false;
+		}
+	}
+
+	this->key_phases = phases;
+	this->key_levels = levels;
+	return true;
+}
+
+
+float ActivationWaveform::evaluate(float phase) const {
+	phase -= floorf(phase);
+
+	if (this->key_phases.empty()) {
+		if (phase < this->systole)
+			return 0.5f - 0.5f * cosf(PI * phase / this->systole);
+		if (phase < this->systole + this->relaxation)
+			return 0.5f + 0.5f * cosf(PI * (phase - this->systole) / this->relaxation);
+		return 0.0f;
+	}
+
+	/* The segment containing phase, wrapping from the last key around to the first. */
+	size_t count = this->key_phases.size();
+	size_t next = 0;
+	while (next < count && this->key_phases[next] <= phase)
+		next++;
+
+	size_t previous = (next + count - 1) % count;
+	next %= count;
+
+	float begin = this->key_phases[previous];
+	float length = this->key_phases[next] - begin;
+	float offset = phase - begin;
+	if (length <= 0.0f) length += 1.0f;
+	if (offset < 0.0f) offset += 1.0f;
+
+	float t = smoothstep(offset / length);
+	return this->key_levels[previous] + (this->key_levels[next] - this->key_levels[previous]) * t;
+}
+
+
+bool ActivationWaveform::isKeyframed() const {
+	return !this->key_phases.empty();
+}
\ No newline at end of file
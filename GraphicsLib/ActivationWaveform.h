@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+/*
+*	Contraction level of the heart over one cardiac cycle, from 0 (relaxed) to 1 (full systole).
+*	It is evaluated at simulation time inside every step, so the rest lengths follow a continuous
+*	curve instead of jumping at each beat. Smooth forcing injects no impulses, which keeps the
+*	explicit integration stable at larger time steps.
+*
+*	The default is an analytic profile: a raised cosine contraction followed by a raised cosine
+*	relaxation, both with zero slope at their ends. Keyframes may replace it.	*/
+class ActivationWaveform
+{
+public:
+	ActivationWaveform();
+	~ActivationWaveform();
+
+	/*	Analytic profile. @systole, the fraction of the cycle spent contracting, @relaxation, the fraction
+	*	spent relaxing right after it. The rest of the cycle is relaxed.	*/
+	bool setAnalytic(float systole, float relaxation);
+
+	/*	Keyframed profile, periodic over the cycle. @phases, strictly increasing within [0, 1). @levels,
+	*	the contraction at each of them. Consecutive keys are joined with smoothstep, which has zero slope
+	*	at the keys, so the curve is continuous with a continuous derivative and never overshoots.	*/
+	bool setKeyframes(const vector<float> &phases, const vector<float> &levels);
+
+	//The contraction at @phase, measured in cycles. Whole cycles are ignored.
+	float evaluate(float phase) const;
+
+	bool isKeyframed() const;
+
+protected:
+	float systole;
+	float relaxation;
+
+	//Empty for the analytic profile.
+	vector<float> key_phases;
+	vector<float> key_levels;
+};
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "CavityVolumeTracker.h"
+#include <algorithm>
+
+
+CavityVolumeTracker::CavityVolumeTracker() :
+largest_volume(0.0),
+smallest_volume(0.0),
+sample_count(0)
+{
+}
+
+
+CavityVolumeTracker::~CavityVolumeTracker()
+{
+}
+
+
+void CavityVolumeTracker::addSample(double volume) {
+	if (this->sample_count == 0) {
+		this->largest_volume = volume;
+		this->smallest_volume = volume;
+	}
+	else {
+		this->largest_volume = max(this->largest_volume, volume);
+		this->smallest_volume = min(this->smallest_volume, volume);
+	}
+
+	this->sample_count++;
+}
+
+
+bool CavityVolumeTracker::endBeat() {
+	if (this->sample_count == 0)
+		return false;
+
+	BeatVolumes beat;
+	beat.end_diastolic = this->largest_volume;
+	beat.end_systolic = this->smallest_volume;
+	beat.ejection_fraction = (beat.end_diastolic > 0.0) ? (beat.end_diastolic - beat.end_systolic) / beat.end_diastolic : 0.0;
+	this->beats.push_back(beat);
+
+	this->sample_count = 0;
+	return true;
+}
+
+
+void CavityVolumeTracker::reset() {
+	this->beats.clear();
+	this->sample_count = 0;
+}
+
+
+size_t CavityVolumeTracker::getBeatCount() const {
+	return this->beats.size();
+}
+
+
+const BeatVolumes& CavityVolumeTracker::getLastBeat() const {
+	return this->beats.back();
+}
+
+
+const vector<BeatVolumes>& CavityVolumeTracker::getBeats() const {
+	return this->beats;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+//The volumes of one beat. The ejection fraction is the share of the end diastolic volume ejected, (EDV - ESV) / EDV.
+struct BeatVolumes {
+	double end_diastolic;
+	double end_systolic;
+	double ejection_fraction;
+};
+
+/*
+*	Ejection fraction from the cavity volume of every step. Within a beat only the largest volume, the
+*	end diastolic one, and the smallest, the end systolic one, are kept, so no trajectory is stored.	*/
+class CavityVolumeTracker
+{
+public:
+	CavityVolumeTracker();
+	~CavityVolumeTracker();
+
+	//The cavity volume after a step.
+	void addSample(double volume);
+
+	/*	Close the current beat and start the next one. Returns false, and records nothing, when no volume
+	*	was sampled since the last call.	*/
+	bool endBeat();
+
+	//Forget every beat, e.g. for a new mesh.
+	void reset();
+
+	size_t getBeatCount() const;
+
+	//The volumes of the last closed beat. Only valid when getBeatCount() > 0.
+	const BeatVolumes& getLastBeat() const;
+
+	//The beats closed so far, oldest first.
+	const vector<BeatVolumes>& getBeats() const;
+
+protected:
+	vector<BeatVolumes> beats;
+	double largest_volume;
+	double smallest_volume;
+	size_t sample_count;
+};
\ No newline at end of file
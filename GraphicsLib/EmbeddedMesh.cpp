@@ -0,0 +1,210 @@
+#include "EmbeddedMesh.h"
+#include <iostream>
+#include <math.h>
+#include <algorithm>
+
+//A vertex counts as inside a tetrahedron if no weight is below this, which absorbs round off on shared faces.
+static const float INSIDE_TOLERANCE = -1e-4f;
+
+//How many rings of grid cells around a vertex are searched for a containing tetrahedron. Beyond that the search
+//only goes on until any tetrahedron is found, whose weights then extrapolate the vertex.
+static const int MAX_SEARCH_RINGS = 2;
+
+
+EmbeddedMesh::EmbeddedMesh() :
+outside_count(0)
+{
+}
+
+
+EmbeddedMesh::~EmbeddedMesh()
+{
+}
+
+
+bool EmbeddedMesh::build(const vector<Vector3f> &coarse_positions, const vector<unsigned int> &tetrahedrons, const vector<Vector3f> &fine_positions) {
+	size_t tet_count = tetrahedrons.size() / 4;
+	if (coarse_positions.empty() || tet_count == 0 || fine_positions.empty()) {
+		cerr << "[EmbeddedMesh:build] Error: Both meshes need vertices and the coarse mesh needs tetrahedra." << endl;
+		return false;
+	}
+
+	/* Fit the render mesh into the bounding box of the simulation mesh, axis by axis. */
+	Vector3f coarse_min = coarse_positions[0], coarse_max = coarse_positions[0];
+	for (size_t i = 1; i < coarse_positions.size(); i++) {
+		for (size_t k = 0; k < 3; k++) {
+			coarse_min[k] = min(coarse_min[k], coarse_positions[i][k]);
+			coarse_max[k] = max(coarse_max[k], coarse_positions[i][k]);
+		}
+	}
+
+	Vector3f fine_min = fine_positions[0], fine_max = fine_positions[0];
+	for (size_t i = 1; i < fine_positions.size(); i++) {
+		for (size_t k = 0; k < 3; k++) {
+			fine_min[k] = min(fine_min[k], fine_positions[i][k]);
+			fine_max[k] = max(fine_max[k], fine_positions[i][k]);
+		}
+	}
+
+	this->fitted_positions.resize(fine_positions.size());
+	for (size_t i = 0; i < fine_positions.size(); i++) {
+		for (size_t k = 0; k < 3; k++) {
+			float extent = fine_max[k] - fine_min[k];
+			float t = (extent > 0.0f) ? (fine_positions[i][k] - fine_min[k]) / extent : 0.5f;
+			this->fitted_positions[i][k] = coarse_min[k] + t * (coarse_max[k] - coarse_min[k]);
+		}
+	}
+
+	/* Spatial index: a uniform grid over the coarse mesh, every tetrahedron is listed in the cells its bounding box touches. */
+	double volume = 1.0;
+	for (size_t k = 0; k < 3; k++)
+		volume *= max(coarse_max[k] - coarse_min[k], 1e-3f);
+
+	float cell_size = static_cast<float>(pow(volume / static_cast<double>(tet_count), 1.0 / 3.0));
+	int dims[3];
+	for (size_t k = 0; k < 3; k++)
+		dims[k] = max(1, static_cast<int>(ceil((coarse_max[k] - coarse_min[k]) / cell_size)));
+
+	size_t cell_count = static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+	vector<unsigned int> cell_offsets(cell_count + 1, 0);
+
+	//Cell range of every tetrahedron's bounding box, low corner then high corner.
+	vector<int> tet_cells(tet_count * 6);
+
+	for (size_t t = 0; t < tet_count; t++) {
+		for (size_t k = 0; k < 3; k++) {
+			float t_min = coarse_positions[tetrahedrons[4 * t]][k], t_max = t_min;
+			for (size_t j = 1; j < 4; j++) {
+				t_min = min(t_min, coarse_positions[tetrahedrons[4 * t + j]][k]);
+				t_max = max(t_max, coarse_positions[tetrahedrons[4 * t + j]][k]);
+			}
+
+			tet_cells[6 * t + k] = min(dims[k] - 1, max(0, static_cast<int>((t_min - coarse_min[k]) / cell_size)));
+			tet_cells[6 * t + 3 + k] = min(dims[k] - 1, max(0, static_cast<int>((t_max - coarse_min[k]) / cell_size)));
+		}
+
+		for (int z = tet_cells[6 * t + 2]; z <= tet_cells[6 * t + 5]; z++) {
+			for (int y = tet_cells[6 * t + 1]; y <= tet_cells[6 * t + 4]; y++) {
+				for (int x = tet_cells[6 * t]; x <= tet_cells[6 * t + 3]; x++)
+					cell_offsets[(static_cast<size_t>(z) * dims[1] + y) * dims[0] + x + 1]++;
+			}
+		}
+	}
+
+	for (size_t c = 0; c < cell_count; c++)
+		cell_offsets[c + 1] += cell_offsets[c];
+
+	//Fill in the tetrahedra now that the offsets are known.
+	vector<unsigned int> cell_tets(cell_offsets[cell_count]);
+	{
+		vector<unsigned int> cursor(cell_offsets.begin(), cell_offsets.end() - 1);
+		for (size_t t = 0; t < tet_count; t++) {
+			for (int z = tet_cells[6 * t + 2]; z <= tet_cells[6 * t + 5]; z++) {
+				for (int y = tet_cells[6 * t + 1]; y <= tet_cells[6 * t + 4]; y++) {
+					for (int x = tet_cells[6 * t]; x <= tet_cells[6 * t + 3]; x++) {
+						size_t cell = (static_cast<size_t>(z) * dims[1] + y) * dims[0] + x;
+						cell_tets[cursor[cell]++] = static_cast<unsigned int>(t);
+					}
+				}
+			}
+		}
+	}
+
+	/* Locate every render vertex. Vertices are independent, so the search runs in parallel. */
+	int fine_count = static_cast<int>(this->fitted_positions.size());
+	this->nodes.assign(fine_count * 4, 0);
+	this->weights.assign(fine_count * 4, 0.0f);
+	vector<char> outside(fine_count, 0);
+
+	#pragma omp parallel for schedule(dynamic, 256)
+	for (int v = 0; v < fine_count; v++) {
+		const Vector3f &p = this->fitted_positions[v];
+		int cell[3];
+		for (size_t k = 0; k < 3; k++)
+			cell[k] = min(dims[k] - 1, max(0, static_cast<int>((p[k] - coarse_min[k]) / cell_size)));
+
+		float best_min_weight = -1e30f;
+		unsigned int best_tet = 0;
+		float best_weights[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+
+		/*	Widen the search ring by ring until a containing tetrahedron is found. A vertex far outside the mesh
+		*	keeps widening until it meets any tetrahedron; the last ring covers the whole grid.	*/
+		int last_ring = max(dims[0], max(dims[1], dims[2]));
+		bool found = false;
+		for (int ring = 0; ring <= last_ring && best_min_weight < INSIDE_TOLERANCE && (ring <= MAX_SEARCH_RINGS || !found); ring++) {
+			for (int z = cell[2] - ring; z <= cell[2] + ring; z++) {
+				for (int y = cell[1] - ring; y <= cell[1] + ring; y++) {
+					for (int x = cell[0] - ring; x <= cell[0] + ring; x++) {
+						if (x < 0 || y < 0 || z < 0 || x >= dims[0] || y >= dims[1] || z >= dims[2])
+							continue;
+
+						//Only the shell of the ring, the inner cells were visited already.
+						if (max(abs(x - cell[0]), max(abs(y - cell[1]), abs(z - cell[2]))) != ring)
+							continue;
+
+						size_t c = (static_cast<size_t>(z) * dims[1] + y) * dims[0] + x;
+						for (unsigned int i = cell_offsets[c]; i < cell_offsets[c + 1]; i++) {
+							unsigned int t = cell_tets[i];
+							float w[4];
+							if (!_barycentric(p, coarse_positions[tetrahedrons[4 * t]], coarse_positions[tetrahedrons[4 * t + 1]],
+								coarse_positions[tetrahedrons[4 * t + 2]], coarse_positions[tetrahedrons[4 * t + 3]], w))
+								continue;
+
+							found = true;
+							float min_weight = min(min(w[0], w[1]), min(w[2], w[3]));
+							if (min_weight > best_min_weight) {
+								best_min_weight = min_weight;
+								best_tet = t;
+								for (size_t j = 0; j < 4; j++)
+									best_weights[j] = w[j];
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if (best_min_weight < INSIDE_TOLERANCE)
+			outside[v] = 1;
+
+		for (size_t j = 0; j < 4; j++) {
+			this->nodes[4 * v + j] = tetrahedrons[4 * best_tet + j];
+			this->weights[4 * v + j] = best_weights[j];
+		}
+	}
+
+	this->outside_count = 0;
+	for (int v = 0; v < fine_count; v++)
+		this->outside_count += outside[v];
+
+	return true;
+}
+
+
+const vector<Vector3f>& EmbeddedMesh::getFittedPositions() const {
+	return this->fitted_positions;
+}
+
+
+size_t EmbeddedMesh::getVertexCount() const {
+	return this->fitted_positions.size();
+}
+
+
+size_t EmbeddedMesh::getOutsideCount() const {
+	return this->outside_count;
+}
+
+
+bool EmbeddedMesh::_barycentric(const Vector3f &p, const Vector3f &a, const Vector3f &b, const Vector3f &c, const Vector3f &d, float weights[4]) {
+	Vector3f ab = b - a, ac = c - a, ad = d - a, ap = p - a;
+	double det = Vector3f::Dot(ab, Vector3f::Cross(ac, ad));
+	if (fabs(det) < 1e-12)
+		return false;
+
+	weights[1] = static_cast<float>(Vector3f::Dot(ap, Vector3f::Cross(ac, ad)) / det);
+	weights[2] = static_cast<float>(Vector3f::Dot(ab, Vector3f::Cross(ap, ad)) / det);
+	weights[3] = static_cast<float>(Vector3f::Dot(ab, Vector3f::Cross(ac, ap)) / det);
+	weights[0] = 1.0f - weights[1] - weights[2] - weights[3];
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <Vector3.h>
+#include "Particle.h"
+
+using namespace std;
+
+/*
+*	Binds the vertices of a detailed render mesh to the tetrahedra of a coarse simulation mesh.
+*	Every render vertex stores the four nodes of the tetrahedron it lies in and its barycentric
+*	weights there, so after each simulation step its position is a fixed linear combination of
+*	four simulated particles. The render mesh can then be much finer than what is simulated.	*/
+class EmbeddedMesh
+{
+public:
+	EmbeddedMesh();
+	~EmbeddedMesh();
+
+	/*
+	*	Compute the embedding weights. Called once when the meshes are loaded.
+	*	@coarse_positions, @tetrahedrons - the simulation mesh, four node indices per tetrahedron.
+	*	@fine_positions - the render mesh vertices. They are fitted into the bounding box of the
+	*	coarse mesh first, since the two meshes are not necessarily modelled at the same scale.
+	*	Vertices outside every tetrahedron use the closest one found and are extrapolated, the search widens
+	*	until it finds one, so no vertex is left unbound.	*/
+	bool build(const vector<Vector3f> &coarse_positions, const vector<unsigned int> &tetrahedrons, const vector<Vector3f> &fine_positions);
+
+	//Rest positions of the render vertices after fitting them to the coarse mesh.
+	const vector<Vector3f>& getFittedPositions() const;
+
+	size_t getVertexCount() const;
+
+	//How many render vertices did not lie inside any tetrahedron and are extrapolated.
+	size_t getOutsideCount() const;
+
+	//Write the interpolated positions of the render vertices into @fine.
+	template <class Real>
+	void interpolate(const vector< Particle<Real> > &coarse, vector< Particle<Real> > &fine);
+
+protected:
+	//Barycentric coordinates of @p in the tetrahedron (a, b, c, d). Returns false for degenerate tetrahedra.
+	static bool _barycentric(const Vector3f &p, const Vector3f &a, const Vector3f &b, const Vector3f &c, const Vector3f &d, float weights[4]);
+
+protected:
+	vector<Vector3f> fitted_positions;
+
+	//Four coarse node indices and four weights per render vertex, stored flat for a branch free interpolation loop.
+	vector<unsigned int> nodes;
+	vector<float> weights;
+
+	//Coarse positions copied out of the particles once per frame, x y z packed.
+	vector<float> coarse_xyz;
+
+	size_t outside_count;
+};
+
+
+template <class Real>
+void EmbeddedMesh::interpolate(const vector< Particle<Real> > &coarse, vector< Particle<Real> > &fine) {
+	int coarse_count = static_cast<int>(coarse.size());
+	int fine_count = static_cast<int>(this->weights.size() / 4);
+	if (coarse_count == 0 || fine_count == 0)
+		return;
+
+	this->coarse_xyz.resize(coarse.size() * 3);
+	float *xyz = &this->coarse_xyz[0];
+
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < coarse_count; i++) {
+		xyz[3 * i] = static_cast<float>(coarse[i].position.x());
+		xyz[3 * i + 1] = static_cast<float>(coarse[i].position.y());
+		xyz[3 * i + 2] = static_cast<float>(coarse[i].position.z());
+	}
+
+	const unsigned int *n = &this->nodes[0];
+	const float *w = &this->weights[0];
+
+	/* Plain float arithmetic on flat arrays, every vertex is independent. */
+	#pragma omp parallel for schedule(static)
+	for (int v = 0; v < fine_count; v++) {
+		const unsigned int *vn = n + 4 * v;
+		const float *vw = w + 4 * v;
+		const float *p0 = xyz + 3 * vn[0];
+		const float *p1 = xyz + 3 * vn[1];
+		const float *p2 = xyz + 3 * vn[2];
+		const float *p3 = xyz + 3 * vn[3];
+
+		float x = vw[0] * p0[0] + vw[1] * p1[0] + vw[2] * p2[0] + vw[3] * p3[0];
+		float y = vw[0] * p0[1] + vw[1] * p1[1] + vw[2] * p2[1] + vw[3] * p3[1];
+		float z = vw[0] * p0[2] + vw[1] * p1[2] + vw[2] * p2[2] + vw[3] * p3[2];
+
+		fine[v].position = Vector3<Real>(x, y, z);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "EventScheduler.h"
+
+
+bool EventScheduler::Event::operator < (const Event &other) const {
+	if (this->time != other.time)
+		return this->time > other.time;
+	return this->sequence > other.sequence;
+}
+
+
+EventScheduler::EventScheduler() :
+next_sequence(0)
+{
+}
+
+
+EventScheduler::~EventScheduler()
+{
+}
+
+
+void EventScheduler::schedule(double time, const Action &action) {
+	Event event;
+	event.time = time;
+	event.sequence = this->next_sequence++;
+	event.action = action;
+	this->events.push(event);
+}
+
+
+size_t EventScheduler::advance(double time) {
+	size_t count = 0;
+	while (!this->events.empty() && this->events.top().time <= time) {
+		/* Popped before running, the action may schedule new events. */
+		Event event = this->events.top();
+		this->events.pop();
+		event.action(event.time);
+		count++;
+	}
+
+	return count;
+}
+
+
+void EventScheduler::clear() {
+	this->events = priority_queue<Event>();
+}
+
+
+bool EventScheduler::empty() const {
+	return this->events.empty();
+}
+
+
+size_t EventScheduler::getPendingCount() const {
+	return this->events.size();
+}
+
+
+double EventScheduler::getNextTime() const {
+	return this->events.top().time;
+}
\ No newline at end of file
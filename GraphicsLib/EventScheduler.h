@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <functional>
+
+using namespace std;
+
+/*
+*	Actions keyed on simulation time. The stepping loop calls advance() with the current simulation
+*	time before every step, and every action due by then runs in time order. Nothing depends on the
+*	wall clock, so a run is the same no matter how fast the steps are computed.	*/
+class EventScheduler
+{
+public:
+	//Called with the time the action was scheduled for, which lies between two steps in general.
+	typedef function<void(double)> Action;
+
+	EventScheduler();
+	~EventScheduler();
+
+	//Run @action at simulation time @time. Actions scheduled for the same time run in the order they were scheduled.
+	void schedule(double time, const Action &action);
+
+	/*	Run the actions due by @time, including those scheduled by the actions themselves. Returns how
+	*	many ran.	*/
+	size_t advance(double time);
+
+	//Drop every pending action.
+	void clear();
+
+	bool empty() const;
+	size_t getPendingCount() const;
+
+	//Time of the earliest pending action. Only valid when not empty().
+	double getNextTime() const;
+
+protected:
+	struct Event {
+		double time;
+		size_t sequence;
+		Action action;
+
+		//Reversed, so the priority queue puts the earliest event on top.
+		bool operator < (const Event &other) const;
+	};
+
+	priority_queue<Event> events;
+	size_t next_sequence;
+};
\ No newline at end of file
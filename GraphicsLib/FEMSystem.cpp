@@ -0,0 +1,457 @@
+#include "FEMSystem.h"
+#include <iostream>
+#include <math.h>
+#include <algorithm>
+
+//Tetrahedra per call of MatrixBatch::Polar() when the polar decompositions are split over threads. A multiple of eight.
+static const size_t POLAR_CHUNK = 256;
+
+//Quaternion iterations per step. The rotations change little between steps, so the warm start converges quickly.
+static const int POLAR_ITERATIONS = 2;
+
+
+/* 3x3 helpers on the raw data of Matrix3f, element (r, c) is m[3 * c + r] as in Matrix3::applyTo(). */
+
+//@out = @a * @b
+static inline void multiply(const float *a, const float *b, float *out) {
+	for (int c = 0; c < 3; c++)
+		for (int r = 0; r < 3; r++)
+			out[3 * c + r] = a[r] * b[3 * c] + a[3 + r] * b[3 * c + 1] + a[6 + r] * b[3 * c + 2];
+}
+
+//@out = @a^T * @b
+static inline void multiplyTransposedLeft(const float *a, const float *b, float *out) {
+	for (int c = 0; c < 3; c++)
+		for (int r = 0; r < 3; r++)
+			out[3 * c + r] = a[3 * r] * b[3 * c] + a[3 * r + 1] * b[3 * c + 1] + a[3 * r + 2] * b[3 * c + 2];
+}
+
+/*	The forces of a tetrahedron with rotation @r and symmetric strain @strain (in the rotated frame):
+*	H = -V R (2 mu E + lambda tr(E) I) B^T, B the rest inverse. The columns of @h are the forces on
+*	the nodes 1 to 3, node 0 gets minus their sum. The same formula gives the force differentials.	*/
+static inline void elementForces(const float *r, const float *strain, const float *b, float volume, float mu, float lambda, float *h) {
+	float stress[9];
+	float trace = lambda * (strain[0] + strain[4] + strain[8]);
+	for (int k = 0; k < 9; k++)
+		stress[k] = 2.0f * mu * strain[k];
+	stress[0] += trace;
+	stress[4] += trace;
+	stress[8] += trace;
+
+	float p[9];
+	multiply(r, stress, p);
+
+	for (int c = 0; c < 3; c++)
+		for (int row = 0; row < 3; row++)
+			h[3 * c + row] = -volume * (p[row] * b[c] + p[3 + row] * b[3 + c] + p[6 + row] * b[6 + c]);
+}
+
+
+FEMSystem::FEMSystem(size_t p_count, size_t s_count) :
+ParticleSystem<float>(p_count, s_count),
+rest_scale(1.0f),
+youngs_modulus(30000.0f),
+poisson_ratio(0.45f),
+stiffness_damping(0.01f),
+solver_iterations(20),
+solver_tolerance(1e-3f),
+last_solver_iterations(0)
+{
+}
+
+
+FEMSystem::~FEMSystem()
+{
+}
+
+
+bool FEMSystem::setTetrahedrons(const vector<unsigned int> &tetrahedrons) {
+	size_t tet_count = tetrahedrons.size() / 4;
+	if (tet_count == 0) {
+		cerr << "[FEMSystem:setTetrahedrons] Error: No tetrahedra given." << endl;
+		return false;
+	}
+
+	if (!ParticleSystem<float>::setTetrahedrons(tetrahedrons))
+		return false;
+
+	/* Greedy coloring: every tetrahedron takes the lowest color none of its nodes has been given yet. */
+	vector< vector<unsigned int> > node_colors(this->particles_count);
+	vector<unsigned int> colors(tet_count);
+	vector<size_t> taken;
+	unsigned int color_count = 0;
+
+	for (size_t t = 0; t < tet_count; t++) {
+		for (size_t j = 0; j < 4; j++) {
+			const vector<unsigned int> &used = node_colors[tetrahedrons[4 * t + j]];
+			for (size_t k = 0; k < used.size(); k++) {
+				if (used[k] >= taken.size())
+					taken.resize(used[k] + 1, static_cast<size_t>(-1));
+				taken[used[k]] = t;
+			}
+		}
+
+		unsigned int color = 0;
+		while (color < taken.size() && taken[color] == t)
+			color++;
+
+		colors[t] = color;
+		color_count = max(color_count, color + 1);
+		for (size_t j = 0; j < 4; j++)
+			node_colors[tetrahedrons[4 * t + j]].push_back(color);
+	}
+
+	/* Counting sort by color, so every color is one contiguous range. */
+	this->color_offsets.assign(color_count + 1, 0);
+	for (size_t t = 0; t < tet_count; t++)
+		this->color_offsets[colors[t] + 1]++;
+	for (size_t c = 0; c < color_count; c++)
+		this->color_offsets[c + 1] += this->color_offsets[c];
+
+	vector<unsigned int> next(this->color_offsets.begin(), this->color_offsets.end() - 1);
+	vector<unsigned int> sorted(tet_count * 4);
+	for (size_t t = 0; t < tet_count; t++) {
+		unsigned int slot = next[colors[t]]++;
+		for (size_t j = 0; j < 4; j++)
+			sorted[4 * slot + j] = tetrahedrons[4 * t + j];
+	}
+	ParticleSystem<float>::setTetrahedrons(sorted);
+
+	/* Rest shapes. Degenerate tetrahedra keep a zero volume and never produce forces. */
+	this->rest_inverses.resize(tet_count);
+	this->rest_volumes.resize(tet_count);
+	size_t degenerate_count = 0;
+
+	for (size_t t = 0; t < tet_count; t++) {
+		const unsigned int *n = &this->tetrahedrons[4 * t];
+		float edges[9];
+		for (size_t j = 0; j < 3; j++)
+			for (size_t k = 0; k < 3; k++)
+				edges[3 * j + k] = this->particles[n[j + 1]].position[k] - this->particles[n[0]].position[k];
+
+		Matrix3f rest(edges);
+		float volume = fabs(rest.determinant()) / 6.0f;
+		if (volume < 1e-12f) {
+			this->rest_inverses[t] = Matrix3f::Zero();
+			this->rest_volumes[t] = 0.0f;
+			degenerate_count++;
+			continue;
+		}
+
+		this->rest_inverses[t] = rest.inversed();
+		this->rest_volumes[t] = volume;
+	}
+
+	this->deformations.resize(tet_count);
+	this->rotations.resize(tet_count);
+	this->stretches.resize(tet_count);
+	this->quaternions.assign(tet_count * 4, 0.0f);
+	for (size_t t = 0; t < tet_count; t++)
+		this->quaternions[4 * t + 3] = 1.0f;
+	this->stiffness_diagonals.resize(this->particles_count);
+
+	float total_mass = 0.0f;
+	for (size_t i = 0; i < this->particles_count; i++)
+		total_mass += this->particles[i].mass;
+	this->setParticlesMass(total_mass / this->particles_count);
+
+	if (degenerate_count > 0)
+		cerr << "[FEMSystem:setTetrahedrons] Error: " << degenerate_count << " of " << tet_count << " tetrahedra are degenerate and produce no forces." << endl;
+	return true;
+}
+
+
+void FEMSystem::setMaterial(float youngs_modulus, float poisson_ratio) {
+	this->youngs_modulus = youngs_modulus;
+	this->poisson_ratio = min(max(poisson_ratio, 0.0f), 0.49f);
+}
+
+
+void FEMSystem::setStiffnessDamping(float beta) {
+	this->stiffness_damping = max(beta, 0.0f);
+}
+
+
+void FEMSystem::setSolverAttributes(int iterations, float tolerance) {
+	this->solver_iterations = max(iterations, 1);
+	this->solver_tolerance = tolerance;
+}
+
+
+size_t FEMSystem::getColorCount() const {
+	return this->color_offsets.empty() ? 0 : this->color_offsets.size() - 1;
+}
+
+
+int FEMSystem::getSolverIterations() const {
+	return this->last_solver_iterations;
+}
+
+
+void FEMSystem::setParticlesMass(float mass) {
+	size_t tet_count = this->rest_volumes.size();
+	if (tet_count == 0) {
+		ParticleSystem<float>::setParticlesMass(mass);
+		return;
+	}
+
+	/* Lumped masses: every node gets a quarter of the volume of each tetrahedron around it. */
+	this->particles_mass = mass;
+	vector<float> node_volumes(this->particles_count, 0.0f);
+	float total_volume = 0.0f;
+	for (size_t t = 0; t < tet_count; t++) {
+		for (size_t j = 0; j < 4; j++)
+			node_volumes[this->tetrahedrons[4 * t + j]] += 0.25f * this->rest_volumes[t];
+		total_volume += this->rest_volumes[t];
+	}
+
+	/* Nodes outside every tetrahedron would have no mass, they keep the average one. */
+	float density = mass * this->particles_count / total_volume;
+	for (size_t i = 0; i < this->particles_count; i++)
+		this->particles[i].mass = (node_volumes[i] > 0.0f) ? density * node_volumes[i] : mass;
+}
+
+
+float FEMSystem::_restScale() const {
+	float scale = this->getActivationScale();
+	float offset = this->getActivationOffset();
+	if (offset != 0.0f && this->springs_count > 0 && this->rest_length_sum > 0.0)
+		scale += offset / static_cast<float>(this->rest_length_sum / this->springs_count);
+
+	return (scale > 0.0f) ? scale : 1.0f;
+}
+
+
+void FEMSystem::_computeElasticForces() {
+	int tet_count = static_cast<int>(this->rest_volumes.size());
+	int count = static_cast<int>(this->particles_count);
+
+	/*	With the rest shapes stretched by a, B becomes B / a and V becomes a^3 V, so the forces scale by
+	*	a^2 and the stiffness by a. Read once per step, the stored rest shapes never change.	*/
+	this->rest_scale = this->_restScale();
+	float inverse_scale = 1.0f / this->rest_scale;
+	float force_scale = this->rest_scale * this->rest_scale;
+
+	/* F = Ds B, Ds the current edge matrix. */
+	#pragma omp parallel for schedule(static)
+	for (int t = 0; t < tet_count; t++) {
+		const unsigned int *n = &this->tetrahedrons[4 * t];
+		float edges[9], f[9];
+		for (int j = 0; j < 3; j++)
+			for (int k = 0; k < 3; k++)
+				edges[3 * j + k] = (this->particles[n[j + 1]].position[k] - this->particles[n[0]].position[k]) * inverse_scale;
+
+		multiply(edges, this->rest_inverses[t].constData(), f);
+		this->deformations[t].set(f);
+	}
+
+	int chunk_count = static_cast<int>((this->rest_volumes.size() + POLAR_CHUNK - 1) / POLAR_CHUNK);
+	#pragma omp parallel for schedule(static)
+	for (int c = 0; c < chunk_count; c++) {
+		size_t begin = c * POLAR_CHUNK;
+		size_t length = min(POLAR_CHUNK, this->rest_volumes.size() - begin);
+		MatrixBatch::Polar(&this->deformations[begin], &this->rotations[begin], &this->stretches[begin], length, &this->quaternions[4 * begin], POLAR_ITERATIONS);
+	}
+
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < count; i++) {
+		this->particles[i].force = Vector3f::Zero();
+		this->stiffness_diagonals[i] = Vector3f::Zero();
+	}
+
+	float mu = this->youngs_modulus / (2.0f * (1.0f + this->poisson_ratio));
+	float lambda = this->youngs_modulus * this->poisson_ratio / ((1.0f + this->poisson_ratio) * (1.0f - 2.0f * this->poisson_ratio));
+
+	/* Strain E = S - I. The nodes of one color are distinct, so each color scatters in parallel. */
+	for (size_t c = 0; c + 1 < this->color_offsets.size(); c++) {
+		int begin = static_cast<int>(this->color_offsets[c]);
+		int end = static_cast<int>(this->color_offsets[c + 1]);
+
+		#pragma omp parallel for schedule(static)
+		for (int t = begin; t < end; t++) {
+			const unsigned int *n = &this->tetrahedrons[4 * t];
+			float strain[9], h[9];
+			const float *s = this->stretches[t].constData();
+			for (int k = 0; k < 9; k++)
+				strain[k] = s[k];
+			strain[0] -= 1.0f;
+			strain[4] -= 1.0f;
+			strain[8] -= 1.0f;
+
+			const float *r = this->rotations[t].constData();
+			const float *b = this->rest_inverses[t].constData();
+			elementForces(r, strain, b, this->rest_volumes[t] * force_scale, mu, lambda, h);
+			for (int j = 0; j < 3; j++) {
+				Vector3f force(h[3 * j], h[3 * j + 1], h[3 * j + 2]);
+				this->particles[n[j + 1]].force += force;
+				this->particles[n[0]].force -= force;
+			}
+
+			/*	Diagonal of the element stiffness, V (mu |g|^2 + (mu + lambda) (R g)_k^2) for the gradient g
+			*	of a node's shape function. The rows of B are the gradients of the nodes 1 to 3.	*/
+			float gradients[12];
+			for (int j = 0; j < 3; j++)
+				for (int k = 0; k < 3; k++)
+					gradients[3 * (j + 1) + k] = b[3 * k + j];
+			for (int k = 0; k < 3; k++)
+				gradients[k] = -(gradients[3 + k] + gradients[6 + k] + gradients[9 + k]);
+
+			for (int j = 0; j < 4; j++) {
+				const float *g = gradients + 3 * j;
+				float rg[3];
+				for (int k = 0; k < 3; k++)
+					rg[k] = r[k] * g[0] + r[3 + k] * g[1] + r[6 + k] * g[2];
+
+				float shear = mu * (g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+				Vector3f diagonal(shear + (mu + lambda) * rg[0] * rg[0], shear + (mu + lambda) * rg[1] * rg[1], shear + (mu + lambda) * rg[2] * rg[2]);
+				this->stiffness_diagonals[n[j]] += Lazy(diagonal) * (this->rest_volumes[t] * this->rest_scale);
+			}
+		}
+	}
+}
+
+
+void FEMSystem::_multiplyStiffness(const vector<Vector3f> &y, vector<Vector3f> &product) {
+	int count = static_cast<int>(this->particles_count);
+
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < count; i++)
+		product[i] = Vector3f::Zero();
+
+	float mu = this->youngs_modulus / (2.0f * (1.0f + this->poisson_ratio));
+	float lambda = this->youngs_modulus * this->poisson_ratio / ((1.0f + this->poisson_ratio) * (1.0f - 2.0f * this->poisson_ratio));
+	float inverse_scale = 1.0f / this->rest_scale;
+	float force_scale = this->rest_scale * this->rest_scale;
+
+	/* With the rotations held fixed: dF = dDs B, dE = sym(R^T dF), and K y is minus the force differential. */
+	for (size_t c = 0; c + 1 < this->color_offsets.size(); c++) {
+		int begin = static_cast<int>(this->color_offsets[c]);
+		int end = static_cast<int>(this->color_offsets[c + 1]);
+
+		#pragma omp parallel for schedule(static)
+		for (int t = begin; t < end; t++) {
+			const unsigned int *n = &this->tetrahedrons[4 * t];
+			const float *r = this->rotations[t].constData();
+			float edges[9], df[9], g[9], strain[9], h[9];
+			for (int j = 0; j < 3; j++)
+				for (int k = 0; k < 3; k++)
+					edges[3 * j + k] = (y[n[j + 1]][k] - y[n[0]][k]) * inverse_scale;
+
+			multiply(edges, this->rest_inverses[t].constData(), df);
+			multiplyTransposedLeft(r, df, g);
+			for (int col = 0; col < 3; col++)
+				for (int row = 0; row < 3; row++)
+					strain[3 * col + row] = 0.5f * (g[3 * col + row] + g[3 * row + col]);
+
+			elementForces(r, strain, this->rest_inverses[t].constData(), this->rest_volumes[t] * force_scale, mu, lambda, h);
+			for (int j = 0; j < 3; j++) {
+				Vector3f force(h[3 * j], h[3 * j + 1], h[3 * j + 2]);
+				product[n[j + 1]] -= force;
+				product[n[0]] += force;
+			}
+		}
+	}
+}
+
+
+void FEMSystem::_multiplySystem(const vector<Vector3f> &y, float scale, vector<Vector3f> &product) {
+	this->_multiplyStiffness(y, product);
+
+	int count = static_cast<int>(this->particles_count);
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < count; i++)
+		product[i] = Lazy(y[i]) * this->particles[i].mass + Lazy(product[i]) * scale;
+}
+
+
+void FEMSystem::updateParticleSystem(float dt) {
+	if (this->rest_volumes.empty()) {
+		ParticleSystem<float>::updateParticleSystem(dt);
+		return;
+	}
+
+	int count = static_cast<int>(this->particles_count);
+	this->delta_velocities.resize(this->particles_count);
+	this->residuals.resize(this->particles_count);
+	this->directions.resize(this->particles_count);
+	this->products.resize(this->particles_count);
+	this->inverse_diagonals.resize(this->particles_count);
+
+	this->_computeElasticForces();
+	if (this->cavity_pressure != 0.0f)
+		this->_addPressureForces();
+
+	/*	Linearized backward Euler with stiffness damping beta:
+	*	(M + (dt^2 + dt beta) K) dv = dt (f + M g - (dt + beta) K v)	*/
+	float velocity_scale = dt + this->stiffness_damping;
+	float system_scale = dt * velocity_scale;
+
+	for (int i = 0; i < count; i++)
+		this->directions[i] = this->particles[i].velocity;
+	this->_multiplyStiffness(this->directions, this->products);
+
+	/* Conjugate gradients with the inverse diagonal of the system matrix as preconditioner, starting from dv = 0. */
+	float rz = 0.0f;
+	#pragma omp parallel for schedule(static) reduction(+:rz)
+	for (int i = 0; i < count; i++) {
+		Particle<float> &particle = this->particles[i];
+		for (int k = 0; k < 3; k++)
+			this->inverse_diagonals[i][k] = 1.0f / (particle.mass + system_scale * this->stiffness_diagonals[i][k]);
+
+		this->residuals[i] = (Lazy(particle.force) + Lazy(this->gravity) * particle.mass - Lazy(this->products[i]) * velocity_scale) * dt;
+		this->delta_velocities[i] = Vector3f::Zero();
+		this->directions[i] = Lazy(this->residuals[i]) * this->inverse_diagonals[i];
+		rz += Vector3f::FastDot(this->residuals[i], this->directions[i]);
+	}
+
+	float threshold = this->solver_tolerance * this->solver_tolerance * rz;
+	int iteration = 0;
+	while (iteration < this->solver_iterations && rz > threshold) {
+		this->_multiplySystem(this->directions, system_scale, this->products);
+
+		float pq = 0.0f;
+		#pragma omp parallel for schedule(static) reduction(+:pq)
+		for (int i = 0; i < count; i++)
+			pq += Vector3f::FastDot(this->directions[i], this->products[i]);
+
+		if (pq <= 0.0f) break;
+		float alpha = rz / pq;
+
+		float rz_next = 0.0f;
+		#pragma omp parallel for schedule(static) reduction(+:rz_next)
+		for (int i = 0; i < count; i++) {
+			this->delta_velocities[i] += Lazy(this->directions[i]) * alpha;
+			this->residuals[i] -= Lazy(this->products[i]) * alpha;
+			rz_next += Vector3f::FastDot(this->residuals[i], Lazy(this->residuals[i]) * this->inverse_diagonals[i]);
+		}
+
+		float beta = rz_next / rz;
+		rz = rz_next;
+
+		#pragma omp parallel for schedule(static)
+		for (int i = 0; i < count; i++)
+			this->directions[i] = Lazy(this->residuals[i]) * this->inverse_diagonals[i] + Lazy(this->directions[i]) * beta;
+
+		iteration++;
+	}
+	this->last_solver_iterations = iteration;
+
+	const float *damping_scales = this->particle_damping_scales.empty() ? nullptr : &this->particle_damping_scales[0];
+	for (int i = 0; i < count; i++) {
+		this->particles[i].velocity += this->delta_velocities[i];
+		this->handleLinearDamping(this->particles[i].velocity, damping_scales ? damping_scales[i] : this->damping_scale);
+		this->collisionHandleSimple(0.0f, this->particles[i].position, this->particles[i].velocity);
+
+		this->particles[i].position += Lazy(this->particles[i].velocity) * dt;
+		this->vertices[i].position = this->particles[i].position;
+	}
+
+	for (size_t i = 0; i < this->springs_count; i++) {
+		this->springs[i].p0_position = this->particles[this->springs[i].p0].position;
+		this->springs[i].p1_position = this->particles[this->springs[i].p1].position;
+	}
+
+	this->_updateNormals();
+	this->_updateCavityVolume();
+	this->uploadVertices();
+}
\ No newline at end of file
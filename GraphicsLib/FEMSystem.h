@@ -0,0 +1,98 @@
+#pragma once
+
+#include "ParticleSystem.h"
+#include <Matrix3.h>
+#include <MatrixBatch.h>
+
+/*
+*	Co-rotational linear finite elements over the tetrahedra of a TetGen mesh. The particles are the
+*	mesh nodes, as in the spring system, but the forces come from the volumetric strain of every
+*	tetrahedron measured in its own rotated frame, so large rotations cause no artificial stress.
+*	Each step is a linearized backward Euler step solved with conjugate gradients, which stays
+*	stable at the widget's time step with tissue like stiffness.
+*
+*	The tetrahedra are reordered by color: no two tetrahedra of one color share a node, so the
+*	forces of a color are scattered to the nodes in parallel without atomics.
+*
+*	The springs are kept for drawing the wireframe, they do not take part in the simulation.	*/
+class FEMSystem : public ParticleSystem<float>
+{
+public:
+	FEMSystem(size_t p_count, size_t s_count);
+	~FEMSystem();
+
+	/*
+	*	Take the tetrahedra, four particle indices each, as listed in the .ele file. Call after
+	*	setParticlesPositions(), the current positions are the rest shape. The particle masses are
+	*	redistributed by the volume around each node, keeping their sum.	*/
+	virtual bool setTetrahedrons(const vector<unsigned int> &tetrahedrons);
+
+	/*	@youngs_modulus - with the mesh in millimetres and the masses in grams this is in Pa.
+	*	@poisson_ratio - below 0.5, cardiac tissue is close to incompressible at around 0.45.	*/
+	void setMaterial(float youngs_modulus, float poisson_ratio);
+
+	//Stiffness proportional (Rayleigh) damping in seconds. 0 leaves only the damping of the implicit step.
+	void setStiffnessDamping(float beta);
+
+	//At most @iterations conjugate gradient iterations per step, stopping early at a relative residual of @tolerance.
+	void setSolverAttributes(int iterations, float tolerance);
+
+	size_t getColorCount() const;
+
+	//Conjugate gradient iterations used by the last step.
+	int getSolverIterations() const;
+
+	//The average particle mass, the particles get shares proportional to the volume around them.
+	virtual void setParticlesMass(float mass);
+
+	virtual void updateParticleSystem(float dt);
+
+protected:
+	/*	The factor the activation of region 0 stretches the rest shapes by. The offset is converted using
+	*	the average base length of the springs.	*/
+	float _restScale() const;
+
+	/*	Deformation gradients, their polar decompositions and the elastic forces into particles[i].force.
+	*	The rotations are kept for the stiffness products of the solve.	*/
+	void _computeElasticForces();
+
+	//@product = K @y, with K the stiffness matrix of the rotated elements.
+	void _multiplyStiffness(const vector<Vector3f> &y, vector<Vector3f> &product);
+
+	//@product = (M + @scale K) @y, the system matrix of the implicit step.
+	void _multiplySystem(const vector<Vector3f> &y, float scale, vector<Vector3f> &product);
+
+protected:
+	//The tetrahedra, which the base class keeps sorted by color, of color c are color_offsets[c] up to color_offsets[c + 1].
+	vector<unsigned int> color_offsets;
+
+	/*	Inverse of the rest edge matrix (x1 - x0, x2 - x0, x3 - x0) and the rest volume of every tetrahedron,
+	*	before activation. The kernels apply rest_scale, the edges grow by it, so the inverses shrink by it.	*/
+	vector<Matrix3f> rest_inverses;
+	vector<float> rest_volumes;
+	float rest_scale;
+
+	//Per tetrahedron state of the current step. The quaternions warm start the polar decomposition.
+	vector<Matrix3f> deformations;
+	vector<Matrix3f> rotations;
+	vector<Matrix3f> stretches;
+	vector<float> quaternions;
+
+	float youngs_modulus;
+	float poisson_ratio;
+	float stiffness_damping;
+
+	int solver_iterations;
+	float solver_tolerance;
+	int last_solver_iterations;
+
+	//Per particle vectors of the conjugate gradient solve.
+	vector<Vector3f> delta_velocities;
+	vector<Vector3f> residuals;
+	vector<Vector3f> directions;
+	vector<Vector3f> products;
+
+	//Diagonal of K, gathered with the elastic forces, and the inverse diagonal of the system matrix used as preconditioner.
+	vector<Vector3f> stiffness_diagonals;
+	vector<Vector3f> inverse_diagonals;
+};
\ No newline at end of file
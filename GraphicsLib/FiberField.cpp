@@ -0,0 +1,136 @@
+#include "FiberField.h"
+#include "LoadTetGenFiles.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <math.h>
+
+static const float PI = 3.14159265358979f;
+
+
+FiberField::FiberField()
+{
+}
+
+
+FiberField::~FiberField()
+{
+}
+
+
+bool FiberField::load(const string &file_name, size_t particle_count) {
+	ifstream file(file_name.c_str());
+	if (!file.is_open())
+		return false;
+
+	string line;
+	istringstream iss;
+	size_t count = 0;
+	getline(file, line);
+	iss.str(line);
+	iss >> count;
+	if (count != particle_count) {
+		cerr << "[FiberField:load] Error: " << file_name << " has " << count << " fibers for " << particle_count << " particles." << endl;
+		return false;
+	}
+
+	vector<Vector3f> loaded(count, Vector3f::Zero());
+	while (getline(file, line)) {
+		if (line.empty() || line[0] == FILE_COMMENT)
+			continue;
+
+		iss.clear();
+		iss.str(line);
+		size_t index;
+		float x, y, z;
+		if (!(iss >> index >> x >> y >> z) || index >= count) {
+			cerr << "[FiberField:load] Error: Bad fiber line in " << file_name << ": " << line << endl;
+			return false;
+		}
+
+		Vector3f direction(x, y, z);
+		float length = Vector3f::Norm(direction);
+		loaded[index] = (length > 0.0f) ? direction / length : Vector3f::Zero();
+	}
+
+	this->directions.swap(loaded);
+	return true;
+}
+
+
+void FiberField::buildRuleBased(const vector<Vector3f> &positions, float inner_angle, float outer_angle) {
+	size_t count = positions.size();
+	this->directions.assign(count, Vector3f::Zero());
+	if (count == 0)
+		return;
+
+	/* The axis is vertical through the mean of the particles. */
+	float center_x = 0.0f, center_z = 0.0f;
+	for (size_t i = 0; i < count; i++) {
+		center_x += positions[i].getX();
+		center_z += positions[i].getZ();
+	}
+	center_x /= count;
+	center_z /= count;
+
+	vector<float> radii(count);
+	float outer_radius = 0.0f;
+	for (size_t i = 0; i < count; i++) {
+		float dx = positions[i].getX() - center_x;
+		float dz = positions[i].getZ() - center_z;
+		radii[i] = sqrtf(dx * dx + dz * dz);
+		outer_radius = max(outer_radius, radii[i]);
+	}
+
+	/* fiber = cos(a) circumferential + sin(a) longitudinal, the helix angle a interpolated over the radius. */
+	for (size_t i = 0; i < count; i++) {
+		if (radii[i] <= 0.0f) {
+			this->directions[i] = Vector3f(0.0f, 1.0f, 0.0f);
+			continue;
+		}
+
+		float depth = (outer_radius > 0.0f) ? radii[i] / outer_radius : 0.0f;
+		float angle = (inner_angle + (outer_angle - inner_angle) * depth) * PI / 180.0f;
+		float circumferential_x = -(positions[i].getZ() - center_z) / radii[i];
+		float circumferential_z = (positions[i].getX() - center_x) / radii[i];
+		this->directions[i] = Vector3f(cosf(angle) * circumferential_x, sinf(angle), cosf(angle) * circumferential_z);
+	}
+}
+
+
+void FiberField::computeSpringAttributes(const vector<Vector3f> &positions, const vector<Vector2f> &springs,
+	float along_stiffness, float cross_stiffness, float along_contraction, float cross_contraction,
+	vector<float> &stiffness, vector<float> &contraction) const {
+	size_t count = springs.size();
+	stiffness.resize(count);
+	contraction.resize(count);
+
+	for (size_t i = 0; i < count; i++) {
+		size_t p0 = static_cast<size_t>(springs[i][0]);
+		size_t p1 = static_cast<size_t>(springs[i][1]);
+
+		/* The end fibers are averaged as axes, a fiber and its reverse are the same. */
+		Vector3f fiber0 = this->directions[p0];
+		Vector3f fiber1 = this->directions[p1];
+		if (Vector3f::Dot(fiber0, fiber1) < 0.0f)
+			fiber1 = -fiber1;
+		Vector3f fiber = fiber0 + fiber1;
+		Vector3f edge = positions[p1] - positions[p0];
+
+		float fiber_length = Vector3f::Norm(fiber);
+		float edge_length = Vector3f::Norm(edge);
+		float alignment = 0.0f;
+		if (fiber_length > 0.0f && edge_length > 0.0f) {
+			float cosine = Vector3f::Dot(fiber, edge) / (fiber_length * edge_length);
+			alignment = cosine * cosine;
+		}
+
+		stiffness[i] = cross_stiffness + (along_stiffness - cross_stiffness) * alignment;
+		contraction[i] = cross_contraction + (along_contraction - cross_contraction) * alignment;
+	}
+}
+
+
+const vector<Vector3f>& FiberField::getDirections() const {
+	return this->directions;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <Vector2.h>
+#include <Vector3.h>
+
+using namespace std;
+
+/*
+*	Muscle fiber direction at every particle. Myocardium is stiffer along its fibers and contracts
+*	mostly along them, so the springs get their stiffness and contraction from how well they line up
+*	with the fibers around them. Both are computed once at load time into per spring arrays, the
+*	force kernel only reads them.	*/
+class FiberField
+{
+public:
+	FiberField();
+	~FiberField();
+
+	/*	Read one direction per particle from a side file in the layout of a TetGen .node file: a header
+	*	line with the count, then "index x y z" lines. Lines starting with '#' are comments.	*/
+	bool load(const string &file_name, size_t particle_count);
+
+	/*	Rule based fibers around the long axis, the y axis through the center of @positions: the fibers
+	*	wind around the axis with a helix angle going linearly from @inner_angle at the axis to
+	*	@outer_angle at the outermost particle, in degrees. The usual values are 60 and -60.	*/
+	void buildRuleBased(const vector<Vector3f> &positions, float inner_angle, float outer_angle);
+
+	/*	Per spring attributes from the alignment w = cos^2 of the angle between a spring and the mean
+	*	fiber of its two ends: @stiffness and @contraction go linearly from the cross fiber value at w = 0
+	*	to the along fiber value at w = 1.	*/
+	void computeSpringAttributes(const vector<Vector3f> &positions, const vector<Vector2f> &springs,
+		float along_stiffness, float cross_stiffness, float along_contraction, float cross_contraction,
+		vector<float> &stiffness, vector<float> &contraction) const;
+
+	//Unit fiber direction per particle.
+	const vector<Vector3f>& getDirections() const;
+
+protected:
+	vector<Vector3f> directions;
+};
\ No newline at end of file
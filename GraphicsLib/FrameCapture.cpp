@@ -0,0 +1,347 @@
+#include "FrameCapture.h"
+#include "PNG.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string.h>
+#include <gl/glew.h>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+
+FrameCapture::FrameCapture() :
+width(0),
+height(0),
+fboId(0),
+colorBufferId(0),
+depthBufferId(0),
+previous_framebuffer(0),
+frames_issued(0),
+frames_captured(0),
+frames_dropped(0),
+frames_queued(0),
+wait_for_encoders(false),
+jobs_running(0),
+max_queued_jobs(0),
+deflate_threads(1),
+stopping(false)
+{
+}
+
+
+FrameCapture::~FrameCapture()
+{
+	//The GL objects need a current context, so only the threads are cleaned up here. Call finish() first.
+	{
+		lock_guard<mutex> lock(this->queue_mutex);
+		this->stopping = true;
+	}
+
+	this->queue_changed.notify_all();
+	for (size_t i = 0; i < this->workers.size(); i++)
+		this->workers[i].join();
+}
+
+
+bool FrameCapture::initialize(int width, int height, const string& directory, const string& prefix, int pbo_count, int worker_count) {
+	if (this->isActive())
+		this->finish();
+
+	this->width = width;
+	this->height = height;
+	this->directory = directory;
+	this->prefix = prefix;
+	this->frames_issued = 0;
+	this->frames_captured = 0;
+	this->frames_dropped = 0;
+	this->frames_queued = 0;
+
+	//Only the last path component is created; an existing directory is not an error.
+#ifdef _WIN32
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+
+	glGenFramebuffers(1, &this->fboId);
+	glBindFramebuffer(GL_FRAMEBUFFER, this->fboId);
+
+	glGenRenderbuffers(1, &this->colorBufferId);
+	glBindRenderbuffer(GL_RENDERBUFFER, this->colorBufferId);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->colorBufferId);
+
+	glGenRenderbuffers(1, &this->depthBufferId);
+	glBindRenderbuffer(GL_RENDERBUFFER, this->depthBufferId);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, this->depthBufferId);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE) {
+		cerr << "[FrameCapture:initialize] Error: Offscreen framebuffer is incomplete, status " << status << "." << endl;
+		this->finish();
+		return false;
+	}
+
+	/* Pixel buffers for the read back ring. */
+	size_t frame_bytes = static_cast<size_t>(width) * height * 4;
+	this->pboIds.resize(pbo_count < 1 ? 1 : pbo_count);
+	glGenBuffers(static_cast<GLsizei>(this->pboIds.size()), &this->pboIds[0]);
+	for (size_t i = 0; i < this->pboIds.size(); i++) {
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, this->pboIds[i]);
+		glBufferData(GL_PIXEL_PACK_BUFFER, frame_bytes, NULL, GL_STREAM_READ);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	/* Encoder threads. */
+	/* A few frames in parallel, each split across the remaining cores, keeps the latency of a single frame low. */
+	int cores = static_cast<int>(thread::hardware_concurrency());
+	if (worker_count <= 0)
+		worker_count = 2;
+
+	this->deflate_threads = (cores > worker_count) ? static_cast<unsigned>(cores / worker_count) : 1;
+
+	this->stopping = false;
+	this->jobs_running = 0;
+	this->max_queued_jobs = static_cast<size_t>(worker_count) * 2;
+	for (int i = 0; i < worker_count; i++)
+		this->workers.push_back(thread(&FrameCapture::_workerLoop, this));
+
+	return true;
+}
+
+
+void FrameCapture::setWaitForEncoders(bool wait) {
+	this->wait_for_encoders = wait;
+}
+
+
+void FrameCapture::bind() {
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &this->previous_framebuffer);
+	glGetIntegerv(GL_VIEWPORT, this->previous_viewport);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, this->fboId);
+	glViewport(0, 0, this->width, this->height);
+}
+
+
+void FrameCapture::unbind() {
+	glBindFramebuffer(GL_FRAMEBUFFER, this->previous_framebuffer);
+	glViewport(this->previous_viewport[0], this->previous_viewport[1], this->previous_viewport[2], this->previous_viewport[3]);
+}
+
+
+void FrameCapture::captureFrame() {
+	if (!this->isActive())
+		return;
+
+	size_t ring = this->pboIds.size();
+	size_t slot = this->frames_issued % ring;
+
+	/* The buffer about to be overwritten holds the frame issued ring - 1 frames ago; collect it first. */
+	if (this->frames_issued >= ring)
+		this->_collect(this->pboIds[slot], this->frames_issued - ring, !this->wait_for_encoders);
+
+	GLint framebuffer = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, this->fboId);
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+	//With a pack buffer bound the last argument is an offset and the call returns without waiting for the GPU.
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, this->pboIds[slot]);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, this->width, this->height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+	this->frames_issued++;
+}
+
+
+void FrameCapture::finish() {
+	/* Collect the frames still in flight, oldest first. Nothing is waiting on the caller anymore, so none are dropped. */
+	size_t ring = this->pboIds.size();
+	size_t first = (this->frames_issued > ring) ? this->frames_issued - ring : 0;
+	for (size_t frame = first; frame < this->frames_issued; frame++)
+		this->_collect(this->pboIds[frame % ring], frame, false);
+
+	/* Let the workers drain the queue, then stop them. */
+	{
+		unique_lock<mutex> lock(this->queue_mutex);
+		while (!this->jobs.empty() || this->jobs_running > 0)
+			this->queue_changed.wait(lock);
+
+		this->stopping = true;
+	}
+
+	this->queue_changed.notify_all();
+	for (size_t i = 0; i < this->workers.size(); i++)
+		this->workers[i].join();
+	this->workers.clear();
+	this->free_buffers.clear();
+
+	if (!this->pboIds.empty())
+		glDeleteBuffers(static_cast<GLsizei>(this->pboIds.size()), &this->pboIds[0]);
+	this->pboIds.clear();
+
+	if (this->fboId != 0)
+		glDeleteFramebuffers(1, &this->fboId);
+	if (this->colorBufferId != 0)
+		glDeleteRenderbuffers(1, &this->colorBufferId);
+	if (this->depthBufferId != 0)
+		glDeleteRenderbuffers(1, &this->depthBufferId);
+
+	this->fboId = 0;
+	this->colorBufferId = 0;
+	this->depthBufferId = 0;
+
+	if (this->frames_dropped > 0)
+		cerr << "[FrameCapture:finish] Error: " << this->frames_dropped << " frames were dropped because the encoders fell behind." << endl;
+}
+
+
+bool FrameCapture::isActive() const {
+	return this->fboId != 0;
+}
+
+
+int FrameCapture::getWidth() const {
+	return this->width;
+}
+
+
+int FrameCapture::getHeight() const {
+	return this->height;
+}
+
+
+size_t FrameCapture::getCapturedCount() const {
+	lock_guard<mutex> lock(this->queue_mutex);
+	return this->frames_captured;
+}
+
+
+size_t FrameCapture::getDroppedCount() const {
+	lock_guard<mutex> lock(this->queue_mutex);
+	return this->frames_dropped;
+}
+
+
+size_t FrameCapture::getKeptCount() const {
+	lock_guard<mutex> lock(this->queue_mutex);
+	return this->frames_issued - this->frames_dropped;
+}
+
+
+void FrameCapture::_collect(unsigned int pbo, size_t frame, bool may_drop) {
+	size_t frame_bytes = static_cast<size_t>(this->width) * this->height * 4;
+	EncodeJob job;
+
+	/* A full queue either drops the frame or waits for a worker to take a job. */
+	{
+		unique_lock<mutex> lock(this->queue_mutex);
+		if (may_drop && this->jobs.size() >= this->max_queued_jobs) {
+			this->frames_dropped++;
+			return;
+		}
+
+		while (this->jobs.size() >= this->max_queued_jobs)
+			this->queue_changed.wait(lock);
+
+		if (!this->free_buffers.empty()) {
+			job.pixels.swap(this->free_buffers.back());
+			this->free_buffers.pop_back();
+		}
+	}
+
+	job.pixels.resize(frame_bytes);
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+	const unsigned char* mapped = static_cast<const unsigned char*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+	if (mapped == NULL) {
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		cerr << "[FrameCapture:_collect] Error: Could not map the pixel buffer of frame " << frame << "." << endl;
+
+		lock_guard<mutex> lock(this->queue_mutex);
+		this->frames_dropped++;
+		return;
+	}
+
+	/* OpenGL rows start at the bottom, PNG rows at the top. */
+	size_t row_bytes = static_cast<size_t>(this->width) * 4;
+	for (int y = 0; y < this->height; y++)
+		memcpy(&job.pixels[(this->height - 1 - y) * row_bytes], mapped + y * row_bytes, row_bytes);
+
+	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	{
+		//Numbered by the frames kept, so the sequence has no gaps.
+		lock_guard<mutex> lock(this->queue_mutex);
+		this->jobs.push_back(EncodeJob());
+		this->jobs.back().frame = this->frames_queued++;
+		this->jobs.back().pixels.swap(job.pixels);
+	}
+
+	this->queue_changed.notify_all();
+}
+
+
+void FrameCapture::_workerLoop() {
+	while (true) {
+		EncodeJob job;
+		{
+			unique_lock<mutex> lock(this->queue_mutex);
+			while (this->jobs.empty() && !this->stopping)
+				this->queue_changed.wait(lock);
+
+			if (this->jobs.empty())
+				return;
+
+			job.frame = this->jobs.front().frame;
+			job.pixels.swap(this->jobs.front().pixels);
+			this->jobs.pop_front();
+			this->jobs_running++;
+		}
+
+		//A capture waiting for a free slot can go on.
+		this->queue_changed.notify_all();
+
+		string file_name = this->_fileName(job.frame);
+		lodepng::State state;
+		state.encoder.zlibsettings.numthreads = this->deflate_threads;
+
+		vector<unsigned char> png;
+		unsigned error = lodepng::encode(png, job.pixels, this->width, this->height, state);
+		if (!error)
+			error = lodepng::save_file(png, file_name);
+		if (error)
+			cerr << "[FrameCapture:_workerLoop] Error: Could not write " << file_name << ": " << lodepng_error_text(error) << endl;
+
+		{
+			lock_guard<mutex> lock(this->queue_mutex);
+			if (!error)
+				this->frames_captured++;
+
+			this->free_buffers.push_back(vector<unsigned char>());
+			this->free_buffers.back().swap(job.pixels);
+			this->jobs_running--;
+		}
+
+		//finish() waits for the queue to drain.
+		this->queue_changed.notify_all();
+	}
+}
+
+
+string FrameCapture::_fileName(size_t frame) const {
+	ostringstream name;
+	name << this->directory << "/" << this->prefix << "_" << setw(6) << setfill('0') << frame << ".png";
+	return name.str();
+}
\ No newline at end of file
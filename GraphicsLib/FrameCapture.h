@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+/*
+*	Renders into an offscreen framebuffer and writes every captured frame as a numbered PNG.
+*	The pixels are read back through a ring of pixel buffer objects, so glReadPixels returns
+*	immediately and a frame is only mapped a few frames later, when the GPU is done with it.
+*	PNG encoding runs on a pool of worker threads. If the workers fall behind, new frames are
+*	dropped and counted instead of blocking the caller, unless waiting for the encoders is enabled.
+*	The files are numbered by the frames kept, so a dropped frame leaves no gap in the sequence.
+*	All functions except the counters must be called with the GL context current.	*/
+class FrameCapture
+{
+public:
+	FrameCapture();
+	~FrameCapture();
+
+	/*	Create the framebuffer, the pixel buffers and the encoder threads.
+	*	@directory, @prefix - frames are written to directory/prefix_000000.png, directory/prefix_000001.png, ...
+	*	@pbo_count - frames in flight on the GPU. @worker_count - frames encoded at the same time, 0 picks two.
+	*	The cores are split between the workers, each frame is deflated with that many threads.	*/
+	bool initialize(int width, int height, const string& directory, const string& prefix = "frame", int pbo_count = 3, int worker_count = 0);
+
+	/*	@wait, block captureFrame() until an encoder is free instead of dropping the frame. For offline
+	*	runs that need every step; an interactive run keeps its frame rate with the default, false.	*/
+	void setWaitForEncoders(bool wait);
+
+	//Render into the offscreen framebuffer until unbind().
+	void bind();
+	void unbind();
+
+	//Queue a read back of the framebuffer and hand the oldest finished read back to the encoders.
+	void captureFrame();
+
+	//Read back the frames still on the GPU, wait for all encoders and release the GL objects and threads.
+	void finish();
+
+	bool isActive() const;
+	int getWidth() const;
+	int getHeight() const;
+	size_t getCapturedCount() const;
+	size_t getDroppedCount() const;
+
+	//Frames captured and not dropped, all of them are written once finish() returns.
+	size_t getKeptCount() const;
+
+protected:
+	struct EncodeJob {
+		size_t frame;
+		vector<unsigned char> pixels;
+	};
+
+	/*	Map the pixel buffer @pbo and queue its contents as the next file. @frame, the issued frame, only for errors.
+	*	@may_drop, skip the frame instead of waiting when the queue is full.	*/
+	void _collect(unsigned int pbo, size_t frame, bool may_drop);
+
+	void _workerLoop();
+	string _fileName(size_t frame) const;
+
+protected:
+	int width;
+	int height;
+	string directory;
+	string prefix;
+
+	unsigned int fboId;
+	unsigned int colorBufferId;
+	unsigned int depthBufferId;
+	int previous_framebuffer;
+	int previous_viewport[4];
+
+	vector<unsigned int> pboIds;
+	size_t frames_issued;
+	size_t frames_captured;
+	size_t frames_dropped;
+	size_t frames_queued;
+	bool wait_for_encoders;
+
+	/* Encoder pool. Everything below is guarded by queue_mutex. */
+	vector<thread> workers;
+	mutable mutex queue_mutex;
+	condition_variable queue_changed;
+	deque<EncodeJob> jobs;
+	size_t jobs_running;
+	size_t max_queued_jobs;
+	unsigned deflate_threads;
+	bool stopping;
+
+	//Pixel buffers handed back by the workers, reused to avoid an allocation per frame.
+	vector< vector<unsigned char> > free_buffers;
+};
\ No newline at end of file
@@ -9,6 +9,8 @@
 
 Grid::Grid() :
 vboId(0),
+iboId(0),
+vaoId(0),
 shader(nullptr)
 {
 	std::srand(time(NULL));
@@ -31,6 +33,11 @@ void Grid::loadShader(const string& vertexShader, const string& fragmentShader)
 }
 
 
+void Grid::setShader(const shared_ptr<Shader>& shader) {
+	this->shader = shader;
+}
+
+
 void Grid::constructGrid(const Color3f &color, float y, float x_min, float x_max, float z_min, float z_max) {
 	GridVertex vert;
 	float r = color.getR();
@@ -58,17 +65,15 @@ void Grid::constructGrid(const Color3f &color, float y, float x_min, float x_max
 
 
 void Grid::constructOnGPU() {
-	glGenBuffers(1, &this->vboId);
-	glBindBuffer(GL_ARRAY_BUFFER, this->vboId);
-	glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * sizeof(GridVertex), &this->vertices[0], GL_STATIC_DRAW);
-}
-
+	const unsigned int indices[] = { 0, 1, 2,
+									0, 2, 3 };
 
-void Grid::beginRender() {
-	if (this->shader != nullptr)
-		this->shader->enable();
+	glGenVertexArrays(1, &this->vaoId);
+	glBindVertexArray(this->vaoId);
 
+	glGenBuffers(1, &this->vboId);
 	glBindBuffer(GL_ARRAY_BUFFER, this->vboId);
+	glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * sizeof(GridVertex), &this->vertices[0], GL_STATIC_DRAW);
 
 	glEnableVertexAttribArray(POSITION_LOC);
 	glVertexAttribPointer(POSITION_LOC, 3, GL_FLOAT, GL_FALSE, sizeof(GridVertex), BUFFER_OFFSET(0));
@@ -76,15 +81,26 @@ void Grid::beginRender() {
 	glEnableVertexAttribArray(COLOR_LOC);
 	glVertexAttribPointer(COLOR_LOC, 3, GL_FLOAT, GL_FALSE, sizeof(GridVertex), BUFFER_OFFSET(3 * sizeof(float)));
 
-	//glDrawArrays(GL_LINES, 0, this->vertices.size());
-	/*unsigned int ind[] = { 0, 1, 2,
-							0, 2, 3 };*/
-	vector<unsigned int> ind;
-	ind.push_back(0); ind.push_back(1); ind.push_back(2);
-	ind.push_back(0); ind.push_back(2); ind.push_back(3);
-	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, ind);
-	glDrawRangeElements(GL_TRIANGLES, 0, 2, 3, GL_UNSIGNED_INT, &ind[0]);
-	glDrawRangeElements(GL_TRIANGLES, 0, 3, 3, GL_UNSIGNED_INT, &ind[3]);
+	glGenBuffers(1, &this->iboId);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->iboId);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+}
+
+
+void Grid::enqueue(RenderQueue& queue) {
+	queue.add(this->shader, this->vaoId, GL_TRIANGLES, 0, 6);
+}
+
+
+void Grid::beginRender() {
+	if (this->shader != nullptr)
+		this->shader->enable();
+
+	glBindVertexArray(this->vaoId);
+	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, BUFFER_OFFSET(0));
+	glBindVertexArray(0);
 }
 
 
@@ -92,9 +108,12 @@ void Grid::endRender() {
 	if (this->shader != nullptr)
 		this->shader->disable();
 
-	glDisableVertexAttribArray(POSITION_LOC);
-	glDisableVertexAttribArray(COLOR_LOC);
+	glDeleteVertexArrays(1, &this->vaoId);
+	glDeleteBuffers(1, &this->iboId);
 	glDeleteBuffers(1, &this->vboId);
+	this->vaoId = 0;
+	this->iboId = 0;
+	this->vboId = 0;
 }
 
 
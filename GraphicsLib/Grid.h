@@ -3,6 +3,7 @@
 #include <vector>
 #include "Shader.h"
 #include "Color3.h"
+#include "RenderQueue.h"
 
 using namespace std;
 
@@ -18,11 +19,18 @@ public:
 	~Grid();
 
 	void loadShader(const std::string& vertexShader, const std::string& fragmentShader);
+	void setShader(const shared_ptr<Shader>& shader);
 
 	/* Row lines are along the x axis. Column lines are along the z axis. */
 	void constructGrid(const Color3f &color, float y, float x_min, float x_max, float z_min, float z_max);
 
+	//Record the ground in @queue. The item never changes, so this is only needed once per queue.
+	void enqueue(RenderQueue& queue);
+
+	//Draw the ground right away, outside of a queue.
 	void beginRender();
+
+	//Release the GPU objects.
 	void endRender();
 
 	shared_ptr<Shader>& getShader();
@@ -37,5 +45,9 @@ protected:
 	shared_ptr<Shader> shader;
 	vector<GridVertex> vertices;
 	unsigned int vboId;
+
+	//Two triangles over the four corners, kept in an element buffer captured by vaoId.
+	unsigned int iboId;
+	unsigned int vaoId;
 };
 
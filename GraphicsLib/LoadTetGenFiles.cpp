@@ -1,4 +1,5 @@
 #include "LoadTetGenFiles.h"
+#include <algorithm>
 
 
 LoadTetGenFiles::LoadTetGenFiles(string file0, string file1, string file2) : node_file_name(file0), ele_file_name(file1), face_file_name(file2)
@@ -71,6 +72,8 @@ vector<Vector2f> LoadTetGenFiles::LoadEleFile() {
 	istringstream iss;
 	size_t info;
 	float p0, p1, p2, p3;
+	size_t nodes_per_tetrahedron = 4, attribute_count = 0;
+	double region;
 	list<Vector2f>::iterator it = this->raw_springs_list.begin();
 
 	ele_file_stream.open(this->ele_file_name);
@@ -84,7 +87,10 @@ vector<Vector2f> LoadTetGenFiles::LoadEleFile() {
 	getline(ele_file_stream, string_value);
 	iss.clear();
 	iss.str(string_value);
-	iss >> this->tetrahedrons_num;
+	iss >> this->tetrahedrons_num >> nodes_per_tetrahedron >> attribute_count;
+	this->tetrahedrons.resize(this->tetrahedrons_num * 4);
+	if (attribute_count > 0)
+		this->tetrahedron_regions.resize(this->tetrahedrons_num);
 
 	while (getline(ele_file_stream, string_value)) {
 		iss.clear();
@@ -97,6 +103,19 @@ vector<Vector2f> LoadTetGenFiles::LoadEleFile() {
 			iss >> p2;
 			iss >> p3;
 
+			this->tetrahedrons[4 * info] = static_cast<unsigned int>(p0);
+			this->tetrahedrons[4 * info + 1] = static_cast<unsigned int>(p1);
+			this->tetrahedrons[4 * info + 2] = static_cast<unsigned int>(p2);
+			this->tetrahedrons[4 * info + 3] = static_cast<unsigned int>(p3);
+
+			/* Quadratic elements list six more nodes before the attributes. The first attribute is the region. */
+			if (attribute_count > 0) {
+				for (size_t n = 4; n < nodes_per_tetrahedron; n++)
+					iss >> region;
+				iss >> region;
+				this->tetrahedron_regions[info] = (region > 0.0) ? static_cast<unsigned int>(region + 0.5) : 0;
+			}
+
 			this->raw_springs_list.insert(it, Vector2f(p0, p1));
 			this->raw_springs_list.insert(it, Vector2f(p1, p2));
 			this->raw_springs_list.insert(it, Vector2f(p0, p2));
@@ -115,6 +134,9 @@ vector<Vector2f> LoadTetGenFiles::LoadEleFile() {
 
 	//Currently it does not have redundant information.
 	this->starting_springs = TransListToArray(this->raw_springs_list);
+
+	if (!this->tetrahedron_regions.empty())
+		this->_propagateRegions();
 	return this->starting_springs;
 }
 
@@ -160,6 +182,35 @@ vector<Vector3f> LoadTetGenFiles::loadFaceFile() {
 }
 
 
+void LoadTetGenFiles::_propagateRegions() {
+	static const int edge_corners[6][2] = { { 0, 1 }, { 1, 2 }, { 0, 2 }, { 0, 3 }, { 1, 3 }, { 2, 3 } };
+
+	/* The edges are keyed by their two particles, the smaller one first, as the springs may list them either way. */
+	unordered_map<unsigned long long, unsigned int> edge_regions;
+	this->particle_regions.assign(this->particles_num, 0);
+	for (size_t t = 0; t < this->tetrahedron_regions.size(); t++) {
+		unsigned int region = this->tetrahedron_regions[t];
+		const unsigned int *corners = &this->tetrahedrons[4 * t];
+
+		for (size_t c = 0; c < 4; c++)
+			this->particle_regions[corners[c]] = max(this->particle_regions[corners[c]], region);
+
+		for (size_t e = 0; e < 6; e++) {
+			unsigned long long a = corners[edge_corners[e][0]], b = corners[edge_corners[e][1]];
+			unsigned int &edge_region = edge_regions[(min(a, b) << 32) | max(a, b)];
+			edge_region = max(edge_region, region);
+		}
+	}
+
+	this->spring_regions.resize(this->starting_springs.size());
+	for (size_t i = 0; i < this->starting_springs.size(); i++) {
+		unsigned long long a = static_cast<unsigned long long>(this->starting_springs[i][0]);
+		unsigned long long b = static_cast<unsigned long long>(this->starting_springs[i][1]);
+		this->spring_regions[i] = edge_regions[(min(a, b) << 32) | max(a, b)];
+	}
+}
+
+
 void LoadTetGenFiles::_createSpringsFromFaceFile() {
 	list<Vector2f> springs;
 	list<Vector2f>::iterator it = springs.begin();
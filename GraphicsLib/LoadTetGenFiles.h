@@ -6,6 +6,7 @@
 #include <fstream>
 #include <vector>
 #include <list>
+#include <unordered_map>
 #include <Vector3.h>
 #include <Vector2.h>
 
@@ -26,6 +27,11 @@ public:
 	vector<Vector2f> LoadEleFile();
 	vector<Vector3f> loadFaceFile();
 
+	/*	Spread the tetrahedron regions to the springs and particles. Where regions meet, an element gets
+	*	the highest region among its tetrahedra, so tissue embedded in another (scar in the ventricle wall)
+	*	should have the higher number.	*/
+	void _propagateRegions();
+
 	void _createSpringsFromFaceFile();
 	vector<Vector2f> TransListToArray(list<Vector2f> clean_springs_list);
 	void DisplayInfo();
@@ -38,5 +44,13 @@ public:
 	list<Vector2f> raw_springs_list;
 	vector<Vector2f> starting_springs;
 	vector<Vector3f> faces;
+
+	//Four node indices per tetrahedron, as listed in the .ele file. Empty when no .ele file was loaded.
+	vector<unsigned int> tetrahedrons;
+
+	//The region attribute of every tetrahedron (TetGen -A), and the regions spread from them. Empty when the .ele file has no attributes.
+	vector<unsigned int> tetrahedron_regions;
+	vector<unsigned int> spring_regions;
+	vector<unsigned int> particle_regions;
 };
 
@@ -0,0 +1,204 @@
+#include "MultiBodyRenderer.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#define TRANSFORM_LOC 0
+#define FLOATS_PER_VERTEX (sizeof(ParticleVertex) / sizeof(float))
+
+
+MultiBodyRenderer::MultiBodyRenderer() :
+model_view_location(-1),
+projection_location(-1),
+vertex_count_location(-1),
+floats_per_vertex_location(-1),
+body_vertices_location(-1),
+vertex_count(0),
+body_count(0),
+vertices_changed(false),
+transforms_changed(false),
+vertex_buffer(0),
+vertex_texture(0),
+transform_buffer(0),
+index_buffer(0),
+lines_count(0),
+triangles_count(0),
+vao(0),
+draw_calls(0)
+{
+}
+
+
+MultiBodyRenderer::~MultiBodyRenderer()
+{
+	this->release();
+}
+
+
+void MultiBodyRenderer::setShader(const shared_ptr<Shader>& shader) {
+	this->shader = shader;
+
+	unsigned int program = (shader != nullptr) ? shader->getProgramID() : 0;
+	this->model_view_location = glGetUniformLocation(program, "modelViewMatrix");
+	this->projection_location = glGetUniformLocation(program, "projectionMatrix");
+	this->vertex_count_location = glGetUniformLocation(program, "vertexCount");
+	this->floats_per_vertex_location = glGetUniformLocation(program, "floatsPerVertex");
+	this->body_vertices_location = glGetUniformLocation(program, "bodyVertices");
+}
+
+
+void MultiBodyRenderer::setBodyTransform(size_t body, const Matrix4f& transform) {
+	if (body >= this->body_count)
+		return;
+
+	std::memcpy(&this->transforms[16 * body], transform.constData(), 16 * sizeof(float));
+	this->transforms_changed = true;
+}
+
+
+void MultiBodyRenderer::arrangeInGrid(float spacing) {
+	size_t columns = static_cast<size_t>(std::ceil(std::sqrt(static_cast<float>(this->body_count))));
+	if (columns == 0)
+		return;
+
+	size_t rows = (this->body_count + columns - 1) / columns;
+	float x_start = -0.5f * spacing * (columns - 1);
+	float z_start = -0.5f * spacing * (rows - 1);
+
+	for (size_t i = 0; i < this->body_count; i++) {
+		Matrix4f transform = Matrix4f::Identity();
+		transform.set(12, x_start + spacing * (i % columns));
+		transform.set(14, z_start + spacing * (i / columns));
+		this->setBodyTransform(i, transform);
+	}
+}
+
+
+bool MultiBodyRenderer::_constructOnGPU(const vector<unsigned int>& lines, const vector<unsigned int>& triangles) {
+	size_t texels = this->vertices.size() * FLOATS_PER_VERTEX;
+	int max_texels = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &max_texels);
+	if (texels > static_cast<size_t>(max_texels)) {
+		cerr << "[MultiBodyRenderer:construct] Error: " << this->body_count << " bodies need " << texels
+			<< " buffer texels, the driver allows " << max_texels << "." << endl;
+		return false;
+	}
+
+	/* Single float texels keep the layout of ParticleVertex and only need GL 3.1 buffer textures. */
+	glGenBuffers(1, &this->vertex_buffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, this->vertex_buffer);
+	glBufferData(GL_TEXTURE_BUFFER, this->vertices.size() * sizeof(ParticleVertex), &this->vertices[0], GL_STREAM_DRAW);
+
+	glGenTextures(1, &this->vertex_texture);
+	glBindTexture(GL_TEXTURE_BUFFER, this->vertex_texture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, this->vertex_buffer);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	vector<unsigned int> indices(lines);
+	indices.insert(indices.end(), triangles.begin(), triangles.end());
+	this->lines_count = static_cast<unsigned int>(lines.size());
+	this->triangles_count = static_cast<unsigned int>(triangles.size());
+
+	glGenVertexArrays(1, &this->vao);
+	glBindVertexArray(this->vao);
+
+	glGenBuffers(1, &this->index_buffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->index_buffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.empty() ? NULL : &indices[0], GL_STATIC_DRAW);
+
+	/* The matrix is the only vertex attribute. Its array is bound to location 0 so compatibility contexts still draw. */
+	glGenBuffers(1, &this->transform_buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, this->transform_buffer);
+	glBufferData(GL_ARRAY_BUFFER, this->transforms.size() * sizeof(float), &this->transforms[0], GL_DYNAMIC_DRAW);
+	for (unsigned int column = 0; column < 4; column++) {
+		glEnableVertexAttribArray(TRANSFORM_LOC + column);
+		glVertexAttribPointer(TRANSFORM_LOC + column, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(float), (char *)NULL + column * 4 * sizeof(float));
+		glVertexAttribDivisor(TRANSFORM_LOC + column, 1);
+	}
+
+	glBindVertexArray(0);
+
+	this->vertices_changed = false;
+	this->transforms_changed = false;
+	return true;
+}
+
+
+void MultiBodyRenderer::render(const Matrix4f& modelViewMatrix, const Matrix4f& projectionMatrix, bool lines) {
+	this->draw_calls = 0;
+	if (this->vao == 0 || this->shader == nullptr)
+		return;
+
+	if (this->vertices_changed) {
+		glBindBuffer(GL_TEXTURE_BUFFER, this->vertex_buffer);
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, this->vertices.size() * sizeof(ParticleVertex), &this->vertices[0]);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+		this->vertices_changed = false;
+	}
+
+	if (this->transforms_changed) {
+		glBindBuffer(GL_ARRAY_BUFFER, this->transform_buffer);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, this->transforms.size() * sizeof(float), &this->transforms[0]);
+		this->transforms_changed = false;
+	}
+
+	this->shader->enable();
+	glUniformMatrix4fv(this->model_view_location, 1, false, modelViewMatrix.constData());
+	glUniformMatrix4fv(this->projection_location, 1, false, projectionMatrix.constData());
+	glUniform1i(this->vertex_count_location, static_cast<int>(this->vertex_count));
+	glUniform1i(this->floats_per_vertex_location, static_cast<int>(FLOATS_PER_VERTEX));
+	glUniform1i(this->body_vertices_location, 0);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_BUFFER, this->vertex_texture);
+	glBindVertexArray(this->vao);
+
+	if (lines && this->lines_count > 0) {
+		glDrawElementsInstanced(GL_LINES, this->lines_count, GL_UNSIGNED_INT, NULL, this->body_count);
+		this->draw_calls++;
+	}
+	else if (!lines && this->triangles_count > 0) {
+		glDrawElementsInstanced(GL_TRIANGLES, this->triangles_count, GL_UNSIGNED_INT, (char *)NULL + this->lines_count * sizeof(unsigned int), this->body_count);
+		this->draw_calls++;
+	}
+
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	this->shader->disable();
+}
+
+
+void MultiBodyRenderer::release() {
+	if (this->vao != 0) {
+		glDeleteVertexArrays(1, &this->vao);
+		glDeleteBuffers(1, &this->index_buffer);
+		glDeleteBuffers(1, &this->transform_buffer);
+	}
+
+	if (this->vertex_texture != 0) {
+		glDeleteTextures(1, &this->vertex_texture);
+		glDeleteBuffers(1, &this->vertex_buffer);
+	}
+
+	this->vao = 0;
+	this->index_buffer = 0;
+	this->transform_buffer = 0;
+	this->vertex_texture = 0;
+	this->vertex_buffer = 0;
+
+	this->vertex_count = 0;
+	this->body_count = 0;
+	this->vertices.clear();
+	this->transforms.clear();
+}
+
+
+size_t MultiBodyRenderer::getBodyCount() const {
+	return this->body_count;
+}
+
+
+size_t MultiBodyRenderer::getDrawCallCount() const {
+	return this->draw_calls;
+}
\ No newline at end of file
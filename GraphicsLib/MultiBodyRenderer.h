@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "Shader.h"
+#include "ParticleSystem.h"
+
+using namespace std;
+
+/*
+*	Draws many particle systems that share one topology, e.g. the same heart simulated with
+*	different parameters, with a single instanced draw call. The vertex streams of all bodies are
+*	packed back to back into one buffer that the vertex shader reads as a buffer texture, indexed by
+*	gl_InstanceID and gl_VertexID. Every body has its own model matrix, passed as an instanced
+*	attribute. The draw call count does not depend on the number of bodies.
+*	All functions except updateBody() and setBodyTransform() must be called with the GL context current.	*/
+class MultiBodyRenderer
+{
+public:
+	MultiBodyRenderer();
+	~MultiBodyRenderer();
+
+	/*	The program reads the vertices from the samplerBuffer "bodyVertices", with "vertexCount" vertices
+	*	of "floatsPerVertex" floats per body, and the model matrix from the mat4 attribute at locations 0 to 3.
+	*	The uniform locations are looked up here once.	*/
+	void setShader(const shared_ptr<Shader>& shader);
+
+	//Allocate @body_count streams laid out like the vertices @topology draws, and take over its indices.
+	template <class Real>
+	bool construct(const ParticleSystem<Real>& topology, size_t body_count);
+
+	//Copy the current vertices of @system into the stream of @body. The upload happens in render().
+	template <class Real>
+	void updateBody(size_t body, const ParticleSystem<Real>& system);
+
+	void setBodyTransform(size_t body, const Matrix4f& transform);
+
+	//Place the bodies on a square grid in the xz plane, @spacing apart and centered on the origin.
+	void arrangeInGrid(float spacing);
+
+	//Draw every body as lines or as triangles.
+	void render(const Matrix4f& modelViewMatrix, const Matrix4f& projectionMatrix, bool lines);
+
+	//Delete the GPU objects and forget the bodies.
+	void release();
+
+	size_t getBodyCount() const;
+
+	//Draw calls issued by the last render(). Stays at one whatever the body count.
+	size_t getDrawCallCount() const;
+
+protected:
+	bool _constructOnGPU(const vector<unsigned int>& lines, const vector<unsigned int>& triangles);
+
+protected:
+	shared_ptr<Shader> shader;
+	int model_view_location;
+	int projection_location;
+	int vertex_count_location;
+	int floats_per_vertex_location;
+	int body_vertices_location;
+
+	size_t vertex_count;
+	size_t body_count;
+
+	//The vertex streams of all bodies, body after body.
+	vector<ParticleVertex> vertices;
+
+	//One column major model matrix per body.
+	vector<float> transforms;
+
+	bool vertices_changed;
+	bool transforms_changed;
+
+	unsigned int vertex_buffer;
+	unsigned int vertex_texture;
+	unsigned int transform_buffer;
+
+	//Line indices first, the triangle indices follow.
+	unsigned int index_buffer;
+	unsigned int lines_count;
+	unsigned int triangles_count;
+
+	unsigned int vao;
+	size_t draw_calls;
+};
+
+
+template <class Real>
+bool MultiBodyRenderer::construct(const ParticleSystem<Real>& topology, size_t body_count) {
+	this->release();
+
+	this->vertex_count = topology.getRenderVertexCount();
+	this->body_count = body_count;
+	if (this->vertex_count == 0 || body_count == 0)
+		return false;
+
+	this->vertices.resize(this->vertex_count * body_count);
+	for (size_t i = 0; i < body_count; i++)
+		topology.copyRenderVertices(&this->vertices[i * this->vertex_count]);
+
+	this->transforms.resize(16 * body_count);
+	for (size_t i = 0; i < body_count; i++)
+		this->setBodyTransform(i, Matrix4f::Identity());
+
+	return this->_constructOnGPU(topology.getRenderLineIndices(), topology.getRenderTriangleIndices());
+}
+
+
+template <class Real>
+void MultiBodyRenderer::updateBody(size_t body, const ParticleSystem<Real>& system) {
+	if (body >= this->body_count || system.getRenderVertexCount() != this->vertex_count)
+		return;
+
+	system.copyRenderVertices(&this->vertices[body * this->vertex_count]);
+	this->vertices_changed = true;
+}
\ No newline at end of file
@@ -1745,6 +1745,8 @@ static unsigned deflateDynamic(ucvector* out, size_t* bp, Hash* hash,
   unsigned HLIT, HDIST, HCLEN;
 
   uivector_init(&lz77_encoded);
+  /*about one value per input byte, reserved up front instead of growing one push_back at a time*/
+  uivector_reserve(&lz77_encoded, datasize * sizeof(unsigned));
   HuffmanTree_init(&tree_ll);
   HuffmanTree_init(&tree_d);
   HuffmanTree_init(&tree_cl);
@@ -1993,6 +1995,83 @@ static unsigned deflateFixed(ucvector* out, size_t* bp, Hash* hash,
   return error;
 }
 
+#ifdef _OPENMP
+/*
+Compresses every dynamic block with its own hash table into its own buffer, so that the
+blocks can be compressed concurrently. LZ77 matches can therefore not reach back into the
+previous block. Every block but the last is followed by an empty stored block, which ends it
+on a byte boundary (like zlib's Z_SYNC_FLUSH) so the buffers can simply be concatenated.
+*/
+static unsigned lodepng_deflatev_parallel(ucvector* out, const unsigned char* in, size_t insize,
+                                          size_t blocksize, size_t numdeflateblocks,
+                                          const LodePNGCompressSettings* settings)
+{
+  unsigned error = 0;
+  size_t i, total = 0;
+  int b, numblocks = (int)numdeflateblocks;
+  ucvector* blocks = (ucvector*)lodepng_malloc(sizeof(ucvector) * numdeflateblocks);
+  if(!blocks) return 83; /*alloc fail*/
+
+  for(i = 0; i != numdeflateblocks; ++i)
+  {
+    blocks[i].data = NULL;
+    blocks[i].size = blocks[i].allocsize = 0;
+  }
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(settings->numthreads)
+  for(b = 0; b < numblocks; ++b)
+  {
+    unsigned blockerror;
+    unsigned final = (b == numblocks - 1);
+    size_t bp = 0; /*the bit pointer, every block starts a new buffer*/
+    size_t start = (size_t)b * blocksize;
+    size_t end = start + blocksize;
+    Hash hash;
+    if(end > insize) end = insize;
+
+    /*a dynamic block is rarely larger than its input, so this normally is the only allocation*/
+    ucvector_reserve(&blocks[b], end - start + 64);
+
+    blockerror = hash_init(&hash, settings->windowsize);
+    if(!blockerror) blockerror = deflateDynamic(&blocks[b], &bp, &hash, in, start, end, settings, final);
+    hash_cleanup(&hash);
+
+    if(!blockerror && !final)
+    {
+      /*empty stored block: BFINAL 0, BTYPE 00, pad to the byte, then LEN 0 and NLEN 0xFFFF*/
+      addBitsToStream(&bp, &blocks[b], 0, 3);
+      ucvector_push_back(&blocks[b], 0);
+      ucvector_push_back(&blocks[b], 0);
+      ucvector_push_back(&blocks[b], 255);
+      ucvector_push_back(&blocks[b], 255);
+    }
+
+    if(blockerror)
+    {
+#pragma omp critical
+      error = blockerror;
+    }
+  }
+
+  for(i = 0; i != numdeflateblocks; ++i) total += blocks[i].size;
+
+  if(!error && !ucvector_reserve(out, out->size + total)) error = 83; /*alloc fail*/
+
+  for(i = 0; i != numdeflateblocks; ++i)
+  {
+    if(!error)
+    {
+      memcpy(out->data + out->size, blocks[i].data, blocks[i].size);
+      out->size += blocks[i].size;
+    }
+    lodepng_free(blocks[i].data);
+  }
+
+  lodepng_free(blocks);
+  return error;
+}
+#endif /*_OPENMP*/
+
 static unsigned lodepng_deflatev(ucvector* out, const unsigned char* in, size_t insize,
                                  const LodePNGCompressSettings* settings)
 {
@@ -2015,6 +2094,13 @@ static unsigned lodepng_deflatev(ucvector* out, const unsigned char* in, size_t
   numdeflateblocks = (insize + blocksize - 1) / blocksize;
   if(numdeflateblocks == 0) numdeflateblocks = 1;
 
+#ifdef _OPENMP
+  if(settings->btype == 2 && settings->numthreads > 1 && numdeflateblocks > 1)
+  {
+    return lodepng_deflatev_parallel(out, in, insize, blocksize, numdeflateblocks, settings);
+  }
+#endif /*_OPENMP*/
+
   error = hash_init(&hash, settings->windowsize);
   if(error) return error;
 
@@ -2170,7 +2256,6 @@ unsigned lodepng_zlib_compress(unsigned char** out, size_t* outsize, const unsig
   /*initially, *out must be NULL and outsize 0, if you just give some random *out
   that's pointing to a non allocated buffer, this'll crash*/
   ucvector outv;
-  size_t i;
   unsigned error;
   unsigned char* deflatedata = 0;
   size_t deflatesize = 0;
@@ -2194,10 +2279,16 @@ unsigned lodepng_zlib_compress(unsigned char** out, size_t* outsize, const unsig
   if(!error)
   {
     unsigned ADLER32 = adler32(in, (unsigned)insize);
-    for(i = 0; i != deflatesize; ++i) ucvector_push_back(&outv, deflatedata[i]);
-    lodepng_free(deflatedata);
-    lodepng_add32bitInt(&outv, ADLER32);
+    /*one copy into a buffer of the final size instead of a push_back per byte*/
+    if(ucvector_reserve(&outv, outv.size + deflatesize + 4))
+    {
+      memcpy(outv.data + outv.size, deflatedata, deflatesize);
+      outv.size += deflatesize;
+      lodepng_add32bitInt(&outv, ADLER32);
+    }
+    else error = 83; /*alloc fail*/
   }
+  lodepng_free(deflatedata);
 
   *out = outv.data;
   *outsize = outv.size;
@@ -2262,9 +2353,11 @@ void lodepng_compress_settings_init(LodePNGCompressSettings* settings)
   settings->custom_zlib = 0;
   settings->custom_deflate = 0;
   settings->custom_context = 0;
+
+  settings->numthreads = 1;
 }
 
-const LodePNGCompressSettings lodepng_default_compress_settings = {2, 1, DEFAULT_WINDOWSIZE, 3, 128, 1, 0, 0, 0};
+const LodePNGCompressSettings lodepng_default_compress_settings = {2, 1, DEFAULT_WINDOWSIZE, 3, 128, 1, 0, 0, 0, 1};
 
 
 #endif /*LODEPNG_COMPILE_ENCODER*/
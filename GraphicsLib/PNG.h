@@ -23,6 +23,11 @@ freely, subject to the following restrictions:
     distribution.
 */
 
+/*
+Altered source version: adds a multithreaded deflate path, see numthreads in
+LodePNGCompressSettings, and preallocates the zlib and LZ77 buffers.
+*/
+
 #ifndef LODEPNG_H
 #define LODEPNG_H
 
@@ -303,6 +308,10 @@ struct LodePNGCompressSettings /*deflate = compress*/
                              const LodePNGCompressSettings*);
 
   const void* custom_context; /*optional custom settings for custom functions*/
+
+  /*Not in the original LodePNG: how many deflate blocks to compress at the same time (needs OpenMP).
+  With more than 1, every block gets its own LZ77 window, which costs a little compression. Default: 1*/
+  unsigned numthreads;
 };
 
 extern const LodePNGCompressSettings lodepng_default_compress_settings;
@@ -3,22 +3,39 @@
 #include "Particle.h"
 #include "Spring.h"
 #include <vector>
+#include <algorithm>
 #include <math.h>
 #include <memory>
+#include <iostream>
 #include <Vector2.h>
+#include <VectorBatch.h>
+#include <MatrixBatch.h>
+#include <VectorExpression.h>
 #include "Shader.h"
+#include "ResourceManager.h"
+#include "RenderQueue.h"
+#include "VertexCacheOptimizer.h"
+#include "EmbeddedMesh.h"
 #include "Color3.h"
+#include "RegionMaterials.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
 #define POSITION_LOC 0
 #define COLOR_LOC 1
+#define NORMAL_LOC 2
 
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
 struct ParticleVertex {
 	Vector3f position;
 	Color3f color;
+
+	//Area weighted vertex normal. Only kept up to date for particles on the surface faces.
+	Vector3f normal;
 };
 
 
@@ -32,13 +49,14 @@ public:
 	*	@p_count specifies - how many particles the system has. 
 	*	@s_count specifies - how many springs the system has.	*/
 	ParticleSystem(size_t p_count, size_t s_count);
-	~ParticleSystem();
+	virtual ~ParticleSystem();
 
 	//Set the initial values that provided by the user.
 	void setParticlesPositions(vector< Vector3<Real> > starting_positions);
 
-	//Set the particles mass for all the particles inside the system. The default is 1.0f.
-	void setParticlesMass(Real mass);
+	/*	Set the particles mass for all the particles inside the system. The default is 1.0f. Particles given
+	*	their own mass by setRegionMaterials() keep their ratio to it.	*/
+	virtual void setParticlesMass(Real mass);
 
 	// Deprecated for use.
 	//Set springs' connection info. Every springs has two particles connecting each other. 
@@ -54,19 +72,72 @@ public:
 	//Set the springs' rest length.
 	void setSpringsLength(Real length);
 
-	//Set the springs' stiffness. The default value is 20.
+	/*	Set the springs' stiffness. The default value is 20. Springs given their own stiffness by
+	*	setSpringsStiffnesses() or setRegionMaterials() keep their ratio to it, they are scaled along.	*/
 	void setSpringsStiffness(Real k);
 
-	//Provide with a fixed variation for every srping.
-	void addSpringsRestLength(Real delta);
-
-	/*	Provide with a homogeneous variation.
-	 *	@ratio, the changing ratio of the spring. E.g., 1.1 means the 
-	 *	length of the spring will be multiplied with this parameter.	*/
-	void addSpringsRestLengthHomogeneous(Real ratio);
+	/*	Per spring stiffness and contraction, e.g. from a FiberField. The stiffness of setSpringsStiffness()
+	*	stays the reference the per spring values are relative to. A spring with contraction c moves
+	*	its rest length by c times the change the activation asks for, 1 (the default) follows it fully.	*/
+	bool setSpringsStiffnesses(const vector<Real> &k);
+	bool setSpringsContractions(const vector<Real> &contractions);
+
+	/*	Activation: the rest length of a spring is its base length d_r times @scale plus @offset, read by
+	*	the force kernel. A beat only changes these two numbers, the base lengths are never touched, so
+	*	setActivation(1, 0) restores the rest shape exactly. Applies to every region, scaled by its contractility.	*/
+	void setActivation(Real scale, Real offset = Real(0));
+
+	/*	Put spring i into region @regions[i]. Each region has its own activation, which starts as the
+	*	current activation of region 0.	*/
+	bool setSpringsRegions(const vector<unsigned int> &regions);
+	void setRegionActivation(unsigned int region, Real scale, Real offset = Real(0));
+	size_t getRegionCount() const;
+	Real getActivationScale(unsigned int region = 0) const;
+	Real getActivationOffset(unsigned int region = 0) const;
+
+	/*	Propagating contraction: spring i follows the activation of its region @delays[i] seconds late,
+	*	e.g. the activation times of an ActivationMap. The activations of the last steps are kept in a
+	*	short history, so the force kernel only looks up an older entry. The delays are rounded to whole
+	*	steps. An empty vector makes every spring follow the current activation again.	*/
+	bool setSpringsDelays(const vector<Real> &delays);
 
 	void setFaces(const vector<Vector3f> &tet_faces);
 
+	/*	Draw and upload only the particles and edges that lie on the surface faces.
+	*	Has no effect on systems without faces, e.g. the hard coded meshes.	*/
+	void setSurfaceOnly(bool surface_only);
+	bool hasSurface() const;
+
+	/*	Keep the tetrahedra of the mesh, four particle indices each as listed in the .ele file.
+	*	Their signed volumes at the current positions are the rest volumes of the volume term.	*/
+	virtual bool setTetrahedrons(const vector<unsigned int> &tetrahedrons);
+	size_t getTetrahedronCount() const;
+
+	/*	Volume preservation: every tetrahedron pushes its nodes along the gradient of its volume V
+	*	with the force -k (V - V0) / V0 dV/dx, independent of the springs' rest lengths. @k is a bulk
+	*	modulus, 0 (the default) disables the term. The overload sets one modulus per tetrahedron.
+	*	The finite element system does not use it, its Poisson ratio already bounds the volume change.	*/
+	void setBulkModulus(Real k);
+	void setBulkModuli(const vector<Real> &k);
+
+	/*	Heterogeneous tissue: scale the masses, spring stiffnesses, bulk moduli and damping of every element
+	*	by the material of its region, and let each region follow its share of the activation. Call once
+	*	after the mesh, its stiffness and its tetrahedra are set up, the factors apply to the current values.
+	*	@tetrahedron_regions may be empty when the volume term is not used. Uniform meshes need no call.	*/
+	bool setRegionMaterials(const RegionMaterials &materials, const vector<unsigned int> &spring_regions,
+		const vector<unsigned int> &particle_regions, const vector<unsigned int> &tetrahedron_regions);
+
+	/*	Blood pressure in the cavities, the closed surface components enclosed by another one (the outer
+	*	wall). Every inner face pushes its three corners out of the cavity with @pressure times a third of
+	*	its area. 0 (the default) disables it. Meshes without inner surfaces have no cavities.	*/
+	void setCavityPressure(Real pressure);
+	Real getCavityPressure() const;
+	size_t getCavityCount() const;
+
+	/*	The volume enclosed by the cavities after the last step, from their faces by the divergence theorem.
+	*	A mesh without cavities reports the volume enclosed by its whole surface instead.	*/
+	double getCavityVolume() const;
+
 	void setLinearDampingAttributes(float a, float b, float t, float k_max);
 
 	inline void setLoadMeshBoolVariable(bool load_mesh = true);
@@ -101,11 +172,16 @@ public:
 
 	bool getLoadMeshBoolVariable();
 
-	void handleLinearDamping(Vector3<Real> &velocity);
+	//@scale, the damping factor of the particle's region.
+	void handleLinearDamping(Vector3<Real> &velocity, float scale = 1.0f);
 
 	//Update the particle system whenever the timer expires. E.g, updating positions, velocities, etc.
 	//The variable dt is the time step which here is specified in seconds.
-	void updateParticleSystem(float dt);
+	virtual void updateParticleSystem(float dt);
+
+	/*	Used instead of updateParticleSystem() when this system is only a render mesh embedded in @driver.
+	*	The particles are placed by the embedding, then the normals and the vertex buffer are refreshed.	*/
+	void followEmbedding(EmbeddedMesh &embedding, const ParticleSystem<Real> &driver);
 
 	/* 
 	*	Collision handling function for the particle with the index.
@@ -123,10 +199,41 @@ public:
 	inline void setBounceEnergyLossRatio(float ratio);
 
 	void loadShader(const std::string& vertexShader, const std::string& fragmentShader);
+
+	//Use a program owned by someone else, e.g. the ResourceManager, instead of compiling a new one.
+	void setShader(const shared_ptr<Shader>& shader);
+
+	//Program used for the triangles in surface shading. Points and lines keep using the main shader.
+	void setSurfaceShader(const shared_ptr<Shader>& shader);
+
 	void constructOnGPU();
+
+	//Upload the vertices into the manager's shared particle buffer. The buffer is reused across meshes and not deleted by this system.
+	void constructOnGPU(ResourceManager& resources, const string& buffer_name = "ParticleSystem");
+
+	/*	Record the points, lines and triangles of this system in @queue. Call after constructOnGPU().
+	*	updateQueue() then only adjusts the ranges to the shading and surface only modes.	*/
+	void enqueue(RenderQueue& queue);
+	void updateQueue(RenderQueue& queue) const;
+
+	//Draw the system right away, outside of a queue.
 	void beginRender();
+
+	//Release the GPU objects owned by this system.
 	void endRender();
+
+	//Copy the current positions into the vertex buffer. Only the surface vertices are sent in surface only mode.
+	void uploadVertices();
+
+	/*	The vertices and indices in the layout uploadVertices() and beginRender() use: the compact surface
+	*	ones in surface only mode, all of them otherwise. For renderers that keep their own vertex copy.	*/
+	size_t getRenderVertexCount() const;
+	void copyRenderVertices(ParticleVertex* destination) const;
+	const vector<unsigned int>& getRenderLineIndices() const;
+	const vector<unsigned int>& getRenderTriangleIndices() const;
+
 	shared_ptr<Shader>& getShader();
+	shared_ptr<Shader>& getSurfaceShader();
 
 public:
 	long double rest_length_sum;
@@ -150,6 +257,9 @@ public:
 	//To set if the system is lines shaded or surface shaded.
 	bool is_lines_shading;
 
+	//To set if interior particles and springs are skipped. Use setSurfaceOnly() to change it.
+	bool is_surface_only;
+
 protected:
 	//Called automatically by the setSprings(vector< vector<size_t> > starting_springs) function to initialize the springs' position info.
 	inline void _setSpringsPositions();
@@ -157,6 +267,54 @@ protected:
 	//The original faces data were stored as vector<Vector3f>. We want it to be stored in an 1-d array as vector<unsigned int>.
 	inline void _converFacesToArray(const vector<Vector3f> &original_faces);
 
+	//Fill the element buffer from the index arrays and capture both buffers in the VAO.
+	void _constructVertexArray(ResourceManager* resources, const string& buffer_name);
+
+	//Collect the particles and edges referenced by surIndex and renumber them into a compact vertex range.
+	void _buildSurfaceSubset();
+
+	//For every surface particle, list the faces around it. Stored as offsets into one flat array.
+	void _buildVertexFaceAdjacency();
+
+	/*	Add the volume preservation forces to the particles. The positions are packed once, padded to four
+	*	values per particle, then every slice of the tetrahedra scatters its forces into its own buffer, which
+	*	only covers the particles the slice touches, and every particle sums the buffers that cover it.	*/
+	void _addVolumeForces();
+
+	//Split the tetrahedra into @slice_count contiguous slices and find the particle range each one touches.
+	void _buildVolumeSlices(size_t slice_count);
+
+	/*	Add the forces of the tetrahedra @begin up to @end to @forces, four values per particle. The float
+	*	overload runs the blocks of the lane kernel first and this code for the rest.	*/
+	void _addTetrahedronForces(unsigned int begin, unsigned int end, Real *forces) const;
+	void _addVolumeSliceForces(unsigned int begin, unsigned int end, float *forces, float) const;
+	template <class T>
+	void _addVolumeSliceForces(unsigned int begin, unsigned int end, Real *forces, T) const;
+
+	//The lane kernel: gathers the corners of Lanes::WIDTH tetrahedra, computes their forces side by side and scatters them. Returns the tetrahedra done.
+	template <class Lanes>
+	unsigned int _addTetrahedronForceBlocks(unsigned int begin, unsigned int end, float *forces) const;
+
+	/*	Find the closed surface components that lie inside another one, orient their faces out of the cavity
+	*	and list the cavity faces around every cavity vertex, the same way as the vertex faces.	*/
+	void _buildCavities();
+
+	/*	Add the cavity pressure to the particles on the inner surfaces. Uses the face normals of the
+	*	current positions, every particle gathers its own faces.	*/
+	void _addPressureForces();
+
+	//Sum the cavity volume over the faces with the normals of the current positions, a parallel reduction.
+	void _updateCavityVolume();
+
+	/*	Push the current activation into the history. Converts the delays to steps of @dt and refills the
+	*	history with the current activation whenever the step or the regions changed.	*/
+	void _recordActivation(float dt);
+
+	/*	Recompute the normals of the surface particles from their current positions. The face
+	*	normals are computed first, then every particle gathers its own faces, so no two threads
+	*	ever write to the same normal.	*/
+	void _updateNormals();
+
 protected:
 	size_t particles_count;
 	size_t springs_count;
@@ -168,21 +326,116 @@ protected:
 	float bounce_energy_loss_ratio;
 
 	shared_ptr<Shader> shader;
+	shared_ptr<Shader> surface_shader;
 	vector<ParticleVertex> vertices;
 
 	//Used for storing points.
 	unsigned int vboId;
 
+	//False when vboId and iboId belong to a ResourceManager.
+	bool owns_buffer;
+
+	//Element buffer holding eleIndex, surIndex, surfaceEleIndex and surfaceSurIndex back to back.
+	unsigned int iboId;
+	unsigned int lines_offset;
+	unsigned int triangles_offset;
+	unsigned int surface_lines_offset;
+	unsigned int surface_triangles_offset;
+
+	//Captures the vertex layout of vboId and the element buffer. Always owned by this system.
+	unsigned int vaoId;
+
+	//Handles of the items recorded by enqueue().
+	size_t points_item;
+	size_t lines_item;
+	size_t triangles_item;
+
 	//Used for glDrawElement(GL_LINES, ...), which is basically the springs' connection info.
 	vector<unsigned int> eleIndex;
 
 	//Used for glDrawElement(GL_TRIANGLES, ...)
 	vector<unsigned int> surIndex;
+
+	//Surface only rendering. surfaceParticles maps a compact surface vertex to its particle.
+	//The index arrays below refer to the compact numbering, not to the particles.
+	vector<unsigned int> surfaceParticles;
+	vector<ParticleVertex> surfaceVertices;
+	vector<unsigned int> surfaceEleIndex;
+	vector<unsigned int> surfaceSurIndex;
+
+	//Faces around the compact surface vertex v are vertexFaces[vertexFaceOffsets[v]] up to vertexFaces[vertexFaceOffsets[v + 1]].
+	vector<unsigned int> vertexFaceOffsets;
+	vector<unsigned int> vertexFaces;
+
+	//Unnormalized face normals, their length is twice the face area.
+	vector<Vector3f> faceNormals;
+
+	/*	+1 or -1 for a face of a cavity, whichever turns its normal out of the cavity, 0 for the other faces.
+	*	Cavity faces around cavityParticles[c] are cavityFaces[cavityFaceOffsets[c]] up to cavityFaces[cavityFaceOffsets[c + 1]].	*/
+	vector<float> faceCavitySigns;
+	vector<unsigned int> cavityParticles;
+	vector<unsigned int> cavityFaceOffsets;
+	vector<unsigned int> cavityFaces;
+	size_t cavity_count;
+	Real cavity_pressure;
+	double cavity_volume;
+
+	//Per spring scratch space of updateParticleSystem(): the unit direction from p0 to p1 and the current length.
+	vector< Vector3<Real> > spring_directions;
+	vector<Real> spring_lengths;
+
+	//The stiffness of setSpringsStiffness() and the mass of setParticlesMass(), the references the per element values are scaled with.
+	Real springs_stiffness;
+	Real particles_mass;
+
+	//Scale and offset of the rest lengths per region, see setActivation().
+	vector<Real> activation_scales;
+	vector<Real> activation_offsets;
+
+	//Share of the activation every region follows, see setRegionMaterials(). Empty while every region follows it fully.
+	vector<Real> region_contractilities;
+
+	//Damping factor of every particle, empty when all regions share damping_scale.
+	vector<float> particle_damping_scales;
+	float damping_scale;
+
+	//Activation delay of every spring in seconds. Empty while all springs follow the current activation.
+	vector<Real> spring_delays;
+
+	/*	The activations of the last history_length steps, one block of one entry per region per step,
+	*	the newest block at history_head. The delays in steps are valid for the time step history_step.	*/
+	vector<Real> scale_history;
+	vector<Real> offset_history;
+	vector<unsigned int> spring_delay_steps;
+	size_t history_length;
+	size_t history_head;
+	float history_step;
+
+	//Four particle indices per tetrahedron. Empty unless setTetrahedrons() was called.
+	vector<unsigned int> tetrahedrons;
+
+	/*	Signed rest volumes V0 and bulk moduli of the tetrahedra, and the weights 1 / (6 |V0|) of the volume
+	*	term, 0 for degenerate ones. The moduli are empty while volume preservation is off.	*/
+	vector<Real> tetrahedron_volumes;
+	vector<Real> tetrahedron_weights;
+	vector<Real> bulk_moduli;
+
+	/*	The tetrahedra of slice s are volumeSliceOffsets[s] up to volumeSliceOffsets[s + 1], one slice per thread.
+	*	They touch the particles volumeSliceParticles[2 * s] up to volumeSliceParticles[2 * s + 1]. The forces of
+	*	the slice start at volumeSliceForceOffsets[s] in slice_forces and are indexed by particle, only the touched
+	*	range is cleared and summed. Empty until the first step after setTetrahedrons().	*/
+	vector<unsigned int> volumeSliceOffsets;
+	vector<unsigned int> volumeSliceParticles;
+	vector<size_t> volumeSliceForceOffsets;
+
+	//Scratch space of _addVolumeForces(): the positions and the forces of every slice, x y z padded to four values.
+	vector<Real> packed_positions;
+	vector<Real> slice_forces;
 };
 
 
 template <class Real>
-ParticleSystem<Real>::ParticleSystem(size_t p_count, size_t s_count) : particles_count(p_count), springs_count(s_count) 
+ParticleSystem<Real>::ParticleSystem(size_t p_count, size_t s_count) : particles_count(p_count), springs_count(s_count), vboId(0), owns_buffer(false), iboId(0), lines_offset(0), triangles_offset(0), surface_lines_offset(0), surface_triangles_offset(0), vaoId(0)
 {
 	initParticleSystem();
 }
@@ -214,7 +467,21 @@ void ParticleSystem<Real>::initParticleSystem() {
 		this->springs[i].p1_position = Vector3f::Zero();
 		this->springs[i].d_r = Real(25);
 		this->springs[i].k = Real(20);
+		this->springs[i].region = 0;
+		this->springs[i].contraction = 1.0f;
 	}
+	this->springs_stiffness = Real(20);
+	this->particles_mass = Real(1);
+
+	this->activation_scales.assign(1, Real(1));
+	this->activation_offsets.assign(1, Real(0));
+	this->damping_scale = 1.0f;
+	this->cavity_count = 0;
+	this->cavity_pressure = Real(0);
+	this->cavity_volume = 0.0;
+	this->history_length = 0;
+	this->history_head = 0;
+	this->history_step = 0.0f;
 
 	this->rest_length_sum = 0.0;
 
@@ -228,6 +495,7 @@ void ParticleSystem<Real>::initParticleSystem() {
 	this->kd_max = 0.65f;
 
 	this->is_lines_shading = true;
+	this->is_surface_only = false;
 }
 
 
@@ -240,6 +508,7 @@ void ParticleSystem<Real>::setParticlesPositions(vector< Vector3<Real> > startin
 
 		vert.position = starting_positions[i];
 		vert.color = Color3f(1.0f, 0.5f, 0.5f);
+		vert.normal = Vector3f::Zero();
 		this->vertices.push_back(vert);
 	}
 }
@@ -247,8 +516,10 @@ void ParticleSystem<Real>::setParticlesPositions(vector< Vector3<Real> > startin
 
 template <class Real>
 void ParticleSystem<Real>::setParticlesMass(Real mass) {
+	Real factor = (this->particles_mass > Real(0)) ? mass / this->particles_mass : Real(0);
+	this->particles_mass = mass;
 	for (size_t i = 0; i < this->particles_count; i++) {
-		this->particles[i].mass = mass;
+		this->particles[i].mass = (factor > Real(0)) ? this->particles[i].mass * factor : mass;
 	}
 }
 
@@ -302,34 +573,128 @@ void ParticleSystem<Real>::setSpringsLength(Real length) {
 	for (size_t i = 0; i < this->springs_count; i++) {
 		this->springs[i].d_r = length;
 	}
+
+	this->rest_length_sum = static_cast<long double>(length) * this->springs_count;
 }
 
 
 template <class Real>
 void ParticleSystem<Real>::setSpringsStiffness(Real k) {
+	/* Relative to the current reference, so anisotropic and per region stiffness survives a new value. */
+	Real factor = (this->springs_stiffness > Real(0)) ? k / this->springs_stiffness : Real(0);
 	for (size_t i = 0; i < this->springs_count; i++) {
-		this->springs[i].k = k;
+		this->springs[i].k = (factor > Real(0)) ? this->springs[i].k * factor : k;
 	}
+	this->springs_stiffness = k;
 }
 
 
 template <class Real>
-void ParticleSystem<Real>::addSpringsRestLength(Real delta) {
-	for (size_t i = 0; i < this->springs_count; i++) {
-		this->springs[i].d_r += delta;
+bool ParticleSystem<Real>::setSpringsStiffnesses(const vector<Real> &k) {
+	if (k.size() != this->springs_count) {
+		cerr << "[ParticleSystem:setSpringsStiffnesses] Error: " << k.size() << " stiffnesses for " << this->springs_count << " springs." << endl;
+		return false;
 	}
+
+	for (size_t i = 0; i < this->springs_count; i++)
+		this->springs[i].k = k[i];
+	return true;
 }
 
 
 template <class Real>
-void ParticleSystem<Real>::addSpringsRestLengthHomogeneous(Real ratio) {
+bool ParticleSystem<Real>::setSpringsContractions(const vector<Real> &contractions) {
+	if (contractions.size() != this->springs_count) {
+		cerr << "[ParticleSystem:setSpringsContractions] Error: " << contractions.size() << " contractions for " << this->springs_count << " springs." << endl;
+		return false;
+	}
+
+	for (size_t i = 0; i < this->springs_count; i++)
+		this->springs[i].contraction = contractions[i];
+	return true;
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::setActivation(Real scale, Real offset) {
+	this->activation_scales.assign(this->activation_scales.size(), scale);
+	this->activation_offsets.assign(this->activation_offsets.size(), offset);
+
+	/* A region that follows a share c of the activation moves its rest lengths by c times the change. */
+	for (size_t r = 0; r < this->region_contractilities.size(); r++) {
+		this->activation_scales[r] = 1 + this->region_contractilities[r] * (scale - 1);
+		this->activation_offsets[r] = this->region_contractilities[r] * offset;
+	}
+}
+
+
+template <class Real>
+bool ParticleSystem<Real>::setSpringsRegions(const vector<unsigned int> &regions) {
+	if (regions.size() != this->springs_count) {
+		cerr << "[ParticleSystem:setSpringsRegions] Error: " << regions.size() << " regions for " << this->springs_count << " springs." << endl;
+		return false;
+	}
+
+	unsigned int region_count = 1;
 	for (size_t i = 0; i < this->springs_count; i++) {
-		if (ratio >= 0)
-			this->springs[i].d_r *= (1 + ratio);
-		else {
-			this->springs[i].d_r /= (1 - ratio);
-		}
+		this->springs[i].region = regions[i];
+		region_count = std::max(region_count, regions[i] + 1);
+	}
+
+	this->activation_scales.resize(region_count, this->activation_scales[0]);
+	this->activation_offsets.resize(region_count, this->activation_offsets[0]);
+
+	//The history has one entry per region, it is rebuilt at the next step.
+	this->history_step = 0.0f;
+	return true;
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::setRegionActivation(unsigned int region, Real scale, Real offset) {
+	if (region >= this->activation_scales.size()) {
+		cerr << "[ParticleSystem:setRegionActivation] Error: Region " << region << " of " << this->activation_scales.size() << "." << endl;
+		return;
 	}
+
+	this->activation_scales[region] = scale;
+	this->activation_offsets[region] = offset;
+}
+
+
+template <class Real>
+bool ParticleSystem<Real>::setSpringsDelays(const vector<Real> &delays) {
+	if (!delays.empty() && delays.size() != this->springs_count) {
+		cerr << "[ParticleSystem:setSpringsDelays] Error: " << delays.size() << " delays for " << this->springs_count << " springs." << endl;
+		return false;
+	}
+
+	this->spring_delays = delays;
+	this->history_step = 0.0f;
+	if (delays.empty()) {
+		this->scale_history.clear();
+		this->offset_history.clear();
+		this->spring_delay_steps.clear();
+	}
+	return true;
+}
+
+
+template <class Real>
+size_t ParticleSystem<Real>::getRegionCount() const {
+	return this->activation_scales.size();
+}
+
+
+template <class Real>
+Real ParticleSystem<Real>::getActivationScale(unsigned int region) const {
+	return this->activation_scales[region];
+}
+
+
+template <class Real>
+Real ParticleSystem<Real>::getActivationOffset(unsigned int region) const {
+	return this->activation_offsets[region];
 }
 
 
@@ -339,6 +704,163 @@ void ParticleSystem<Real>::setFaces(const vector<Vector3f> &tet_faces) {
 	memcpy(&this->faces[0], &tet_faces[0], sizeof(Vector3f) * tet_faces.size());
 
 	this->_converFacesToArray(this->faces);
+
+	/* TetGen writes the faces in no particular order. Reordering them once here saves vertex shading every frame. */
+	float acmr_before = VertexCacheOptimizer::ACMR(this->surIndex);
+	VertexCacheOptimizer::Optimize(this->surIndex, this->particles_count);
+	cout << "Surface triangles ACMR: " << acmr_before << " -> " << VertexCacheOptimizer::ACMR(this->surIndex) << endl;
+
+	this->_buildSurfaceSubset();
+	this->_buildVertexFaceAdjacency();
+	this->_buildCavities();
+	this->_updateNormals();
+	this->_updateCavityVolume();
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::setSurfaceOnly(bool surface_only) {
+	this->is_surface_only = surface_only && this->hasSurface();
+}
+
+
+template <class Real>
+bool ParticleSystem<Real>::hasSurface() const {
+	return !this->surfaceParticles.empty();
+}
+
+
+template <class Real>
+bool ParticleSystem<Real>::setTetrahedrons(const vector<unsigned int> &tetrahedrons) {
+	for (size_t i = 0; i < tetrahedrons.size(); i++) {
+		if (tetrahedrons[i] >= this->particles_count) {
+			cerr << "[ParticleSystem:setTetrahedrons] Error: Tetrahedron " << i / 4 << " refers to particle " << tetrahedrons[i] << " of " << this->particles_count << "." << endl;
+			return false;
+		}
+	}
+
+	size_t tet_count = tetrahedrons.size() / 4;
+	this->tetrahedrons.assign(tetrahedrons.begin(), tetrahedrons.begin() + 4 * tet_count);
+
+	this->tetrahedron_volumes.resize(tet_count);
+	this->tetrahedron_weights.resize(tet_count);
+	for (size_t t = 0; t < tet_count; t++) {
+		const Vector3<Real> &x0 = this->particles[this->tetrahedrons[4 * t]].position;
+		Vector3<Real> e1 = this->particles[this->tetrahedrons[4 * t + 1]].position - x0;
+		Vector3<Real> e2 = this->particles[this->tetrahedrons[4 * t + 2]].position - x0;
+		Vector3<Real> e3 = this->particles[this->tetrahedrons[4 * t + 3]].position - x0;
+		this->tetrahedron_volumes[t] = static_cast<Real>(Vector3<Real>::Dot(e1, Vector3<Real>::Cross(e2, e3)) / 6.0);
+
+		/* The magnitude, so an inverted tetrahedron (V0 < 0) is still pushed back to its rest volume. */
+		Real rest_volume = fabs(this->tetrahedron_volumes[t]);
+		this->tetrahedron_weights[t] = (rest_volume > Real(0)) ? Real(1) / (Real(6) * rest_volume) : Real(0);
+	}
+
+	this->volumeSliceOffsets.clear();
+	this->bulk_moduli.clear();
+	return true;
+}
+
+
+template <class Real>
+size_t ParticleSystem<Real>::getTetrahedronCount() const {
+	return this->tetrahedrons.size() / 4;
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::setBulkModulus(Real k) {
+	if (k > Real(0))
+		this->bulk_moduli.assign(this->getTetrahedronCount(), k);
+	else
+		this->bulk_moduli.clear();
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::setBulkModuli(const vector<Real> &k) {
+	if (k.size() != this->getTetrahedronCount()) {
+		cerr << "[ParticleSystem:setBulkModuli] Error: " << k.size() << " moduli for " << this->getTetrahedronCount() << " tetrahedra." << endl;
+		return;
+	}
+
+	this->bulk_moduli = k;
+}
+
+
+template <class Real>
+bool ParticleSystem<Real>::setRegionMaterials(const RegionMaterials &materials, const vector<unsigned int> &spring_regions,
+	const vector<unsigned int> &particle_regions, const vector<unsigned int> &tetrahedron_regions) {
+	if (particle_regions.size() != this->particles_count || (!tetrahedron_regions.empty() && tetrahedron_regions.size() != this->getTetrahedronCount())) {
+		cerr << "[ParticleSystem:setRegionMaterials] Error: " << particle_regions.size() << " particle regions for " << this->particles_count
+			<< " particles, " << tetrahedron_regions.size() << " tetrahedron regions for " << this->getTetrahedronCount() << " tetrahedra." << endl;
+		return false;
+	}
+	if (!this->setSpringsRegions(spring_regions))
+		return false;
+
+	for (size_t i = 0; i < this->springs_count; i++)
+		this->springs[i].k *= materials.getMaterial(this->springs[i].region).stiffness;
+
+	if (!this->bulk_moduli.empty()) {
+		for (size_t t = 0; t < tetrahedron_regions.size(); t++)
+			this->bulk_moduli[t] *= materials.getMaterial(tetrahedron_regions[t]).stiffness;
+	}
+
+	/* The damping factors are only kept per particle when the regions differ in damping. */
+	bool uniform_damping = true;
+	for (size_t i = 0; i < this->particles_count; i++) {
+		const RegionMaterial &material = materials.getMaterial(particle_regions[i]);
+		this->particles[i].mass *= material.mass;
+		uniform_damping = uniform_damping && material.damping == materials.getMaterial(particle_regions[0]).damping;
+	}
+
+	this->particle_damping_scales.clear();
+	if (uniform_damping)
+		this->damping_scale = (this->particles_count > 0) ? materials.getMaterial(particle_regions[0]).damping : 1.0f;
+	else {
+		this->particle_damping_scales.resize(this->particles_count);
+		for (size_t i = 0; i < this->particles_count; i++)
+			this->particle_damping_scales[i] = materials.getMaterial(particle_regions[i]).damping;
+	}
+
+	/* Contractility lives in the per region activation, so the spring kernel is the same as for one region. */
+	this->region_contractilities.clear();
+	for (size_t r = 0; r < this->activation_scales.size(); r++) {
+		if (materials.getMaterial(static_cast<unsigned int>(r)).contractility != 1.0f) {
+			this->region_contractilities.resize(this->activation_scales.size());
+			for (size_t q = 0; q < this->activation_scales.size(); q++)
+				this->region_contractilities[q] = materials.getMaterial(static_cast<unsigned int>(q)).contractility;
+			break;
+		}
+	}
+	this->setActivation(this->activation_scales[0], this->activation_offsets[0]);
+
+	return true;
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::setCavityPressure(Real pressure) {
+	this->cavity_pressure = pressure;
+}
+
+
+template <class Real>
+Real ParticleSystem<Real>::getCavityPressure() const {
+	return this->cavity_pressure;
+}
+
+
+template <class Real>
+size_t ParticleSystem<Real>::getCavityCount() const {
+	return this->cavity_count;
+}
+
+
+template <class Real>
+double ParticleSystem<Real>::getCavityVolume() const {
+	return this->cavity_volume;
 }
 
 
@@ -398,19 +920,20 @@ Vector3f ParticleSystem<Real>::getGravity() const {
 
 template <class Real>
 Real ParticleSystem<Real>::getMass() const {
-	return this->particles[0].mass;
+	return this->particles_mass;
 }
 
 
 template <class Real>
 Real ParticleSystem<Real>::getRestLength() const {
-	return this->springs[0].d_r;
+	const Spring<Real> &spring = this->springs[0];
+	return spring.d_r + spring.contraction * (spring.d_r * (this->activation_scales[spring.region] - 1) + this->activation_offsets[spring.region]);
 }
 
 
 template <class Real>
 Real ParticleSystem<Real>::getSpringsStiffness() const {
-	return this->springs[0].k;
+	return this->springs_stiffness;
 }
 
 
@@ -445,17 +968,17 @@ bool ParticleSystem<Real>::getLoadMeshBoolVariable() {
 
 
 template <class Real>
-void ParticleSystem<Real>::handleLinearDamping(Vector3<Real> &velocity) {
-	Vector3<Real> v = velocity;
+void ParticleSystem<Real>::handleLinearDamping(Vector3<Real> &velocity, float scale) {
 	float kd = this->damping_b;
-	Real speed = Vector3<Real>::Norm(v);
+	Real speed = Vector3<Real>::FastNorm(velocity);
 	if (speed > this->v_thresh_for_a)
 		kd += this->damping_a * speed;
+	kd *= scale;
 
 	if (kd > this->kd_max)
 		kd = this->kd_max;
 
-	velocity -= v * kd;
+	velocity -= Lazy(velocity) * kd;
 }
 
 
@@ -464,38 +987,61 @@ void ParticleSystem<Real>::updateParticleSystem(float dt) {
 	for (size_t i = 0; i < this->particles_count; i++) 
 		this->particles[i].force = Real(0);
 
+	/* The spring vectors are gathered first, so their lengths and directions are computed as one batch. */
+	this->spring_directions.resize(this->springs_count);
+	this->spring_lengths.resize(this->springs_count);
+	for (size_t i = 0; i < this->springs_count; i++)
+		this->spring_directions[i] = Lazy(this->particles[this->springs[i].p1].position) - this->particles[this->springs[i].p0].position;
+
+	if (this->springs_count > 0)
+		VectorBatch::Normalize(&this->spring_directions[0], this->springs_count, &this->spring_lengths[0]);
+
+	/* With delays the activation is looked up in the history, block (head - delay) of the ring. */
+	bool delayed = !this->spring_delays.empty();
+	if (delayed)
+		this->_recordActivation(dt);
+	const Real *scales = delayed ? &this->scale_history[0] : &this->activation_scales[0];
+	const Real *offsets = delayed ? &this->offset_history[0] : &this->activation_offsets[0];
+	size_t region_count = this->activation_scales.size();
+	size_t history_mask = this->history_length - 1;
+
 	for (size_t i = 0; i < this->springs_count; i++) {
 		//The indices of the current two particles that connect this spring.
 		size_t			p0_index	= this->springs[i].p0;
 		size_t			p1_index	= this->springs[i].p1;
-		Vector3<Real>	p0_pos		= this->particles[p0_index].position;
-		Vector3<Real>	p1_pos		= this->particles[p1_index].position;
-		float			dr			= this->springs[i].d_r;
-		float			k			= this->springs[i].k;
-
-		//vec0 points to the second paricle, which is p1. vec1 points to p0.
-		Vector3f vec0 = Vector3<float>::Normalize(p1_pos - p0_pos);
-		Vector3f vec1 = Vector3<float>::Normalize(p0_pos - p1_pos);
+		size_t			slot		= this->springs[i].region;
+		if (delayed)
+			slot += ((this->history_head - this->spring_delay_steps[i]) & history_mask) * region_count;
+		Real			d_r			= this->springs[i].d_r;
+		Real			dr			= d_r + this->springs[i].contraction * (d_r * (scales[slot] - 1) + offsets[slot]);
+		Real			k			= this->springs[i].k;
 
 		//Current distance between these two particles.
-		float dc = Vector3<float>::Norm(p1_pos - p0_pos);
+		Real dc = this->spring_lengths[i];
 
-		//Calculate the forces influencing these particles.
-		this->particles[p0_index].force += k * (dc - dr) * vec0;
-		this->particles[p1_index].force += k * (dc - dr) * vec1;
+		//The direction points to the second paricle, which is p1. The opposite force acts on p1.
+		Vector3<Real> force = Lazy(this->spring_directions[i]) * (k * (dc - dr));
+		this->particles[p0_index].force += force;
+		this->particles[p1_index].force -= force;
 	}
 
+	if (!this->bulk_moduli.empty())
+		this->_addVolumeForces();
+
+	if (this->cavity_pressure != Real(0))
+		this->_addPressureForces();
+
+	const float *damping_scales = this->particle_damping_scales.empty() ? nullptr : &this->particle_damping_scales[0];
 	for (size_t i = 0; i < this->particles_count; i++) {
 		this->particles[i].force += this->gravity;
 
-		//The accelaration of the particle.
-		Vector3f a = (this->particles[i].force) / (this->particles[i].mass);
-		this->particles[i].velocity += a * dt;
-		this->handleLinearDamping(this->particles[i].velocity);
+		//The accelaration of the particle, a = F / m, integrated without temporaries.
+		this->particles[i].velocity += Lazy(this->particles[i].force) / this->particles[i].mass * dt;
+		this->handleLinearDamping(this->particles[i].velocity, damping_scales ? damping_scales[i] : this->damping_scale);
 		this->collisionHandleSimple(Real(0), this->particles[i].position, this->particles[i].velocity);
 
 		//The updated new positoins of the particles.
-		this->particles[i].position += this->particles[i].velocity * dt;
+		this->particles[i].position += Lazy(this->particles[i].velocity) * dt;
 		this->vertices[i].position = this->particles[i].position;
 	}
 
@@ -507,7 +1053,23 @@ void ParticleSystem<Real>::updateParticleSystem(float dt) {
 		this->springs[i].p1_position = this->particles[p_index1].position;
 	}
 
-	glBufferSubData(GL_ARRAY_BUFFER, 0, this->vertices.size() * sizeof(ParticleVertex), &this->vertices[0]);
+	this->_updateNormals();
+	this->_updateCavityVolume();
+	this->uploadVertices();
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::followEmbedding(EmbeddedMesh &embedding, const ParticleSystem<Real> &driver) {
+	embedding.interpolate(driver.particles, this->particles);
+
+	int count = static_cast<int>(this->particles_count);
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < count; i++)
+		this->vertices[i].position = this->particles[i].position;
+
+	this->_updateNormals();
+	this->uploadVertices();
 }
 
 
@@ -572,6 +1134,458 @@ inline void ParticleSystem<Real>::_converFacesToArray(const vector<Vector3f> &or
 }
 
 
+template <class Real>
+void ParticleSystem<Real>::_buildSurfaceSubset() {
+	const unsigned int NOT_ON_SURFACE = static_cast<unsigned int>(-1);
+	vector<unsigned int> compact(this->particles_count, NOT_ON_SURFACE);
+
+	this->surfaceParticles.clear();
+	this->surfaceSurIndex.resize(this->surIndex.size());
+
+	for (size_t i = 0; i < this->surIndex.size(); i++) {
+		unsigned int p = this->surIndex[i];
+		if (compact[p] == NOT_ON_SURFACE) {
+			compact[p] = static_cast<unsigned int>(this->surfaceParticles.size());
+			this->surfaceParticles.push_back(p);
+		}
+
+		this->surfaceSurIndex[i] = compact[p];
+	}
+
+	/* Every triangle edge once, stored as (low, high) pairs packed in one key for sorting. */
+	vector<unsigned long long> edges;
+	edges.reserve(this->surfaceSurIndex.size());
+	for (size_t i = 0; i + 2 < this->surfaceSurIndex.size(); i += 3) {
+		for (size_t e = 0; e < 3; e++) {
+			unsigned long long a = this->surfaceSurIndex[i + e];
+			unsigned long long b = this->surfaceSurIndex[i + (e + 1) % 3];
+			edges.push_back(a < b ? (a << 32) | b : (b << 32) | a);
+		}
+	}
+
+	sort(edges.begin(), edges.end());
+	edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+	this->surfaceEleIndex.resize(edges.size() * 2);
+	for (size_t i = 0; i < edges.size(); i++) {
+		this->surfaceEleIndex[2 * i] = static_cast<unsigned int>(edges[i] >> 32);
+		this->surfaceEleIndex[2 * i + 1] = static_cast<unsigned int>(edges[i] & 0xFFFFFFFFULL);
+	}
+
+	this->surfaceVertices.resize(this->surfaceParticles.size());
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_buildVertexFaceAdjacency() {
+	size_t vertex_count = this->surfaceParticles.size();
+	size_t face_count = this->surfaceSurIndex.size() / 3;
+
+	/* Count the faces of every vertex, turn the counts into offsets, then fill in the face ids. */
+	this->vertexFaceOffsets.assign(vertex_count + 1, 0);
+	for (size_t i = 0; i < face_count * 3; i++)
+		this->vertexFaceOffsets[this->surfaceSurIndex[i] + 1]++;
+
+	for (size_t v = 0; v < vertex_count; v++)
+		this->vertexFaceOffsets[v + 1] += this->vertexFaceOffsets[v];
+
+	vector<unsigned int> cursor(this->vertexFaceOffsets.begin(), this->vertexFaceOffsets.end() - 1);
+	this->vertexFaces.resize(face_count * 3);
+	for (size_t f = 0; f < face_count; f++) {
+		for (size_t c = 0; c < 3; c++)
+			this->vertexFaces[cursor[this->surfaceSurIndex[3 * f + c]]++] = static_cast<unsigned int>(f);
+	}
+
+	this->faceNormals.resize(face_count);
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_buildCavities() {
+	size_t vertex_count = this->surfaceParticles.size();
+	size_t face_count = this->surfaceSurIndex.size() / 3;
+
+	/* The surface components, by joining the corners of every face. */
+	vector<unsigned int> component(vertex_count);
+	for (size_t v = 0; v < vertex_count; v++)
+		component[v] = static_cast<unsigned int>(v);
+
+	auto root = [&component](unsigned int v) {
+		while (component[v] != v)
+			v = component[v] = component[component[v]];
+		return v;
+	};
+
+	for (size_t f = 0; f < face_count; f++) {
+		unsigned int a = root(this->surfaceSurIndex[3 * f]);
+		for (size_t c = 1; c < 3; c++) {
+			unsigned int b = root(this->surfaceSurIndex[3 * f + c]);
+			component[max(a, b)] = min(a, b);
+			a = min(a, b);
+		}
+	}
+
+	/* Bounds and signed volume of every component. The volume is positive when its normals point out of it. */
+	vector<unsigned int> roots;
+	vector<Vector3f> lowers, uppers;
+	vector<double> volumes;
+	vector<unsigned int> face_components(face_count);
+	vector<unsigned int> root_ids(vertex_count, static_cast<unsigned int>(-1));
+	for (size_t f = 0; f < face_count; f++) {
+		unsigned int r = root(this->surfaceSurIndex[3 * f]);
+		if (root_ids[r] == static_cast<unsigned int>(-1)) {
+			root_ids[r] = static_cast<unsigned int>(roots.size());
+			roots.push_back(r);
+			lowers.push_back(this->particles[this->surfaceParticles[r]].position);
+			uppers.push_back(this->particles[this->surfaceParticles[r]].position);
+			volumes.push_back(0.0);
+		}
+
+		unsigned int id = root_ids[r];
+		face_components[f] = id;
+		const Vector3<Real> &a = this->particles[this->surIndex[3 * f]].position;
+		const Vector3<Real> &b = this->particles[this->surIndex[3 * f + 1]].position;
+		const Vector3<Real> &c = this->particles[this->surIndex[3 * f + 2]].position;
+		volumes[id] += Vector3<Real>::Dot(a, Vector3<Real>::Cross(b, c)) / 6.0;
+
+		for (size_t k = 0; k < 3; k++) {
+			const Vector3<Real> &corner = this->particles[this->surIndex[3 * f + k]].position;
+			for (int d = 0; d < 3; d++) {
+				lowers[id][d] = min(lowers[id][d], corner[d]);
+				uppers[id][d] = max(uppers[id][d], corner[d]);
+			}
+		}
+	}
+
+	/*	A component is a cavity when another one encloses its bounds. TetGen orients the faces of a surface
+	*	consistently, so one sign per component turns all of them out of the cavity.	*/
+	vector<float> component_signs(roots.size(), 0.0f);
+	this->cavity_count = 0;
+	for (size_t i = 0; i < roots.size(); i++) {
+		for (size_t j = 0; j < roots.size(); j++) {
+			bool inside = (i != j);
+			for (int d = 0; d < 3 && inside; d++)
+				inside = lowers[j][d] < lowers[i][d] && uppers[i][d] < uppers[j][d];
+
+			if (inside) {
+				component_signs[i] = (volumes[i] >= 0.0) ? 1.0f : -1.0f;
+				this->cavity_count++;
+				break;
+			}
+		}
+	}
+
+	this->faceCavitySigns.resize(face_count);
+	for (size_t f = 0; f < face_count; f++)
+		this->faceCavitySigns[f] = component_signs[face_components[f]];
+
+	/* The cavity faces of every vertex on a cavity, picked from its vertex faces. */
+	this->cavityParticles.clear();
+	this->cavityFaceOffsets.assign(1, 0);
+	this->cavityFaces.clear();
+	if (this->cavity_count == 0)
+		return;
+
+	for (size_t v = 0; v < vertex_count; v++) {
+		size_t first = this->cavityFaces.size();
+		for (unsigned int i = this->vertexFaceOffsets[v]; i < this->vertexFaceOffsets[v + 1]; i++)
+			if (this->faceCavitySigns[this->vertexFaces[i]] != 0.0f)
+				this->cavityFaces.push_back(this->vertexFaces[i]);
+
+		if (this->cavityFaces.size() > first) {
+			this->cavityParticles.push_back(this->surfaceParticles[v]);
+			this->cavityFaceOffsets.push_back(static_cast<unsigned int>(this->cavityFaces.size()));
+		}
+	}
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_addPressureForces() {
+	int count = static_cast<int>(this->cavityParticles.size());
+
+	/* The face normal is twice the area, so a third of the area times the pressure is a sixth of it. */
+	Real scale = this->cavity_pressure / Real(6);
+
+	#pragma omp parallel for schedule(static)
+	for (int c = 0; c < count; c++) {
+		Vector3f force = Vector3f::Zero();
+		for (unsigned int i = this->cavityFaceOffsets[c]; i < this->cavityFaceOffsets[c + 1]; i++) {
+			unsigned int f = this->cavityFaces[i];
+			force += Lazy(this->faceNormals[f]) * this->faceCavitySigns[f];
+		}
+
+		this->particles[this->cavityParticles[c]].force += Lazy(force) * scale;
+	}
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_updateCavityVolume() {
+	int face_count = static_cast<int>(this->faceNormals.size());
+	bool whole_surface = (this->cavity_count == 0);
+
+	/* V = 1/3 sum of x . n dA over the faces, with x . n dA = a . (b - a) x (c - a) / 2 = a . N / 2. */
+	double volume = 0.0;
+	#pragma omp parallel for schedule(static) reduction(+:volume)
+	for (int f = 0; f < face_count; f++) {
+		float sign = whole_surface ? 1.0f : this->faceCavitySigns[f];
+		if (sign != 0.0f)
+			volume += sign * Vector3<Real>::Dot(this->particles[this->surIndex[3 * f]].position, this->faceNormals[f]);
+	}
+
+	//The whole surface is not oriented by _buildCavities(), its sign depends on the mesh.
+	this->cavity_volume = fabs(volume) / 6.0;
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_recordActivation(float dt) {
+	size_t region_count = this->activation_scales.size();
+
+	if (dt != this->history_step) {
+		/* The ring is a power of two long, so the kernel wraps with a mask. */
+		unsigned int longest = 0;
+		this->spring_delay_steps.resize(this->springs_count);
+		for (size_t i = 0; i < this->springs_count; i++) {
+			Real steps = (dt > 0.0f) ? this->spring_delays[i] / dt : Real(0);
+			this->spring_delay_steps[i] = (steps > Real(0)) ? static_cast<unsigned int>(steps + Real(0.5)) : 0;
+			longest = std::max(longest, this->spring_delay_steps[i]);
+		}
+
+		this->history_length = 1;
+		while (this->history_length <= longest)
+			this->history_length *= 2;
+
+		this->scale_history.resize(this->history_length * region_count);
+		this->offset_history.resize(this->history_length * region_count);
+		for (size_t h = 0; h < this->history_length; h++) {
+			std::copy(this->activation_scales.begin(), this->activation_scales.end(), this->scale_history.begin() + h * region_count);
+			std::copy(this->activation_offsets.begin(), this->activation_offsets.end(), this->offset_history.begin() + h * region_count);
+		}
+		this->history_head = 0;
+		this->history_step = dt;
+		return;
+	}
+
+	this->history_head = (this->history_head + 1) & (this->history_length - 1);
+	std::copy(this->activation_scales.begin(), this->activation_scales.end(), this->scale_history.begin() + this->history_head * region_count);
+	std::copy(this->activation_offsets.begin(), this->activation_offsets.end(), this->offset_history.begin() + this->history_head * region_count);
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_addVolumeForces() {
+	size_t tet_count = this->getTetrahedronCount();
+	int count = static_cast<int>(this->particles_count);
+	if (tet_count == 0)
+		return;
+
+	/* One slice per thread of this step, so a changed OpenMP thread count is picked up. */
+#ifdef _OPENMP
+	size_t threads = static_cast<size_t>(omp_get_max_threads());
+#else
+	size_t threads = 1;
+#endif
+	size_t wanted = max<size_t>(1, min<size_t>(threads, tet_count));
+	if (this->volumeSliceOffsets.size() != wanted + 1)
+		this->_buildVolumeSlices(wanted);
+
+	int slice_count = static_cast<int>(wanted);
+	this->packed_positions.resize(4 * count);
+	Real *x = &this->packed_positions[0];
+	Real *forces = &this->slice_forces[0];
+	const unsigned int *slices = &this->volumeSliceOffsets[0];
+	const unsigned int *ranges = &this->volumeSliceParticles[0];
+	const size_t *offsets = &this->volumeSliceForceOffsets[0];
+
+	#pragma omp parallel for schedule(static)
+	for (int p = 0; p < count; p++) {
+		x[4 * p] = this->particles[p].position.x();
+		x[4 * p + 1] = this->particles[p].position.y();
+		x[4 * p + 2] = this->particles[p].position.z();
+		x[4 * p + 3] = Real(0);
+	}
+
+	//Every slice clears and fills only its own particle range.
+	#pragma omp parallel for schedule(static)
+	for (int s = 0; s < slice_count; s++) {
+		Real *f = forces + offsets[s];
+		std::fill(f + 4 * ranges[2 * s], f + 4 * ranges[2 * s + 1], Real(0));
+		this->_addVolumeSliceForces(slices[s], slices[s + 1], f, Real());
+	}
+
+	//Every particle sums its entries of the slice buffers that cover it, so no two threads write to the same particle.
+	#pragma omp parallel for schedule(static)
+	for (int p = 0; p < count; p++) {
+		Vector3<Real> force = Vector3<Real>::Zero();
+		for (int s = 0; s < slice_count; s++) {
+			if (static_cast<unsigned int>(p) < ranges[2 * s] || static_cast<unsigned int>(p) >= ranges[2 * s + 1])
+				continue;
+
+			const Real *f = forces + offsets[s] + 4 * p;
+			force += Vector3<Real>(f[0], f[1], f[2]);
+		}
+
+		this->particles[p].force += force;
+	}
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_buildVolumeSlices(size_t slice_count) {
+	size_t tet_count = this->getTetrahedronCount();
+
+	/* Contiguous slices keep the order of the mesh, whose neighbouring tetrahedra share nodes. */
+	this->volumeSliceOffsets.resize(slice_count + 1);
+	for (size_t s = 0; s <= slice_count; s++)
+		this->volumeSliceOffsets[s] = static_cast<unsigned int>(tet_count * s / slice_count);
+
+	this->volumeSliceParticles.resize(2 * slice_count);
+	this->volumeSliceForceOffsets.resize(slice_count + 1);
+	this->volumeSliceForceOffsets[0] = 0;
+	for (size_t s = 0; s < slice_count; s++) {
+		unsigned int first = static_cast<unsigned int>(this->particles_count);
+		unsigned int last = 0;
+		for (size_t i = 4 * this->volumeSliceOffsets[s]; i < 4 * this->volumeSliceOffsets[s + 1]; i++) {
+			first = min(first, this->tetrahedrons[i]);
+			last = max(last, this->tetrahedrons[i] + 1);
+		}
+
+		if (first > last)
+			first = last;
+		this->volumeSliceParticles[2 * s] = first;
+		this->volumeSliceParticles[2 * s + 1] = last;
+		this->volumeSliceForceOffsets[s + 1] = this->volumeSliceForceOffsets[s] + 4 * static_cast<size_t>(last);
+	}
+
+	this->slice_forces.resize(max<size_t>(1, this->volumeSliceForceOffsets[slice_count]));
+}
+
+
+/*	6 dV/dx1 = e2 x e3, 6 dV/dx2 = e3 x e1, 6 dV/dx3 = e1 x e2 and 6 V = e1 . (e2 x e3). The force on a node is
+*	-k (V - V0) / |V0| times its volume gradient, with the 1 / 6 of the gradients in the weight 1 / (6 |V0|).	*/
+template <class Real>
+void ParticleSystem<Real>::_addTetrahedronForces(unsigned int begin, unsigned int end, Real *forces) const {
+	const Real *x = &this->packed_positions[0];
+	const unsigned int *tetrahedrons = &this->tetrahedrons[0];
+	const Real *v0 = &this->tetrahedron_volumes[0];
+	const Real *w = &this->tetrahedron_weights[0];
+	const Real *k = &this->bulk_moduli[0];
+
+	for (unsigned int t = begin; t < end; t++) {
+		const unsigned int *n = &tetrahedrons[4 * t];
+		const Real *x0 = x + 4 * n[0], *x1 = x + 4 * n[1], *x2 = x + 4 * n[2], *x3 = x + 4 * n[3];
+		Real e1x = x1[0] - x0[0], e1y = x1[1] - x0[1], e1z = x1[2] - x0[2];
+		Real e2x = x2[0] - x0[0], e2y = x2[1] - x0[1], e2z = x2[2] - x0[2];
+		Real e3x = x3[0] - x0[0], e3y = x3[1] - x0[1], e3z = x3[2] - x0[2];
+
+		Real g1x = e2y * e3z - e2z * e3y, g1y = e2z * e3x - e2x * e3z, g1z = e2x * e3y - e2y * e3x;
+		Real g2x = e3y * e1z - e3z * e1y, g2y = e3z * e1x - e3x * e1z, g2z = e3x * e1y - e3y * e1x;
+		Real g3x = e1y * e2z - e1z * e2y, g3y = e1z * e2x - e1x * e2z, g3z = e1x * e2y - e1y * e2x;
+
+		Real volume = (e1x * g1x + e1y * g1y + e1z * g1z) / Real(6);
+		Real c = -k[t] * w[t] * (volume - v0[t]);
+
+		Real *f0 = forces + 4 * n[0], *f1 = forces + 4 * n[1], *f2 = forces + 4 * n[2], *f3 = forces + 4 * n[3];
+		f1[0] += c * g1x; f1[1] += c * g1y; f1[2] += c * g1z;
+		f2[0] += c * g2x; f2[1] += c * g2y; f2[2] += c * g2z;
+		f3[0] += c * g3x; f3[1] += c * g3y; f3[2] += c * g3z;
+		f0[0] -= c * (g1x + g2x + g3x); f0[1] -= c * (g1y + g2y + g3y); f0[2] -= c * (g1z + g2z + g3z);
+	}
+}
+
+
+template <class Real>
+template <class T>
+void ParticleSystem<Real>::_addVolumeSliceForces(unsigned int begin, unsigned int end, Real *forces, T) const {
+	this->_addTetrahedronForces(begin, end, forces);
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_addVolumeSliceForces(unsigned int begin, unsigned int end, float *forces, float) const {
+	//Same widths as MatrixBatch: eight lanes where the CPU has AVX, four with SSE, the rest one by one.
+	unsigned int t = begin;
+#if defined(VECTOR_BATCH_AVX)
+	if (VectorBatch::HasAVX()) {
+		t += this->template _addTetrahedronForceBlocks<FloatLanes8>(t, end, forces);
+		_mm256_zeroupper();
+	}
+#endif
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+	t += this->template _addTetrahedronForceBlocks<FloatLanes4>(t, end, forces);
+#endif
+	this->_addTetrahedronForces(t, end, forces);
+}
+
+
+template <class Real>
+template <class Lanes>
+unsigned int ParticleSystem<Real>::_addTetrahedronForceBlocks(unsigned int begin, unsigned int end, float *forces) const {
+	const unsigned int W = static_cast<unsigned int>(Lanes::WIDTH);
+	const float *x = &this->packed_positions[0];
+
+	unsigned int t = begin;
+	for ( ; t + W <= end; t += W) {
+		//Corner c of the W tetrahedra is every fourth index from n + c on.
+		const unsigned int *n = &this->tetrahedrons[4 * t];
+
+		Lanes x0x, x0y, x0z, e1x, e1y, e1z, e2x, e2y, e2z, e3x, e3y, e3z;
+		Lanes::Gather3(x, n, 4, x0x, x0y, x0z);
+		Lanes::Gather3(x, n + 1, 4, e1x, e1y, e1z);
+		Lanes::Gather3(x, n + 2, 4, e2x, e2y, e2z);
+		Lanes::Gather3(x, n + 3, 4, e3x, e3y, e3z);
+		e1x = e1x - x0x; e1y = e1y - x0y; e1z = e1z - x0z;
+		e2x = e2x - x0x; e2y = e2y - x0y; e2z = e2z - x0z;
+		e3x = e3x - x0x; e3y = e3y - x0y; e3z = e3z - x0z;
+
+		Lanes g1x = e2y * e3z - e2z * e3y, g1y = e2z * e3x - e2x * e3z, g1z = e2x * e3y - e2y * e3x;
+		Lanes g2x = e3y * e1z - e3z * e1y, g2y = e3z * e1x - e3x * e1z, g2z = e3x * e1y - e3y * e1x;
+		Lanes g3x = e1y * e2z - e1z * e2y, g3y = e1z * e2x - e1x * e2z, g3z = e1x * e2y - e1y * e2x;
+
+		Lanes volume = (e1x * g1x + e1y * g1y + e1z * g1z) * Lanes(1.0f / 6.0f);
+		Lanes c = -(Lanes::Load(&this->bulk_moduli[t]) * Lanes::Load(&this->tetrahedron_weights[t])) * (volume - Lanes::Load(&this->tetrahedron_volumes[t]));
+
+		Lanes f1x = c * g1x, f1y = c * g1y, f1z = c * g1z;
+		Lanes f2x = c * g2x, f2y = c * g2y, f2z = c * g2z;
+		Lanes f3x = c * g3x, f3y = c * g3y, f3z = c * g3z;
+		Lanes::ScatterAdd3(forces, n + 1, 4, f1x, f1y, f1z);
+		Lanes::ScatterAdd3(forces, n + 2, 4, f2x, f2y, f2z);
+		Lanes::ScatterAdd3(forces, n + 3, 4, f3x, f3y, f3z);
+		Lanes::ScatterAdd3(forces, n, 4, -(f1x + f2x + f3x), -(f1y + f2y + f3y), -(f1z + f2z + f3z));
+	}
+
+	return t - begin;
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_updateNormals() {
+	int face_count = static_cast<int>(this->faceNormals.size());
+	int vertex_count = static_cast<int>(this->surfaceParticles.size());
+
+	#pragma omp parallel for schedule(static)
+	for (int f = 0; f < face_count; f++) {
+		const Vector3<Real> &a = this->particles[this->surIndex[3 * f]].position;
+		const Vector3<Real> &b = this->particles[this->surIndex[3 * f + 1]].position;
+		const Vector3<Real> &c = this->particles[this->surIndex[3 * f + 2]].position;
+
+		//Not normalized, so larger faces weigh more in the vertex normal.
+		this->faceNormals[f] = Vector3f::Cross(b - a, c - a);
+	}
+
+	#pragma omp parallel for schedule(static)
+	for (int v = 0; v < vertex_count; v++) {
+		Vector3f normal = Vector3f::Zero();
+		for (unsigned int i = this->vertexFaceOffsets[v]; i < this->vertexFaceOffsets[v + 1]; i++)
+			normal += this->faceNormals[this->vertexFaces[i]];
+
+		this->vertices[this->surfaceParticles[v]].normal = Vector3f::FastNormalize(normal);
+	}
+}
+
+
 template <class Real>
 void ParticleSystem<Real>::loadShader(const string& vertexShader, const string& fragmentShader) {
 	this->shader = make_shared<Shader>();
@@ -581,6 +1595,19 @@ void ParticleSystem<Real>::loadShader(const string& vertexShader, const string&
 	this->shader->link();
 	glBindAttribLocation(this->shader->getProgramID(), POSITION_LOC, "position");
 	glBindAttribLocation(this->shader->getProgramID(), COLOR_LOC, "color");
+	glBindAttribLocation(this->shader->getProgramID(), NORMAL_LOC, "normal");
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::setShader(const shared_ptr<Shader>& shader) {
+	this->shader = shader;
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::setSurfaceShader(const shared_ptr<Shader>& shader) {
+	this->surface_shader = shader;
 }
 
 
@@ -589,51 +1616,209 @@ void ParticleSystem<Real>::constructOnGPU() {
 	glGenBuffers(1, &this->vboId);
 	glBindBuffer(GL_ARRAY_BUFFER, this->vboId);
 	glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * sizeof(ParticleVertex), &this->vertices[0], GL_DYNAMIC_DRAW);
+	this->owns_buffer = true;
+
+	this->_constructVertexArray(NULL, string());
 }
 
 
 template <class Real>
-void ParticleSystem<Real>::beginRender() {
-	if (this->shader != nullptr)
-		this->shader->enable();
+void ParticleSystem<Real>::constructOnGPU(ResourceManager& resources, const string& buffer_name) {
+	this->vboId = resources.requestBuffer(buffer_name, this->vertices.size() * sizeof(ParticleVertex), &this->vertices[0]);
+	this->owns_buffer = false;
+
+	this->_constructVertexArray(&resources, buffer_name);
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::_constructVertexArray(ResourceManager* resources, const string& buffer_name) {
+	/* Both index sets are uploaded, switching to surface only mode then only changes the ranges that are drawn. */
+	vector<unsigned int> indices;
+	indices.reserve(this->eleIndex.size() + this->surIndex.size() + this->surfaceEleIndex.size() + this->surfaceSurIndex.size());
+
+	this->lines_offset = static_cast<unsigned int>(indices.size());
+	indices.insert(indices.end(), this->eleIndex.begin(), this->eleIndex.end());
+	this->triangles_offset = static_cast<unsigned int>(indices.size());
+	indices.insert(indices.end(), this->surIndex.begin(), this->surIndex.end());
+	this->surface_lines_offset = static_cast<unsigned int>(indices.size());
+	indices.insert(indices.end(), this->surfaceEleIndex.begin(), this->surfaceEleIndex.end());
+	this->surface_triangles_offset = static_cast<unsigned int>(indices.size());
+	indices.insert(indices.end(), this->surfaceSurIndex.begin(), this->surfaceSurIndex.end());
+
+	const void* data = indices.empty() ? NULL : &indices[0];
+	size_t bytes = indices.size() * sizeof(unsigned int);
+
+	if (resources != NULL) {
+		this->iboId = resources->requestBuffer(buffer_name + "Indices", bytes, data, GL_STATIC_DRAW);
+	}
+	else {
+		glGenBuffers(1, &this->iboId);
+		glBindBuffer(GL_ARRAY_BUFFER, this->iboId);
+		glBufferData(GL_ARRAY_BUFFER, bytes, data, GL_STATIC_DRAW);
+	}
+
+	if (this->vaoId == 0)
+		glGenVertexArrays(1, &this->vaoId);
 
-	//Drawing the points' buffer.
+	glBindVertexArray(this->vaoId);
 	glBindBuffer(GL_ARRAY_BUFFER, this->vboId);
 	glEnableVertexAttribArray(POSITION_LOC);
 	glVertexAttribPointer(POSITION_LOC, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), BUFFER_OFFSET(0));
 	glEnableVertexAttribArray(COLOR_LOC);
 	glVertexAttribPointer(COLOR_LOC, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), BUFFER_OFFSET(3 * sizeof(float)));
+	glEnableVertexAttribArray(NORMAL_LOC);
+	glVertexAttribPointer(NORMAL_LOC, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), BUFFER_OFFSET(6 * sizeof(float)));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->iboId);
+	glBindVertexArray(0);
+}
 
-	vector<unsigned int> p_index;
-	for (size_t i = 0; i < this->particles_count; i++) {
-		p_index.push_back(static_cast<unsigned int>(i));
+
+template <class Real>
+void ParticleSystem<Real>::enqueue(RenderQueue& queue) {
+	this->points_item = queue.add(this->shader, this->vaoId, GL_POINTS, 0, 0, false);
+	this->lines_item = queue.add(this->shader, this->vaoId, GL_LINES, 0, 0);
+
+	//Without a lit program the triangles are drawn with the main one.
+	const shared_ptr<Shader> &triangles_shader = (this->surface_shader != nullptr) ? this->surface_shader : this->shader;
+	this->triangles_item = queue.add(triangles_shader, this->vaoId, GL_TRIANGLES, 0, 0);
+
+	this->updateQueue(queue);
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::updateQueue(RenderQueue& queue) const {
+	if (this->is_surface_only) {
+		queue.setRange(this->points_item, 0, static_cast<unsigned int>(this->surfaceParticles.size()));
+		queue.setRange(this->lines_item, this->surface_lines_offset, static_cast<unsigned int>(this->surfaceEleIndex.size()));
+		queue.setRange(this->triangles_item, this->surface_triangles_offset, static_cast<unsigned int>(this->surfaceSurIndex.size()));
+	}
+	else {
+		queue.setRange(this->points_item, 0, static_cast<unsigned int>(this->particles_count));
+		queue.setRange(this->lines_item, this->lines_offset, static_cast<unsigned int>(this->eleIndex.size()));
+		queue.setRange(this->triangles_item, this->triangles_offset, static_cast<unsigned int>(this->surIndex.size()));
 	}
 
+	queue.setEnabled(this->lines_item, this->is_lines_shading);
+	queue.setEnabled(this->triangles_item, !this->is_lines_shading);
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::beginRender() {
+	if (this->shader != nullptr)
+		this->shader->enable();
+
+	glBindVertexArray(this->vaoId);
+
+	/* In surface only mode the buffer holds the compact surface vertices, so the compact index ranges are used. */
+	size_t lines_count = this->is_surface_only ? this->surfaceEleIndex.size() : this->eleIndex.size();
+	size_t triangles_count = this->is_surface_only ? this->surfaceSurIndex.size() : this->surIndex.size();
+	unsigned int lines_first = this->is_surface_only ? this->surface_lines_offset : this->lines_offset;
+	unsigned int triangles_first = this->is_surface_only ? this->surface_triangles_offset : this->triangles_offset;
+	size_t points_count = this->is_surface_only ? this->surfaceParticles.size() : this->particles_count;
+
 	glPointSize(5.0f);
-	glDrawElements(GL_POINTS, this->particles_count, GL_UNSIGNED_INT, &p_index[0]);
+	glDrawArrays(GL_POINTS, 0, points_count);
 
 	if (this->is_lines_shading) {
 		//glLineWidth(1.0f);
-		glDrawElements(GL_LINES, this->eleIndex.size(), GL_UNSIGNED_INT, &this->eleIndex[0]);
+		if (lines_count > 0)
+			glDrawElements(GL_LINES, lines_count, GL_UNSIGNED_INT, BUFFER_OFFSET(lines_first * sizeof(unsigned int)));
+	}
+	else {
+		if (triangles_count > 0) {
+			if (this->surface_shader != nullptr)
+				this->surface_shader->enable();
+
+			glDrawElements(GL_TRIANGLES, triangles_count, GL_UNSIGNED_INT, BUFFER_OFFSET(triangles_first * sizeof(unsigned int)));
+
+			//Leave the main program bound, the caller sets its uniforms after this call.
+			if (this->surface_shader != nullptr && this->shader != nullptr)
+				this->shader->enable();
+		}
+	}
+
+	glBindVertexArray(0);
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::uploadVertices() {
+	//Systems that are only simulated, e.g. drawn by someone else, have no buffer.
+	if (this->vboId == 0)
+		return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, this->vboId);
+
+	if (this->is_surface_only) {
+		for (size_t i = 0; i < this->surfaceParticles.size(); i++)
+			this->surfaceVertices[i] = this->vertices[this->surfaceParticles[i]];
+
+		glBufferSubData(GL_ARRAY_BUFFER, 0, this->surfaceVertices.size() * sizeof(ParticleVertex), &this->surfaceVertices[0]);
 	}
 	else {
-		glDrawElements(GL_TRIANGLES, this->surIndex.size(), GL_UNSIGNED_INT, &this->surIndex[0]);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, this->vertices.size() * sizeof(ParticleVertex), &this->vertices[0]);
 	}
 }
 
 
+template <class Real>
+size_t ParticleSystem<Real>::getRenderVertexCount() const {
+	return this->is_surface_only ? this->surfaceParticles.size() : this->particles_count;
+}
+
+
+template <class Real>
+void ParticleSystem<Real>::copyRenderVertices(ParticleVertex* destination) const {
+	if (this->is_surface_only) {
+		for (size_t i = 0; i < this->surfaceParticles.size(); i++)
+			destination[i] = this->vertices[this->surfaceParticles[i]];
+	}
+	else {
+		std::copy(this->vertices.begin(), this->vertices.end(), destination);
+	}
+}
+
+
+template <class Real>
+const vector<unsigned int>& ParticleSystem<Real>::getRenderLineIndices() const {
+	return this->is_surface_only ? this->surfaceEleIndex : this->eleIndex;
+}
+
+
+template <class Real>
+const vector<unsigned int>& ParticleSystem<Real>::getRenderTriangleIndices() const {
+	return this->is_surface_only ? this->surfaceSurIndex : this->surIndex;
+}
+
+
 template <class Real>
 void ParticleSystem<Real>::endRender() {
 	if (this->shader != nullptr)
 		this->shader->disable();
 
-	glDisableVertexAttribArray(POSITION_LOC);
-	glDisableVertexAttribArray(COLOR_LOC);
-	glDeleteBuffers(1, &this->vboId);
+	if (this->vaoId != 0) {
+		glDeleteVertexArrays(1, &this->vaoId);
+		this->vaoId = 0;
+	}
+
+	if (this->owns_buffer) {
+		glDeleteBuffers(1, &this->vboId);
+		glDeleteBuffers(1, &this->iboId);
+		this->owns_buffer = false;
+	}
 }
 
 
 template <class Real>
 shared_ptr<Shader>& ParticleSystem<Real>::getShader() {
 	return this->shader;
+}
+
+
+template <class Real>
+shared_ptr<Shader>& ParticleSystem<Real>::getSurfaceShader() {
+	return this->surface_shader;
 }
\ No newline at end of file
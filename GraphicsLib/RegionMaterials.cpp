@@ -0,0 +1,78 @@
+#include "RegionMaterials.h"
+#include "LoadTetGenFiles.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+
+RegionMaterial::RegionMaterial() :
+mass(1.0f),
+stiffness(1.0f),
+damping(1.0f),
+contractility(1.0f)
+{
+}
+
+
+bool RegionMaterial::isDefault() const {
+	return this->mass == 1.0f && this->stiffness == 1.0f && this->damping == 1.0f && this->contractility == 1.0f;
+}
+
+
+RegionMaterials::RegionMaterials()
+{
+}
+
+
+RegionMaterials::~RegionMaterials()
+{
+}
+
+
+bool RegionMaterials::load(const string &file_name) {
+	ifstream file(file_name.c_str());
+	if (!file.is_open())
+		return false;
+
+	string line;
+	istringstream iss;
+	while (getline(file, line)) {
+		if (line.empty() || line[0] == FILE_COMMENT)
+			continue;
+
+		iss.clear();
+		iss.str(line);
+		unsigned int region;
+		RegionMaterial material;
+		if (!(iss >> region >> material.mass >> material.stiffness >> material.damping >> material.contractility)) {
+			cerr << "[RegionMaterials:load] Error: Bad material line in " << file_name << ": " << line << endl;
+			return false;
+		}
+
+		if (material.mass <= 0.0f || material.stiffness < 0.0f || material.damping < 0.0f) {
+			cerr << "[RegionMaterials:load] Error: Region " << region << " needs a positive mass and no negative stiffness or damping." << endl;
+			return false;
+		}
+
+		this->setMaterial(region, material);
+	}
+
+	return true;
+}
+
+
+void RegionMaterials::setMaterial(unsigned int region, const RegionMaterial &material) {
+	if (region >= this->materials.size())
+		this->materials.resize(region + 1);
+	this->materials[region] = material;
+}
+
+
+const RegionMaterial& RegionMaterials::getMaterial(unsigned int region) const {
+	return (region < this->materials.size()) ? this->materials[region] : this->default_material;
+}
+
+
+size_t RegionMaterials::getRegionCount() const {
+	return this->materials.size();
+}
\ No newline at end of file
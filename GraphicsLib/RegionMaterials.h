@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+//Material of one tissue region, as factors on the values of the whole mesh. 1 everywhere is the plain mesh.
+struct RegionMaterial {
+	float mass;
+	float stiffness;
+	float damping;
+
+	//Share of the activation the region follows: 1 is working muscle, 0 scar that does not contract.
+	float contractility;
+
+	RegionMaterial();
+	bool isDefault() const;
+};
+
+/*
+*	The materials of the regions of a mesh, e.g. ventricles, atria and scar tissue tagged with TetGen
+*	region attributes. Regions not listed keep the default material.	*/
+class RegionMaterials
+{
+public:
+	RegionMaterials();
+	~RegionMaterials();
+
+	/*	Read a material file: one "region mass stiffness damping contractility" line per region, lines
+	*	starting with '#' are comments.	*/
+	bool load(const string &file_name);
+
+	void setMaterial(unsigned int region, const RegionMaterial &material);
+	const RegionMaterial& getMaterial(unsigned int region) const;
+
+	//Number of regions with a material, one past the highest listed region.
+	size_t getRegionCount() const;
+
+protected:
+	vector<RegionMaterial> materials;
+	RegionMaterial default_material;
+};
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "RenderQueue.h"
+#include <algorithm>
+
+#define BUFFER_OFFSET(i) ((char *)NULL + (i))
+
+
+RenderQueue::RenderQueue() :
+dirty(false),
+state_changes(0)
+{
+}
+
+
+RenderQueue::~RenderQueue()
+{
+}
+
+
+size_t RenderQueue::add(const DrawItem& item) {
+	this->items.push_back(item);
+	this->dirty = true;
+	return this->items.size() - 1;
+}
+
+
+size_t RenderQueue::add(const shared_ptr<Shader>& shader, unsigned int vao, unsigned int mode, unsigned int first, unsigned int count, bool indexed) {
+	DrawItem item;
+	item.shader = shader;
+	item.vao = vao;
+	item.mode = mode;
+	item.indexed = indexed;
+	item.first = first;
+	item.count = count;
+	item.enabled = true;
+	return this->add(item);
+}
+
+
+void RenderQueue::setRange(size_t handle, unsigned int first, unsigned int count) {
+	this->items[handle].first = first;
+	this->items[handle].count = count;
+}
+
+
+void RenderQueue::setEnabled(size_t handle, bool enabled) {
+	this->items[handle].enabled = enabled;
+}
+
+
+void RenderQueue::clear() {
+	this->items.clear();
+	this->order.clear();
+	this->programs.clear();
+	this->dirty = false;
+}
+
+
+void RenderQueue::uniformMatrix(const char* name, const Matrix4f& matrix) {
+	for (size_t i = 0; i < this->uniforms.size(); i++) {
+		if (this->uniforms[i].name == name) {
+			this->uniforms[i].matrix = matrix;
+			return;
+		}
+	}
+
+	/* A new uniform is looked up once, a dirty queue does it when it is sorted. */
+	MatrixUniform uniform;
+	uniform.name = name;
+	uniform.matrix = matrix;
+	this->uniforms.push_back(uniform);
+	if (!this->dirty)
+		this->_locate(this->uniforms.size() - 1);
+}
+
+
+void RenderQueue::submit() {
+	if (this->dirty)
+		this->_sort();
+
+	Shader* current_shader = NULL;
+	size_t program = 0;
+	unsigned int current_vao = 0;
+	this->state_changes = 0;
+
+	for (size_t i = 0; i < this->order.size(); i++) {
+		const DrawItem &item = this->items[this->order[i]];
+		if (!item.enabled || item.count == 0)
+			continue;
+
+		if (item.shader.get() != current_shader) {
+			current_shader = item.shader.get();
+			current_shader->enable();
+			this->state_changes++;
+
+			/* Programs whose items are all disabled are skipped, @programs follows the same order. */
+			while (this->programs[program] != current_shader)
+				program++;
+			for (size_t u = 0; u < this->uniforms.size(); u++) {
+				int location = this->uniforms[u].locations[program];
+				if (location != -1)
+					glUniformMatrix4fv(location, 1, false, this->uniforms[u].matrix.constData());
+			}
+		}
+
+		if (item.vao != current_vao) {
+			current_vao = item.vao;
+			glBindVertexArray(current_vao);
+			this->state_changes++;
+		}
+
+		if (item.indexed)
+			glDrawElements(item.mode, item.count, GL_UNSIGNED_INT, BUFFER_OFFSET(item.first * sizeof(unsigned int)));
+		else
+			glDrawArrays(item.mode, item.first, item.count);
+	}
+
+	glBindVertexArray(0);
+	if (current_shader != NULL)
+		current_shader->disable();
+}
+
+
+size_t RenderQueue::getItemCount() const {
+	return this->items.size();
+}
+
+
+size_t RenderQueue::getStateChanges() const {
+	return this->state_changes;
+}
+
+
+void RenderQueue::_sort() {
+	this->order.clear();
+	for (size_t i = 0; i < this->items.size(); i++) {
+		if (this->items[i].shader != nullptr)
+			this->order.push_back(i);
+	}
+
+	/* Program switches are the most expensive, then VAO switches. Equal state keeps the recording order. */
+	const vector<DrawItem> &items = this->items;
+	stable_sort(this->order.begin(), this->order.end(), [&items](size_t a, size_t b) {
+		unsigned int program_a = items[a].shader->getProgramID();
+		unsigned int program_b = items[b].shader->getProgramID();
+		if (program_a != program_b)
+			return program_a < program_b;
+		return items[a].vao < items[b].vao;
+	});
+
+	this->programs.clear();
+	for (size_t i = 0; i < this->order.size(); i++) {
+		Shader* shader = this->items[this->order[i]].shader.get();
+		if (this->programs.empty() || this->programs.back() != shader)
+			this->programs.push_back(shader);
+	}
+
+	for (size_t u = 0; u < this->uniforms.size(); u++)
+		this->_locate(u);
+
+	this->dirty = false;
+}
+
+
+void RenderQueue::_locate(size_t uniform) {
+	MatrixUniform &u = this->uniforms[uniform];
+	u.locations.resize(this->programs.size());
+	for (size_t i = 0; i < this->programs.size(); i++)
+		u.locations[i] = glGetUniformLocation(this->programs[i]->getProgramID(), u.name.c_str());
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "Shader.h"
+
+using namespace std;
+
+/* One recorded draw call. The vertex layout and the index buffer it reads are captured by the VAO. */
+struct DrawItem {
+	shared_ptr<Shader> shader;
+	unsigned int vao;
+
+	//GL_POINTS, GL_LINES or GL_TRIANGLES.
+	unsigned int mode;
+
+	//Indexed items draw @count indices of the VAO's element buffer starting at @first, others draw @count vertices.
+	bool indexed;
+	unsigned int first;
+	unsigned int count;
+
+	//Disabled items stay recorded but are skipped by submit().
+	bool enabled;
+};
+
+/*
+*	Retained list of draw calls. Objects record their items once, when their GPU data is built,
+*	and afterwards only change the ranges or the enabled flags. The items are kept sorted by
+*	program and then by VAO, so submit() binds a program or a VAO only when the next item needs
+*	a different one. Adding items or clearing the queue marks the order dirty; submitting an
+*	unchanged queue allocates nothing.
+*	All functions must be called with the GL context current.	*/
+class RenderQueue
+{
+public:
+	RenderQueue();
+	~RenderQueue();
+
+	//Record an item and return its handle. Handles stay valid until clear().
+	size_t add(const DrawItem& item);
+	size_t add(const shared_ptr<Shader>& shader, unsigned int vao, unsigned int mode, unsigned int first, unsigned int count, bool indexed = true);
+
+	void setRange(size_t handle, unsigned int first, unsigned int count);
+	void setEnabled(size_t handle, bool enabled);
+
+	//Forget every item. The VAOs are not deleted, they belong to the objects that recorded them.
+	void clear();
+
+	//Set a matrix uniform on every program used by the recorded items. The value is only stored, submit() uploads it.
+	void uniformMatrix(const char* name, const Matrix4f& matrix);
+
+	//Issue every enabled item in state order.
+	void submit();
+
+	size_t getItemCount() const;
+
+	//Number of program and VAO binds done by the last submit().
+	size_t getStateChanges() const;
+
+protected:
+	//Rebuild the submission order and the list of programs.
+	void _sort();
+
+	//Look up the location of a uniform in every program.
+	void _locate(size_t uniform);
+
+protected:
+	/* A matrix set on every program, with its location in each entry of @programs (-1 where unused). */
+	struct MatrixUniform {
+		string name;
+		Matrix4f matrix;
+		vector<int> locations;
+	};
+
+	vector<DrawItem> items;
+
+	//Item handles in submission order. Items without a program are left out.
+	vector<size_t> order;
+
+	//The distinct programs of the items, in submission order.
+	vector<Shader*> programs;
+
+	vector<MatrixUniform> uniforms;
+
+	bool dirty;
+	size_t state_changes;
+};
\ No newline at end of file
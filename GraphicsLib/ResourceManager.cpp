@@ -0,0 +1,176 @@
+#include "ResourceManager.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+
+ResourceManager::ResourceManager() :
+driver_hash(0)
+{
+}
+
+
+ResourceManager::~ResourceManager()
+{
+}
+
+
+shared_ptr<Shader> ResourceManager::getShader(const string& vertexShader, const string& fragmentShader) {
+	string key = _shaderKey(vertexShader, fragmentShader);
+
+	map< string, shared_ptr<Shader> >::iterator it = this->shaders.find(key);
+	if (it != this->shaders.end())
+		return it->second;
+
+	/* A program that failed once fails again, reported and rebuilt only after releaseAll(). */
+	it = this->failed_shaders.find(key);
+	if (it != this->failed_shaders.end())
+		return it->second;
+
+	shared_ptr<Shader> shader = make_shared<Shader>();
+	if (!shader->load(vertexShader, fragmentShader)) {
+		cerr << "[ResourceManager:getShader] Error: Could not read shader sources: " << key << endl;
+		this->failed_shaders[key] = shader;
+		return shader;
+	}
+
+	/* Loading only reads the sources, the expensive part is compile() and link(). */
+	bool use_cache = !this->program_cache_directory.empty() && Shader::ProgramBinarySupported();
+	unsigned long long source_hash = Shader::Hash(shader->fragSource, Shader::Hash(shader->vertSource));
+	string cache_path = use_cache ? this->_programCachePath(source_hash) : string();
+
+	if (!use_cache || !shader->loadProgramBinary(cache_path, this->_driverHash(), source_hash)) {
+		if (!shader->compile() || !shader->link()) {
+			cerr << "[ResourceManager:getShader] Error: Could not build program from: " << key << endl;
+			this->failed_shaders[key] = shader;
+			return shader;
+		}
+
+		if (use_cache)
+			shader->saveProgramBinary(cache_path, this->_driverHash(), source_hash);
+	}
+
+	this->shaders[key] = shader;
+	return shader;
+}
+
+
+void ResourceManager::setProgramCacheDirectory(const string& directory) {
+	this->program_cache_directory = directory;
+	if (directory.empty())
+		return;
+
+	/* Only the last path component is created; an existing directory is not an error. */
+#ifdef _WIN32
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+}
+
+
+unsigned int ResourceManager::requestBuffer(const string& name, size_t bytes, unsigned int usage) {
+	map< string, BufferResource >::iterator it = this->buffers.find(name);
+
+	if (it == this->buffers.end()) {
+		BufferResource buffer;
+		buffer.id = 0;
+		buffer.capacity = 0;
+		buffer.size = 0;
+		glGenBuffers(1, &buffer.id);
+		it = this->buffers.insert(make_pair(name, buffer)).first;
+	}
+
+	BufferResource &buffer = it->second;
+	glBindBuffer(GL_ARRAY_BUFFER, buffer.id);
+
+	if (bytes > buffer.capacity) {
+		size_t grown = buffer.capacity + buffer.capacity / 2;
+		buffer.capacity = (bytes > grown) ? bytes : grown;
+		glBufferData(GL_ARRAY_BUFFER, buffer.capacity, NULL, usage);
+	}
+
+	buffer.size = bytes;
+	return buffer.id;
+}
+
+
+unsigned int ResourceManager::requestBuffer(const string& name, size_t bytes, const void* data, unsigned int usage) {
+	unsigned int id = this->requestBuffer(name, bytes, usage);
+
+	if (data != NULL && bytes > 0)
+		glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, data);
+
+	return id;
+}
+
+
+void ResourceManager::releaseBuffer(const string& name) {
+	map< string, BufferResource >::iterator it = this->buffers.find(name);
+	if (it == this->buffers.end())
+		return;
+
+	glDeleteBuffers(1, &it->second.id);
+	this->buffers.erase(it);
+}
+
+
+void ResourceManager::releaseAll() {
+	for (map< string, BufferResource >::iterator it = this->buffers.begin(); it != this->buffers.end(); it++)
+		glDeleteBuffers(1, &it->second.id);
+
+	//The programs are deleted by the Shader destructor once the last owner lets go.
+	this->buffers.clear();
+	this->shaders.clear();
+	this->failed_shaders.clear();
+}
+
+
+size_t ResourceManager::getShaderCount() const {
+	return this->shaders.size();
+}
+
+
+size_t ResourceManager::getBufferCapacity() const {
+	size_t total = 0;
+	for (map< string, BufferResource >::const_iterator it = this->buffers.begin(); it != this->buffers.end(); it++)
+		total += it->second.capacity;
+
+	return total;
+}
+
+
+string ResourceManager::_shaderKey(const string& vertexShader, const string& fragmentShader) {
+	return vertexShader + "|" + fragmentShader;
+}
+
+
+unsigned long long ResourceManager::_driverHash() {
+	if (this->driver_hash != 0)
+		return this->driver_hash;
+
+	const char* strings[] = {
+		reinterpret_cast<const char*>(glGetString(GL_VENDOR)),
+		reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+		reinterpret_cast<const char*>(glGetString(GL_VERSION))
+	};
+
+	unsigned long long hash = Shader::Hash(string());
+	for (size_t i = 0; i < 3; i++)
+		hash = Shader::Hash(strings[i] != NULL ? string(strings[i]) : string(), hash);
+
+	this->driver_hash = hash;
+	return hash;
+}
+
+
+string ResourceManager::_programCachePath(unsigned long long sourceHash) const {
+	ostringstream path;
+	path << this->program_cache_directory << "/" << hex << setw(16) << setfill('0') << sourceHash << ".glbin";
+	return path.str();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include "Shader.h"
+
+using namespace std;
+
+/* A GPU buffer together with the amount of storage that has been allocated for it. */
+struct BufferResource {
+	unsigned int id;
+
+	//Bytes allocated on the GPU. Only grows, so reloading a smaller mesh reuses the storage.
+	size_t capacity;
+
+	//Bytes requested by the current user of the buffer.
+	size_t size;
+};
+
+/*
+*	Owns the GPU resources that outlive a single mesh: linked shader programs keyed
+*	by their source paths and vertex buffers keyed by name. Switching meshes asks
+*	the manager again instead of compiling a new program or creating a new buffer.
+*	All functions must be called with the GL context current.	*/
+class ResourceManager
+{
+public:
+	ResourceManager();
+	~ResourceManager();
+
+	/*	Return the program built from the two shader files. It is compiled and linked only on the first request.
+	*	The attribute locations come from the layout qualifiers of the sources. A program that cannot be built
+	*	is reported once and returned unlinked to later requests as well.	*/
+	shared_ptr<Shader> getShader(const string& vertexShader, const string& fragmentShader);
+
+	/*	Keep linked program binaries in @directory so the next start can skip GLSL compilation.
+	*	Entries are keyed by the shader sources and the driver, and anything that does not match
+	*	is rebuilt from source and overwritten. An empty string disables the cache (default).	*/
+	void setProgramCacheDirectory(const string& directory);
+
+	/*	Return a vertex buffer with room for at least @bytes. The storage is reallocated only
+	*	when the capacity is too small, growing by half of the current capacity to absorb
+	*	repeated small increases. The buffer is left bound to GL_ARRAY_BUFFER.	*/
+	unsigned int requestBuffer(const string& name, size_t bytes, unsigned int usage = GL_DYNAMIC_DRAW);
+
+	//Same as above, and uploads @bytes of @data to the start of the buffer.
+	unsigned int requestBuffer(const string& name, size_t bytes, const void* data, unsigned int usage = GL_DYNAMIC_DRAW);
+
+	void releaseBuffer(const string& name);
+
+	//Delete every cached program and buffer. Failed programs are tried again after this.
+	void releaseAll();
+
+	size_t getShaderCount() const;
+	size_t getBufferCapacity() const;
+
+protected:
+	static string _shaderKey(const string& vertexShader, const string& fragmentShader);
+
+	//Hash of the vendor, renderer and version strings of the current context.
+	unsigned long long _driverHash();
+
+	string _programCachePath(unsigned long long sourceHash) const;
+
+protected:
+	string program_cache_directory;
+	unsigned long long driver_hash;
+
+	map< string, shared_ptr<Shader> > shaders;
+
+	//Programs whose sources could not be read or built, so they are not retried on every request.
+	map< string, shared_ptr<Shader> > failed_shaders;
+	map< string, BufferResource > buffers;
+};
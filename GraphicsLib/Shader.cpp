@@ -26,12 +26,25 @@
 #include "Shader.h"
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 const static std::string DIFFUSE_TEXTURE = "diffuseTexture";
 const static std::string NORMAL_TEXTURE = "normalTexture";
 const static std::string SPECULAR_TEXTURE = "specularTexture";
 const static std::string HEIGHTMAP_TEXTURE = "heightmapTexture";
 
+const static unsigned int PROGRAM_BINARY_MAGIC = 0x4250534D; /* "MSPB" */
+const static unsigned int PROGRAM_BINARY_VERSION = 1;
+
+struct ProgramBinaryHeader {
+    unsigned int magic;
+    unsigned int version;
+    unsigned long long driverHash;
+    unsigned long long sourceHash;
+    unsigned int format;
+    unsigned int length;
+};
+
 Shader::Shader() {
     this->programId = 0;
     this->vertexId = 0;
@@ -93,42 +106,139 @@ bool Shader::link() {
     this->programId = glCreateProgram();
     glAttachShader(this->programId, this->vertexId);
     glAttachShader(this->programId, this->fragmentId);
+
+    if ( Shader::ProgramBinarySupported() )
+        glProgramParameteri(this->programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     glLinkProgram(this->programId);
     
     if ( !this->linkStatus(this->programId) ) return false;
     return true;
 }
 
+bool Shader::loadProgramBinary(const std::string& filename, unsigned long long driverHash, unsigned long long sourceHash) {
+    if ( !Shader::ProgramBinarySupported() ) return false;
+
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if ( !file.is_open() ) return false;
+
+    ProgramBinaryHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(ProgramBinaryHeader));
+    if ( !file ) return false;
+
+    if ( header.magic != PROGRAM_BINARY_MAGIC || header.version != PROGRAM_BINARY_VERSION ) return false;
+    if ( header.driverHash != driverHash || header.sourceHash != sourceHash ) return false;
+
+    /* A truncated or corrupt file must not size the allocation, only the bytes present can be the binary. */
+    std::streamoff header_end = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff available = file.tellg() - header_end;
+    if ( header.length == 0 || static_cast<std::streamoff>(header.length) > available ) return false;
+    file.seekg(header_end);
+
+    std::vector<char> binary(header.length);
+    file.read(&binary[0], header.length);
+    if ( !file ) return false;
+
+    unsigned int program = glCreateProgram();
+    glProgramBinary(program, header.format, &binary[0], header.length);
+
+    /* A driver may still reject a binary it produced, e.g. after a silent update. */
+    GLint link_status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+    if ( link_status == GL_FALSE ) {
+        glDeleteProgram(program);
+        return false;
+    }
+
+    if ( this->programId != 0 ) glDeleteProgram(this->programId);
+    this->programId = program;
+    return true;
+}
+
+bool Shader::saveProgramBinary(const std::string& filename, unsigned long long driverHash, unsigned long long sourceHash) const {
+    if ( !Shader::ProgramBinarySupported() || this->programId == 0 ) return false;
+
+    GLint length = 0;
+    glGetProgramiv(this->programId, GL_PROGRAM_BINARY_LENGTH, &length);
+    if ( length <= 0 ) return false;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(this->programId, length, 0, &format, &binary[0]);
+
+    ProgramBinaryHeader header;
+    header.magic = PROGRAM_BINARY_MAGIC;
+    header.version = PROGRAM_BINARY_VERSION;
+    header.driverHash = driverHash;
+    header.sourceHash = sourceHash;
+    header.format = format;
+    header.length = static_cast<unsigned int>(length);
+
+    std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if ( !file.is_open() ) {
+        std::cerr << "[Shader:saveProgramBinary] Error: Cannot write program binary: " << filename << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(ProgramBinaryHeader));
+    file.write(&binary[0], length);
+    return true;
+}
+
+bool Shader::ProgramBinarySupported() {
+    return GLEW_ARB_get_program_binary != 0;
+}
+
+/* 64-bit FNV-1a. Pass a previous result as @seed to hash several strings in sequence. */
+unsigned long long Shader::Hash(const std::string& text, unsigned long long seed) {
+    unsigned long long hash = seed;
+    for ( std::size_t i = 0; i < text.length(); i++ ) {
+        hash ^= static_cast<unsigned char>(text[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
 bool Shader::loadDiffuseTexture(const std::string& filename) {
     if ( filename.length() == 0 ) return false;
     this->diffuseTexture = std::make_shared<Texture>();
-    this->diffuseTexture->load(filename);
+    this->diffuseTexture->loadAsync(filename);
     return true;
 }
 
 bool Shader::loadNormalTexture(const std::string& filename) {
     if ( filename.length() == 0 ) return false;
     this->normalTexture = std::make_shared<Texture>();
-    this->normalTexture->load(filename);
+    this->normalTexture->loadAsync(filename);
     return true;
 }
 
 bool Shader::loadSpecularTexture(const std::string& filename) {
     if ( filename.length() == 0 ) return false;
     this->specularTexture = std::make_shared<Texture>();
-    this->specularTexture->load(filename);
+    this->specularTexture->loadAsync(filename);
     return true;
 }
 
 bool Shader::loadHeightmapTexture(const std::string& filename) {
     if ( filename.length() == 0 ) return false;
     this->heightmapTexture = std::make_shared<Texture>();
-    this->heightmapTexture->load(filename);
+    this->heightmapTexture->loadAsync(filename);
     return true;
 }
 
+void Shader::uploadTextures() {
+    if ( this->diffuseTexture != nullptr ) this->diffuseTexture->upload();
+    if ( this->normalTexture != nullptr ) this->normalTexture->upload();
+    if ( this->specularTexture != nullptr ) this->specularTexture->upload();
+    if ( this->heightmapTexture != nullptr ) this->heightmapTexture->upload();
+}
+
 bool Shader::enable() {
     glUseProgram(this->programId);
+    this->uploadTextures();
     
     if ( this->diffuseTexture != nullptr ) {
         glActiveTextureARB(GL_TEXTURE0);
@@ -42,11 +42,28 @@ public:
     virtual bool compile();
     virtual bool link();
 
+    /* 
+     * Program binary cache (GL_ARB_get_program_binary). The file stores the driver
+     * and source hashes next to the binary so a stale or foreign file is rejected
+     * and the caller can fall back to compiling from source.
+     */
+    bool loadProgramBinary(const std::string& filename, unsigned long long driverHash, unsigned long long sourceHash);
+    bool saveProgramBinary(const std::string& filename, unsigned long long driverHash, unsigned long long sourceHash) const;
+
+    static bool ProgramBinarySupported();
+    static unsigned long long Hash(const std::string& text, unsigned long long seed = 14695981039346656037ULL);
+
     bool loadDiffuseTexture(const std::string& filename);
     bool loadNormalTexture(const std::string& filename);
     bool loadSpecularTexture(const std::string& filename);
     bool loadHeightmapTexture(const std::string& filename);
 
+    /* 
+     * The texture loaders decode in the background. This uploads the textures whose decode
+     * has finished; enable() calls it, so a texture appears with the first frame after its decode.
+     */
+    void uploadTextures();
+
     bool enable();
     bool disable();
 
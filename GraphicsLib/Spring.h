@@ -24,9 +24,15 @@ public:
 	size_t p0;
 	size_t p1;
 
-	//The rest length of the spring.
+	//The base rest length of the spring. The current rest length is d_r times the scale plus the offset of the spring's region.
 	Real d_r;
 
+	//Index into the activation of the particle system, 0 unless the springs were split into regions.
+	unsigned int region;
+
 	//The stiffness of the spring.
 	float k;
+
+	//The share of the activation the spring follows, 1 takes the full change of rest length and 0 keeps d_r.
+	float contraction;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Texture.h"
 #include "PNG.h"
 #include <iostream>
+#include <chrono>
 #include <gl/glew.h>
 #include <gl/freeglut.h>
 
@@ -11,29 +12,75 @@ Texture::Texture() {
 }
 
 Texture::~Texture() {
-
+    /* A decode still running is waited for by the future's destructor. */
+    if ( this->textureId != 0 ) glDeleteTextures(1, &this->textureId);
 }
 
 bool Texture::load(const std::string& filename) {
+    if ( !this->loadAsync(filename) ) return false;
+
+    this->pending.wait();
+    return this->upload();
+}
+
+bool Texture::loadAsync(const std::string& filename) {
     if ( filename.length() == 0 ) return false;
 
-    unsigned int error = lodepng::decode(this->image, this->width, this->height, filename, LCT_RGBA);
+    this->filename = filename;
+    this->pending = std::async(std::launch::async, &Texture::Decode, filename);
+    return true;
+}
+
+bool Texture::poll() const {
+    return this->pending.valid() && this->pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+bool Texture::upload() {
+    if ( this->textureId != 0 ) return true;
+    if ( !this->poll() ) return false;
 
-    if ( error ) {
-        std::cerr << "[Texture:load] Error: Could not load PNG image: " << filename << std::endl;
+    DecodedImage decoded = this->pending.get();
+    if ( decoded.error ) {
+        std::cerr << "[Texture:upload] Error: Could not load PNG image: " << this->filename << std::endl;
         return false;
     }
-  
+
+    this->image.swap(decoded.pixels);
+    this->width = decoded.width;
+    this->height = decoded.height;
+
+    /* Rows of RGBA pixels are always 4 byte aligned, the previous alignment is put back for other uploads. */
+    GLint alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
     glGenTextures(1, &this->textureId);
     glBindTexture(GL_TEXTURE_2D, this->textureId);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, this->width, this->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, &this->image[0]);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
 
+    /* The GL keeps its own copy, swap with an empty vector to actually release the memory. */
+    std::vector<unsigned char>().swap(this->image);
     return true;
 }
 
+bool Texture::isReady() const {
+    return this->textureId != 0;
+}
+
 void Texture::render() const {
     glEnable(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, this->textureId);
 }
+
+Texture::DecodedImage Texture::Decode(const std::string& filename) {
+    DecodedImage decoded;
+    decoded.width = 0;
+    decoded.height = 0;
+    decoded.error = lodepng::decode(decoded.pixels, decoded.width, decoded.height, filename, LCT_RGBA);
+    return decoded;
+}
@@ -1,25 +1,58 @@
-
 #ifndef TEXTURE_H
 #define TEXTURE_H
 
 #include <string>
 #include <vector>
+#include <future>
 
 class Texture {
 public:
     Texture();
     ~Texture();
 
+    /* Decode the PNG and upload it right away. Blocks until the texture is on the GPU. */
     bool load(const std::string& filename);
 
+    /* 
+     * Start decoding the PNG on a background thread and return immediately. The texture
+     * reaches the GPU with the first upload() on the GL thread after poll() turned true;
+     * until then render() binds no texture.
+     */
+    bool loadAsync(const std::string& filename);
+
+    /* True once the background decode has finished and the image waits for upload(). */
+    bool poll() const;
+
+    /* 
+     * Upload the decoded image with mipmaps if poll() is true and free the CPU copy.
+     * Call with the GL context current. Returns true once the texture is on the GPU.
+     */
+    bool upload();
+
+    bool isReady() const;
+
     void render() const;
 
 protected:
+    struct DecodedImage {
+        std::vector<unsigned char> pixels;
+        unsigned int width;
+        unsigned int height;
+        unsigned int error;
+    };
+
+    static DecodedImage Decode(const std::string& filename);
+
+protected:
+    /* Only holds pixels between the decode and the upload, freed afterwards. */
     std::vector<unsigned char> image;
     unsigned int width;
     unsigned int height;
 
     unsigned int textureId;
+
+    std::string filename;
+    std::future<DecodedImage> pending;
 };
 
 #endif
@@ -0,0 +1,175 @@
+#include "VertexCacheOptimizer.h"
+#include <math.h>
+#include <deque>
+
+//Scoring constants from the original article.
+static const float CACHE_DECAY_POWER = 1.5f;
+static const float LAST_TRIANGLE_SCORE = 0.75f;
+static const float VALENCE_BOOST_SCALE = 2.0f;
+static const float VALENCE_BOOST_POWER = 0.5f;
+
+
+void VertexCacheOptimizer::Optimize(vector<unsigned int> &indices, size_t vertex_count) {
+	size_t triangle_count = indices.size() / 3;
+	if (triangle_count == 0)
+		return;
+
+	/* Triangles around every vertex, as offsets into one flat list. */
+	vector<unsigned int> offsets(vertex_count + 1, 0);
+	for (size_t i = 0; i < triangle_count * 3; i++)
+		offsets[indices[i] + 1]++;
+
+	for (size_t v = 0; v < vertex_count; v++)
+		offsets[v + 1] += offsets[v];
+
+	vector<unsigned int> vertex_triangles(triangle_count * 3);
+	vector<unsigned int> remaining(vertex_count, 0);
+	for (size_t t = 0; t < triangle_count; t++) {
+		for (size_t c = 0; c < 3; c++) {
+			unsigned int v = indices[3 * t + c];
+			vertex_triangles[offsets[v] + remaining[v]++] = static_cast<unsigned int>(t);
+		}
+	}
+
+	/* Only the first remaining[v] entries of a vertex's triangle list are still to be emitted. */
+	vector<int> cache_position(vertex_count, -1);
+	vector<float> vertex_score(vertex_count);
+	for (size_t v = 0; v < vertex_count; v++)
+		vertex_score[v] = _vertexScore(-1, remaining[v]);
+
+	vector<float> triangle_score(triangle_count);
+	vector<bool> emitted(triangle_count, false);
+	for (size_t t = 0; t < triangle_count; t++)
+		triangle_score[t] = vertex_score[indices[3 * t]] + vertex_score[indices[3 * t + 1]] + vertex_score[indices[3 * t + 2]];
+
+	vector<unsigned int> output;
+	output.reserve(indices.size());
+
+	deque<unsigned int> cache;
+	size_t scan_cursor = 0;
+	int best_triangle = -1;
+
+	for (size_t emitted_count = 0; emitted_count < triangle_count; emitted_count++) {
+		/* No candidate around the cache, fall back to the best of the first not emitted triangles. */
+		if (best_triangle < 0) {
+			while (emitted[scan_cursor])
+				scan_cursor++;
+
+			best_triangle = static_cast<int>(scan_cursor);
+			for (size_t t = scan_cursor; t < triangle_count && t < scan_cursor + CACHE_SIZE; t++) {
+				if (!emitted[t] && triangle_score[t] > triangle_score[best_triangle])
+					best_triangle = static_cast<int>(t);
+			}
+		}
+
+		emitted[best_triangle] = true;
+		for (size_t c = 0; c < 3; c++) {
+			unsigned int v = indices[3 * best_triangle + c];
+			output.push_back(v);
+
+			/* Drop the triangle from the vertex's remaining list. */
+			unsigned int *begin = &vertex_triangles[offsets[v]];
+			for (unsigned int i = 0; i < remaining[v]; i++) {
+				if (begin[i] == static_cast<unsigned int>(best_triangle)) {
+					begin[i] = begin[remaining[v] - 1];
+					break;
+				}
+			}
+			remaining[v]--;
+
+			/* Move the vertex to the front of the LRU cache. */
+			if (cache_position[v] >= 0)
+				cache.erase(cache.begin() + cache_position[v]);
+			cache.push_front(v);
+			for (size_t i = 0; i < cache.size(); i++)
+				cache_position[cache[i]] = static_cast<int>(i);
+		}
+
+		/* The cache may temporarily hold three extra vertices, those pushed out lose their cache bonus. */
+		while (cache.size() > CACHE_SIZE) {
+			unsigned int v = cache.back();
+			cache.pop_back();
+			cache_position[v] = -1;
+			vertex_score[v] = _vertexScore(-1, remaining[v]);
+			for (unsigned int i = 0; i < remaining[v]; i++) {
+				unsigned int t = vertex_triangles[offsets[v] + i];
+				triangle_score[t] = vertex_score[indices[3 * t]] + vertex_score[indices[3 * t + 1]] + vertex_score[indices[3 * t + 2]];
+			}
+		}
+
+		for (size_t i = 0; i < cache.size(); i++)
+			vertex_score[cache[i]] = _vertexScore(static_cast<int>(i), remaining[cache[i]]);
+
+		/* Rescore the triangles touching the cache and pick the next one among them. */
+		best_triangle = -1;
+		float best_score = -1.0f;
+		for (size_t i = 0; i < cache.size(); i++) {
+			unsigned int v = cache[i];
+			for (unsigned int j = 0; j < remaining[v]; j++) {
+				unsigned int t = vertex_triangles[offsets[v] + j];
+				float score = vertex_score[indices[3 * t]] + vertex_score[indices[3 * t + 1]] + vertex_score[indices[3 * t + 2]];
+				triangle_score[t] = score;
+
+				if (score > best_score) {
+					best_score = score;
+					best_triangle = static_cast<int>(t);
+				}
+			}
+		}
+	}
+
+	indices.swap(output);
+}
+
+
+float VertexCacheOptimizer::ACMR(const vector<unsigned int> &indices, size_t cache_size) {
+	size_t triangle_count = indices.size() / 3;
+	if (triangle_count == 0)
+		return 0.0f;
+
+	deque<unsigned int> cache;
+	size_t misses = 0;
+
+	for (size_t i = 0; i < triangle_count * 3; i++) {
+		bool hit = false;
+		for (size_t j = 0; j < cache.size(); j++) {
+			if (cache[j] == indices[i]) {
+				hit = true;
+				break;
+			}
+		}
+
+		if (!hit) {
+			misses++;
+			cache.push_back(indices[i]);
+			if (cache.size() > cache_size)
+				cache.pop_front();
+		}
+	}
+
+	return static_cast<float>(misses) / static_cast<float>(triangle_count);
+}
+
+
+float VertexCacheOptimizer::_vertexScore(int cache_position, unsigned int remaining_triangles) {
+	//Vertices without triangles left are never needed again.
+	if (remaining_triangles == 0)
+		return -1.0f;
+
+	float score = 0.0f;
+	if (cache_position >= 0) {
+		/* The vertices of the last triangle get a fixed score, so the next triangle does not just reuse its edge. */
+		if (cache_position < 3) {
+			score = LAST_TRIANGLE_SCORE;
+		}
+		else {
+			float scaler = 1.0f / (CACHE_SIZE - 3);
+			score = 1.0f - (cache_position - 3) * scaler;
+			score = powf(score, CACHE_DECAY_POWER);
+		}
+	}
+
+	//Favor vertices with few triangles left, so they are finished off and leave the mesh.
+	score += VALENCE_BOOST_SCALE * powf(static_cast<float>(remaining_triangles), -VALENCE_BOOST_POWER);
+	return score;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+/*
+*	Reorders an indexed triangle list so that consecutive triangles share vertices, which lets the
+*	GPU's post-transform cache skip re-shading them. This is Tom Forsyth's greedy "Linear-Speed
+*	Vertex Cache Optimisation": every vertex is scored by its position in a simulated LRU cache and
+*	by how many triangles still use it, and the best scored triangle around the cache is emitted next.
+*	The pass is linear in the number of triangles and meant to run once at load time.	*/
+class VertexCacheOptimizer
+{
+public:
+	//Reorder the triangles of @indices in place. The triangles themselves and their winding are kept.
+	static void Optimize(vector<unsigned int> &indices, size_t vertex_count);
+
+	/*	Average cache miss ratio: vertices shaded per triangle with a FIFO cache of @cache_size entries.
+	*	It lies between about 0.5 (best case for large meshes) and 3.0 (no reuse at all).	*/
+	static float ACMR(const vector<unsigned int> &indices, size_t cache_size = 32);
+
+protected:
+	static float _vertexScore(int cache_position, unsigned int remaining_triangles);
+
+public:
+	//Size of the simulated LRU cache used while optimizing.
+	static const int CACHE_SIZE = 32;
+};
\ No newline at end of file
@@ -40,6 +40,7 @@ class Ui_MassSpringSystemeClass
 public:
     QAction *actionLines_Shading;
     QAction *actionSurface_Shading;
+    QAction *actionSurface_Only;
     QWidget *centralWidget;
     QGridLayout *gridLayout;
     QSplitter *splitter;
@@ -238,6 +239,9 @@ public:
         actionLines_Shading->setObjectName(QStringLiteral("actionLines_Shading"));
         actionSurface_Shading = new QAction(MassSpringSystemeClass);
         actionSurface_Shading->setObjectName(QStringLiteral("actionSurface_Shading"));
+        actionSurface_Only = new QAction(MassSpringSystemeClass);
+        actionSurface_Only->setObjectName(QStringLiteral("actionSurface_Only"));
+        actionSurface_Only->setCheckable(true);
         centralWidget = new QWidget(MassSpringSystemeClass);
         centralWidget->setObjectName(QStringLiteral("centralWidget"));
         gridLayout = new QGridLayout(centralWidget);
@@ -522,6 +526,7 @@ public:
         menuBar->addAction(menuShading->menuAction());
         menuShading->addAction(actionLines_Shading);
         menuShading->addAction(actionSurface_Shading);
+        menuShading->addAction(actionSurface_Only);
 
         retranslateUi(MassSpringSystemeClass);
         QObject::connect(button_start, SIGNAL(released()), MassSpringSystemeClass, SLOT(slotButtonStart()));
@@ -539,6 +544,7 @@ public:
         QObject::connect(pushButton_pumpOnce, SIGNAL(released()), MassSpringSystemeClass, SLOT(slotPushButtonPumpOnce()));
         QObject::connect(actionLines_Shading, SIGNAL(triggered()), MassSpringSystemeClass, SLOT(slotActionLinesShading()));
         QObject::connect(actionSurface_Shading, SIGNAL(triggered()), MassSpringSystemeClass, SLOT(slotActionSurfaceShading()));
+        QObject::connect(actionSurface_Only, SIGNAL(toggled(bool)), MassSpringSystemeClass, SLOT(slotActionSurfaceOnly(bool)));
 
         tabWidget->setCurrentIndex(1);
         toolBox->setCurrentIndex(0);
@@ -552,6 +558,7 @@ public:
         MassSpringSystemeClass->setWindowTitle(QApplication::translate("MassSpringSystemeClass", "MassSpringSysteme", 0));
         actionLines_Shading->setText(QApplication::translate("MassSpringSystemeClass", "Lines Shading", 0));
         actionSurface_Shading->setText(QApplication::translate("MassSpringSystemeClass", "Surface Shading", 0));
+        actionSurface_Only->setText(QApplication::translate("MassSpringSystemeClass", "Surface Only", 0));
         button_line->setText(QApplication::translate("MassSpringSystemeClass", "Line", 0));
         button_tetrahedron->setText(QApplication::translate("MassSpringSystemeClass", "Tetrahedron", 0));
         button_cube->setText(QApplication::translate("MassSpringSystemeClass", "Cube", 0));
@@ -563,6 +570,9 @@ public:
          << QApplication::translate("MassSpringSystemeClass", "Simple Heart", 0)
          << QApplication::translate("MassSpringSystemeClass", "Complex Heart", 0)
          << QApplication::translate("MassSpringSystemeClass", "Real Heart", 0)
+         << QApplication::translate("MassSpringSystemeClass", "Real Heart (Embedded)", 0)
+         << QApplication::translate("MassSpringSystemeClass", "Heart Stiffness Sweep", 0)
+         << QApplication::translate("MassSpringSystemeClass", "Real Heart (FEM)", 0)
         );
         button_load->setText(QApplication::translate("MassSpringSystemeClass", "Load", 0));
         pushButton_update->setText(QApplication::translate("MassSpringSystemeClass", "Update", 0));
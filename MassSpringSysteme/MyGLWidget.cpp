@@ -2,6 +2,17 @@
 #include <iostream>
 #include <LoadTetGenFiles.h>
 
+static const char* PARTICLE_VERTEX_SHADER = "shaders/gridShader.vert";
+static const char* PARTICLE_FRAGMENT_SHADER = "shaders/gridShader.frag";
+static const char* SURFACE_VERTEX_SHADER = "shaders/PhoneLighting.vert";
+static const char* SURFACE_FRAGMENT_SHADER = "shaders/PhoneLighting.frag";
+static const char* BODIES_VERTEX_SHADER = "shaders/instancedBodies.vert";
+
+//The rest length scale of a homogeneous change by @ratio: 0.1 lengthens by 10 %, -0.1 shortens by the inverse factor.
+static float homogeneousScale(float ratio) {
+	return (ratio >= 0.0f) ? 1.0f + ratio : 1.0f / (1.0f - ratio);
+}
+
 
 MyGLWidget::MyGLWidget(QWidget *parent) : 
 QGLWidget(parent)
@@ -12,7 +23,11 @@ QGLWidget(parent)
 	this->camera = make_shared<MouseCameraf>();
 
 	/* Initialize the meshes. */
+	this->resources = make_shared<ResourceManager>();
 	this->grid = make_shared<Grid>();
+	this->render_queue = make_shared<RenderQueue>();
+	this->body_renderer = make_shared<MultiBodyRenderer>();
+	this->sweep_spacing = 0.0f;
 	this->constructCube();
 
 	//Set the fps to be 62. Because 1000 / 16 = 62.
@@ -21,8 +36,18 @@ QGLWidget(parent)
 	this->connect(this->timer, SIGNAL(timeout()), this, SLOT(slotTimeout()));
 	this->timer->setInterval(16);
 
-	this->heart_beated = false;
+	this->simulation_time = 0.0;
+	this->beat_start_time = 0.0;
+	this->heart_beating = false;
+	this->beat_pending = false;
 	this->is_homogeneous = true;
+	this->is_surface_only = false;
+	this->diastolic_pressure = 1.0f;
+	this->systolic_pressure = 5.0f;
+
+	this->capture = make_shared<FrameCapture>();
+	this->capture_frame_limit = 0;
+	this->quit_after_capture = false;
 
 	this->heart_inc = 0.5f;
 	this->heart_dec = -0.5f;
@@ -31,16 +56,20 @@ QGLWidget(parent)
 	this->heart_rate = 60;
 	this->beats_count = 0;
 	this->pump_once = false;
-
-	this->heart_rate_timer = new QTimer(this);
-	this->connect(this->heart_rate_timer, SIGNAL(timeout()), this, SLOT(heartBeat()));
-	this->heart_rate_timer->setInterval((float)60 / this->heart_rate * (float)500);
 }
 
 
 MyGLWidget::~MyGLWidget()
 {
+	this->makeCurrent();
+	this->stopCapture();
 	this->grid->endRender();
+	this->particleSys->endRender();
+	if (this->renderSys != nullptr)
+		this->renderSys->endRender();
+
+	this->body_renderer->release();
+	this->resources->releaseAll();
 }
 
 
@@ -56,15 +85,15 @@ void MyGLWidget::initializeGL() {
 
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glPointSize(5.0f);
 
 	this->camera->setPosition(90.0f, 1.570f, 1.570f * 0.7f);
 	this->camera->setLookAt(Vector3f(0.0f, 10.0f, 0.0f));
 
-	this->grid->loadShader("shaders/gridShader.vert", "shaders/gridShader.frag");
+	this->grid->setShader(this->resources->getShader("shaders/gridShader.vert", "shaders/gridShader.frag"));
 	this->grid->constructGrid(Color3f(0.0f, 0.3f, 0.3f), -10.0f, -100.0f, 100.0f, -100.0f, 100.0f);
 
-	this->particleSys->loadShader("shaders/gridShader.vert", "shaders/gridShader.frag");
-	this->particleSys->constructOnGPU();
+	this->uploadParticleSystem();
 }
 
 
@@ -76,14 +105,24 @@ void MyGLWidget::paintGL() {
 	this->projectionMatrix = this->camera->getProjectionMatrix();
 	this->mvp = this->projectionMatrix * this->modelViewMatrix;
 
-	/* Draw the ground. */
-	this->grid->beginRender();
-	this->grid->getShader()->uniformMatrix("modelViewMatrix", modelViewMatrix);
-	this->grid->getShader()->uniformMatrix("projectionMatrix", projectionMatrix);
+	/* An embedded render mesh is drawn in place of the simulated one, in the same shading mode. */
+	shared_ptr< ParticleSystem<float> > drawn = this->particleSys;
+	if (this->renderSys != nullptr) {
+		this->renderSys->is_lines_shading = this->particleSys->is_lines_shading;
+		drawn = this->renderSys;
+	}
+
+	/* The ground and the mesh were recorded in uploadParticleSystem(), only the mesh's ranges follow the modes. */
+	if (this->sweepSystems.empty())
+		drawn->updateQueue(*this->render_queue);
+
+	this->render_queue->uniformMatrix("modelViewMatrix", modelViewMatrix);
+	this->render_queue->uniformMatrix("projectionMatrix", projectionMatrix);
+	this->render_queue->submit();
 
-	this->particleSys->beginRender();
-	this->particleSys->getShader()->uniformMatrix("modelViewMatrix", modelViewMatrix);
-	this->particleSys->getShader()->uniformMatrix("projectionMatrix", projectionMatrix);
+	/* A sweep is drawn in place of the mesh, every body in one call. */
+	if (!this->sweepSystems.empty())
+		this->body_renderer->render(modelViewMatrix, projectionMatrix, this->particleSys->is_lines_shading);
 }
 
 
@@ -111,20 +150,40 @@ void MyGLWidget::setTimerEnd() {
 
 
 inline void MyGLWidget::setParticleSystemGeneralAttributes(float particle_mass, float spring_rest_length, float spring_stiffness, Vector3f gravity) {
-	this->particleSys->setParticlesMass(particle_mass);
 
 	/*	If we are loading the hard coded meshes, the rc can be changed randomly.
 	 *	But when the tetgen files are loaded, the rc should always be the inital ones.  */
 	if (!this->particleSys->load_mesh)
 		this->particleSys->setSpringsLength(spring_rest_length);
 
-	this->particleSys->setSpringsStiffness(spring_stiffness);
-	this->particleSys->setGravity(gravity);
+	/*	The bodies of a sweep keep their stiffness ratios to body 0. The per spring stiffness and per particle
+	*	mass, from fibers and tissue regions, are scaled along.	*/
+	float factor = (this->particleSys->getSpringsStiffness() > 0.0f) ? spring_stiffness / this->particleSys->getSpringsStiffness() : 0.0f;
+	size_t body_count = std::max<size_t>(this->sweepSystems.size(), 1);
+	for (size_t i = 0; i < body_count; i++) {
+		ParticleSystem<float> &body = this->sweepSystems.empty() ? *this->particleSys : *this->sweepSystems[i];
+		body.setSpringsStiffness((factor > 0.0f) ? body.getSpringsStiffness() * factor : spring_stiffness);
+		body.setParticlesMass(particle_mass);
+		body.setGravity(gravity);
+	}
 }
 
 
 void MyGLWidget::setParticleSystemEnergyAttributes(float bounce_energy_loss_ratio) {
-	this->particleSys->setBounceEnergyLossRatio(bounce_energy_loss_ratio);
+	size_t body_count = std::max<size_t>(this->sweepSystems.size(), 1);
+	for (size_t i = 0; i < body_count; i++) {
+		ParticleSystem<float> &body = this->sweepSystems.empty() ? *this->particleSys : *this->sweepSystems[i];
+		body.setBounceEnergyLossRatio(bounce_energy_loss_ratio);
+	}
+}
+
+
+void MyGLWidget::setLinearDampingAttributes(float a, float b, float t, float k_max) {
+	size_t body_count = std::max<size_t>(this->sweepSystems.size(), 1);
+	for (size_t i = 0; i < body_count; i++) {
+		ParticleSystem<float> &body = this->sweepSystems.empty() ? *this->particleSys : *this->sweepSystems[i];
+		body.setLinearDampingAttributes(a, b, t, k_max);
+	}
 }
 
 
@@ -139,6 +198,10 @@ bool MyGLWidget::getHomegeneous() const {
 
 
 void MyGLWidget::constructLine() {
+	this->renderSys = nullptr;
+	this->embedding = nullptr;
+	this->_clearSweep();
+
 	/* Initialize the starting positions of the particles. */
 	size_t particles_num = 2;
 	this->starting_positions.resize(particles_num);
@@ -167,6 +230,10 @@ void MyGLWidget::constructLine() {
 
 
 void MyGLWidget::constructTetrahedron() {
+	this->renderSys = nullptr;
+	this->embedding = nullptr;
+	this->_clearSweep();
+
 	/* Initialize the starting positions of the particles. */
 	size_t particles_num = 4;
 	this->starting_positions.resize(particles_num);
@@ -212,6 +279,10 @@ void MyGLWidget::constructTetrahedron() {
 
 
 void MyGLWidget::constructCube() {
+	this->renderSys = nullptr;
+	this->embedding = nullptr;
+	this->_clearSweep();
+
 	/* Initialize the starting positions of the particles. */
 	size_t particles_num = 8;
 	this->starting_positions.resize(particles_num);
@@ -280,6 +351,10 @@ void MyGLWidget::constructCube() {
 
 
 void MyGLWidget::constructMesh(size_t particles_num, size_t springs_num, vector<Vector3f> starting_positions, vector<Vector2f> starting_springs, vector<Vector3f> faces) {
+	this->renderSys = nullptr;
+	this->embedding = nullptr;
+	this->_clearSweep();
+
 	this->particleSys = make_shared< ParticleSystem<float> >(particles_num, springs_num);
 	this->particleSys->setParticlesPositions(starting_positions);
 	this->particleSys->setSpringsConnections(starting_springs);
@@ -295,6 +370,179 @@ void MyGLWidget::constructMesh(size_t particles_num, size_t springs_num, vector<
 }
 
 
+void MyGLWidget::constructFEMMesh(size_t particles_num, size_t springs_num, vector<Vector3f> starting_positions, vector<Vector2f> starting_springs, vector<Vector3f> faces, const vector<unsigned int> &tetrahedrons) {
+	this->renderSys = nullptr;
+	this->embedding = nullptr;
+	this->_clearSweep();
+
+	shared_ptr<FEMSystem> fem = make_shared<FEMSystem>(particles_num, springs_num);
+	fem->setParticlesPositions(starting_positions);
+	fem->setSpringsConnections(starting_springs);
+	fem->setFaces(faces);
+	fem->setSpringsRestLengthsAsStartingLengths();
+
+	/* The masses are distributed by volume once the tetrahedra are known. */
+	fem->setParticlesMass(2.5f);
+	if (!fem->setTetrahedrons(tetrahedrons)) {
+		this->constructMesh(particles_num, springs_num, starting_positions, starting_springs, faces);
+		return;
+	}
+
+	//Passive myocardium is in the tens of kPa, nearly incompressible.
+	fem->setMaterial(30000.0f, 0.45f);
+	fem->setLoadMeshBoolVariable(true);
+	fem->setGravity(Vector3f(0.0f, 0.0f, 0.0f));
+
+	this->particleSys = fem;
+	this->setParticleSystemEnergyAttributes(0.9f);
+}
+
+
+bool MyGLWidget::constructVolumePreservation(const vector<unsigned int> &tetrahedrons, float bulk_modulus) {
+	if (!this->particleSys->setTetrahedrons(tetrahedrons))
+		return false;
+
+	this->particleSys->setBulkModulus(bulk_modulus);
+	return true;
+}
+
+
+bool MyGLWidget::constructActivationMap(const vector<Vector3f> &positions, const vector<Vector2f> &springs, const vector<unsigned int> &tetrahedrons,
+	float velocity, const string &cache_path) {
+	vector<unsigned int> sites = this->pacing_sites;
+	if (sites.empty() && !positions.empty()) {
+		size_t apex = 0;
+		for (size_t i = 1; i < positions.size(); i++)
+			if (positions[i].getY() < positions[apex].getY())
+				apex = i;
+		sites.push_back(static_cast<unsigned int>(apex));
+	}
+
+	ActivationMap map;
+	if (!map.buildCached(cache_path, positions, springs, tetrahedrons, sites, velocity))
+		return false;
+
+	vector<float> delays;
+	map.getEdgeTimes(springs, delays);
+
+	size_t body_count = std::max<size_t>(this->sweepSystems.size(), 1);
+	for (size_t i = 0; i < body_count; i++) {
+		ParticleSystem<float> &body = this->sweepSystems.empty() ? *this->particleSys : *this->sweepSystems[i];
+		if (!body.setSpringsDelays(delays))
+			return false;
+	}
+
+	std::cout << "Activation spreads over " << map.getLatestTime() * 1000.0f << " ms from " << sites.size() << " pacing sites." << endl;
+	return true;
+}
+
+
+bool MyGLWidget::constructFibers(const vector<Vector3f> &positions, const vector<Vector2f> &springs, const string &fiber_path) {
+	FiberField fibers;
+	bool loaded = fibers.load(fiber_path, positions.size());
+	if (!loaded)
+		fibers.buildRuleBased(positions, 60.0f, -60.0f);
+
+	/* Across the fibers the muscle is about half as stiff and hardly shortens. */
+	size_t body_count = std::max<size_t>(this->sweepSystems.size(), 1);
+	vector<float> stiffness, contraction;
+	for (size_t i = 0; i < body_count; i++) {
+		ParticleSystem<float> &body = this->sweepSystems.empty() ? *this->particleSys : *this->sweepSystems[i];
+		float along = body.getSpringsStiffness();
+		fibers.computeSpringAttributes(positions, springs, along, 0.5f * along, 1.0f, 0.2f, stiffness, contraction);
+		if (!body.setSpringsStiffnesses(stiffness) || !body.setSpringsContractions(contraction))
+			return false;
+	}
+
+	std::cout << (loaded ? "Fibers read from " + fiber_path : string("Rule based fibers")) << "." << endl;
+	return true;
+}
+
+
+bool MyGLWidget::constructRegionMaterials(const vector<unsigned int> &spring_regions, const vector<unsigned int> &particle_regions,
+	const vector<unsigned int> &tetrahedron_regions, const string &material_path) {
+	RegionMaterials materials;
+	if (spring_regions.empty() || !materials.load(material_path))
+		return false;
+
+	size_t body_count = std::max<size_t>(this->sweepSystems.size(), 1);
+	for (size_t i = 0; i < body_count; i++) {
+		ParticleSystem<float> &body = this->sweepSystems.empty() ? *this->particleSys : *this->sweepSystems[i];
+		if (!body.setRegionMaterials(materials, spring_regions, particle_regions, tetrahedron_regions))
+			return false;
+	}
+
+	std::cout << "Materials of " << materials.getRegionCount() << " regions read from " << material_path << "." << endl;
+	return true;
+}
+
+
+void MyGLWidget::setPacingSites(const vector<unsigned int> &sites) {
+	this->pacing_sites = sites;
+}
+
+
+void MyGLWidget::constructEmbeddedMesh(const vector<unsigned int> &tetrahedrons, const vector<Vector3f> &fine_positions, const vector<Vector3f> &fine_faces) {
+	vector<Vector3f> coarse_positions;
+	this->particleSys->getParticlesPositions(coarse_positions);
+
+	this->embedding = make_shared<EmbeddedMesh>();
+	if (!this->embedding->build(coarse_positions, tetrahedrons, fine_positions)) {
+		this->embedding = nullptr;
+		return;
+	}
+
+	/* A particle system without springs, it is never simulated and only carries the vertices, faces and normals. */
+	this->renderSys = make_shared< ParticleSystem<float> >(fine_positions.size(), 0);
+	this->renderSys->setParticlesPositions(this->embedding->getFittedPositions());
+	this->renderSys->setFaces(fine_faces);
+	this->renderSys->setLoadMeshBoolVariable(true);
+
+	std::cout << "Embedded " << this->embedding->getVertexCount() << " render vertices, "
+		<< this->embedding->getOutsideCount() << " of them outside the simulation mesh and extrapolated." << endl;
+}
+
+
+bool MyGLWidget::constructSweep(size_t body_count, float stiffness_min, float stiffness_max) {
+	if (body_count < 2 || !this->particleSys->hasSurface() || this->renderSys != nullptr)
+		return false;
+
+	//The bodies are copied as spring networks, a copy of a finite element mesh would lose its elements.
+	if (dynamic_pointer_cast<FEMSystem>(this->particleSys) != nullptr) {
+		cerr << "[MyGLWidget:constructSweep] Error: Finite element meshes can not be swept." << endl;
+		return false;
+	}
+
+	/* The bodies sit next to each other, one mesh extent plus a quarter apart. */
+	vector<Vector3f> positions;
+	this->particleSys->getParticlesPositions(positions);
+	Vector3f lower = positions[0];
+	Vector3f upper = positions[0];
+	for (size_t i = 1; i < positions.size(); i++) {
+		for (int c = 0; c < 3; c++) {
+			lower[c] = std::min(lower[c], positions[i][c]);
+			upper[c] = std::max(upper[c], positions[i][c]);
+		}
+	}
+	this->sweep_spacing = 1.25f * std::max(upper[0] - lower[0], upper[2] - lower[2]);
+
+	/* Body 0 is the current system, the others are copies of it made before it is put on the GPU. */
+	this->sweepSystems.resize(body_count);
+	this->sweepSystems[0] = this->particleSys;
+	for (size_t i = 1; i < body_count; i++)
+		this->sweepSystems[i] = make_shared< ParticleSystem<float> >(*this->particleSys);
+
+	for (size_t i = 0; i < body_count; i++) {
+		float stiffness = stiffness_min + (stiffness_max - stiffness_min) * i / (body_count - 1);
+		this->sweepSystems[i]->setSpringsStiffness(stiffness);
+		this->sweepSystems[i]->setSurfaceOnly(true);
+	}
+
+	std::cout << "Sweeping the stiffness from " << stiffness_min << " to " << stiffness_max << " over " << body_count << " bodies." << endl;
+	return true;
+}
+
+
 long double MyGLWidget::printSpringsAverageRestLength() {
 	long double springs_num = static_cast<long double>(this->particleSys->getSpringsCount());
 	long double average = this->particleSys->rest_length_sum / springs_num;
@@ -302,6 +550,112 @@ long double MyGLWidget::printSpringsAverageRestLength() {
 }
 
 
+void MyGLWidget::uploadParticleSystem() {
+	/* Called from the GUI slots as well, where the context is not necessarily current. */
+	this->makeCurrent();
+	this->particleSys->setShader(this->resources->getShader(PARTICLE_VERTEX_SHADER, PARTICLE_FRAGMENT_SHADER));
+	this->particleSys->setSurfaceShader(this->resources->getShader(SURFACE_VERTEX_SHADER, SURFACE_FRAGMENT_SHADER));
+
+	/*	All bodies of a sweep, the current system included, are drawn by the body renderer from the surface
+	*	vertices. The current system then gets no buffer of its own, so its steps upload nothing.	*/
+	if (!this->sweepSystems.empty()) {
+		this->particleSys->setSurfaceOnly(true);
+		this->body_renderer->setShader(this->resources->getShader(BODIES_VERTEX_SHADER, SURFACE_FRAGMENT_SHADER));
+		if (this->body_renderer->construct(*this->particleSys, this->sweepSystems.size()))
+			this->body_renderer->arrangeInGrid(this->sweep_spacing);
+		else
+			this->sweepSystems.clear();
+	}
+
+	if (this->sweepSystems.empty()) {
+		this->particleSys->constructOnGPU(*this->resources);
+		this->particleSys->setSurfaceOnly(this->is_surface_only);
+		this->particleSys->uploadVertices();
+	}
+
+	this->_setCavityPressure(this->diastolic_pressure);
+	this->volume_tracker.reset();
+
+	/* The render mesh has its own buffer and never uploads its interior vertices. */
+	if (this->renderSys != nullptr) {
+		this->renderSys->setShader(this->particleSys->getShader());
+		this->renderSys->setSurfaceShader(this->particleSys->getSurfaceShader());
+		this->renderSys->constructOnGPU(*this->resources, "EmbeddedMesh");
+		this->renderSys->setSurfaceOnly(true);
+		this->renderSys->uploadVertices();
+	}
+
+	/* Record the frame again for the new mesh. The old mesh's VAO is gone with its system. */
+	this->render_queue->clear();
+	this->grid->enqueue(*this->render_queue);
+	if (this->renderSys != nullptr)
+		this->renderSys->enqueue(*this->render_queue);
+	else if (this->sweepSystems.empty())
+		this->particleSys->enqueue(*this->render_queue);
+}
+
+
+void MyGLWidget::setSurfaceOnly(bool surface_only) {
+	this->is_surface_only = surface_only;
+
+	//The bodies of a sweep always stay in the surface layout of the body renderer.
+	if (!this->sweepSystems.empty())
+		return;
+
+	this->makeCurrent();
+	this->particleSys->setSurfaceOnly(surface_only);
+	this->particleSys->uploadVertices();
+}
+
+
+bool MyGLWidget::startCapture(const string& directory, size_t frames, bool quit_when_done) {
+	this->makeCurrent();
+	if (!this->capture->initialize(this->width(), this->height(), directory))
+		return false;
+
+	this->capture_frame_limit = frames;
+	this->quit_after_capture = quit_when_done;
+
+	/*	The heartbeat runs on simulation time, so an unattended capture may step as fast as it can.
+	*	It then waits for the encoders instead of dropping frames, every step ends up in the sequence.	*/
+	this->capture->setWaitForEncoders(quit_when_done);
+	if (quit_when_done)
+		this->timer->setInterval(0);
+	return true;
+}
+
+
+void MyGLWidget::stopCapture() {
+	if (!this->capture->isActive())
+		return;
+
+	this->makeCurrent();
+	this->capture->finish();
+	std::cout << "Captured " << this->capture->getCapturedCount() << " frames, dropped " << this->capture->getDroppedCount() << "." << endl;
+
+	if (this->quit_after_capture)
+		QCoreApplication::quit();
+}
+
+
+void MyGLWidget::_captureFrame() {
+	this->makeCurrent();
+	this->capture->bind();
+	this->paintGL();
+	this->capture->captureFrame();
+	this->capture->unbind();
+
+	//Only frames that are written count towards the limit.
+	if (this->capture_frame_limit > 0 && this->capture->getKeptCount() >= this->capture_frame_limit)
+		this->stopCapture();
+}
+
+
+void MyGLWidget::setShaderCacheDirectory(const string& directory) {
+	this->resources->setProgramCacheDirectory(directory);
+}
+
+
 void MyGLWidget::setHeartCharacteristics(float inc, float dec, float hi, float hd, float hr) {
 	this->heart_inc = inc;
 	this->heart_dec = dec;
@@ -312,16 +666,20 @@ void MyGLWidget::setHeartCharacteristics(float inc, float dec, float hi, float h
 
 
 void MyGLWidget::startHeartTimer() {
-	this->heart_rate_timer->setInterval((float)60 / this->heart_rate * (float)500);
-	this->heart_rate_timer->start();
+	this->scheduler.clear();
+	this->_scheduleBeat(this->simulation_time);
 }
 
 
 void MyGLWidget::stopHeartTimer() {
-	this->heart_rate_timer->stop();
+	this->volume_tracker.reset();
+	this->scheduler.clear();
+	this->beat_pending = false;
 	this->beats_count = 0;
 	this->pump_once = false;
-	this->heart_beated = false;
+	this->heart_beating = false;
+	this->_setActivation(1.0f, 0.0f);
+	this->_setCavityPressure(this->diastolic_pressure);
 }
 
 
@@ -331,26 +689,131 @@ void MyGLWidget::pumpOnce() {
 }
 
 
+ActivationWaveform& MyGLWidget::getHeartWaveform() {
+	return this->heart_waveform;
+}
+
+
+void MyGLWidget::setCavityPressures(float diastole, float systole) {
+	this->diastolic_pressure = diastole;
+	this->systolic_pressure = systole;
+	if (!this->heart_beating)
+		this->_setCavityPressure(diastole);
+}
+
+
+const CavityVolumeTracker& MyGLWidget::getCavityVolumes() const {
+	return this->volume_tracker;
+}
+
+
 void MyGLWidget::heartBeat() {
-	if (!this->heart_beated) {
-		if (is_homogeneous)
-			this->particleSys->addSpringsRestLengthHomogeneous(this->heart_homo_dec);
-		else
-			this->particleSys->addSpringsRestLength(this->heart_dec);
+	this->_startCycle(this->simulation_time);
+}
+
+
+void MyGLWidget::_endBeat() {
+	if (!this->volume_tracker.endBeat())
+		return;
+
+	/* The meshes are in millimetres, 1000 cubic millimetres are a millilitre. */
+	const BeatVolumes &beat = this->volume_tracker.getLastBeat();
+
+	//Without cavities the volume is the tissue itself, which says nothing about the blood ejected.
+	if (this->particleSys->getCavityCount() == 0) {
+		std::cout << "Beat " << this->volume_tracker.getBeatCount() << ": whole body volume " << beat.end_diastolic / 1000.0 << " ml to "
+			<< beat.end_systolic / 1000.0 << " ml, no cavities for an ejection fraction" << endl;
+		return;
+	}
+
+	std::cout << "Beat " << this->volume_tracker.getBeatCount() << ": EDV " << beat.end_diastolic / 1000.0 << " ml, ESV "
+		<< beat.end_systolic / 1000.0 << " ml, EF " << beat.ejection_fraction * 100.0 << " %" << endl;
+}
+
+
+void MyGLWidget::_startCycle(double time) {
+	this->_endBeat();
+	/* The steps follow the waveform from the simulation time the cycle started at. */
+	this->beat_start_time = time;
+	this->heart_beating = true;
+	this->beats_count++;
+}
+
+
+void MyGLWidget::_scheduleBeat(double time) {
+	this->beat_pending = true;
+	this->scheduler.schedule(time, [this](double beat_time) {
+		this->beat_pending = false;
+		this->_startCycle(beat_time);
+
+		/* Continuous mode keeps one beat pending, one heart period after this one. */
+		if (!this->pump_once)
+			this->_scheduleBeat(beat_time + 60.0 / this->heart_rate);
+	});
+}
+
+
+void MyGLWidget::_updateActivation() {
+	if (!this->heart_beating)
+		return;
+
+	/* Past the end of the cycle the heart rests until the next beat. Without one pending it stops there. */
+	float phase = static_cast<float>((this->simulation_time - this->beat_start_time) * this->heart_rate / 60.0);
+	if (phase >= 1.0f) {
+		phase = 1.0f;
+		if (!this->beat_pending) {
+			this->heart_beating = false;
+			this->pump_once = false;
+			this->_endBeat();
+		}
+	}
+
+	/*	The waveform blends between the diastole, the increase applied on top of the decrease, and the
+	*	systole, the decrease applied to the rest shape.	*/
+	float systole_scale = 1.0f, diastole_scale = 1.0f;
+	float systole_offset = 0.0f, diastole_offset = 0.0f;
+	if (is_homogeneous) {
+		systole_scale = homogeneousScale(this->heart_homo_dec);
+		diastole_scale = systole_scale * homogeneousScale(this->heart_homo_inc);
 	}
 	else {
-		if (is_homogeneous)
-			this->particleSys->addSpringsRestLengthHomogeneous(this->heart_homo_inc);
-		else
-			this->particleSys->addSpringsRestLength(this->heart_inc);
+		systole_offset = this->heart_dec;
+		diastole_offset = this->heart_dec + this->heart_inc;
 	}
-	
-	heart_beated = !heart_beated;
-	this->beats_count++;
 
-	if (this->pump_once)
-		if (this->beats_count == 2)
-			this->stopHeartTimer();
+	float level = this->heart_waveform.evaluate(phase);
+	this->_setActivation(diastole_scale + (systole_scale - diastole_scale) * level, diastole_offset + (systole_offset - diastole_offset) * level);
+	this->_setCavityPressure(this->diastolic_pressure + (this->systolic_pressure - this->diastolic_pressure) * level);
+}
+
+
+void MyGLWidget::_setActivation(float scale, float offset) {
+	/* Every body of a sweep beats the same way, only their stiffness differs. */
+	size_t body_count = std::max<size_t>(this->sweepSystems.size(), 1);
+	for (size_t i = 0; i < body_count; i++) {
+		ParticleSystem<float> &body = this->sweepSystems.empty() ? *this->particleSys : *this->sweepSystems[i];
+		body.setActivation(scale, offset);
+	}
+}
+
+
+void MyGLWidget::_setCavityPressure(float pressure) {
+	size_t body_count = std::max<size_t>(this->sweepSystems.size(), 1);
+	for (size_t i = 0; i < body_count; i++) {
+		ParticleSystem<float> &body = this->sweepSystems.empty() ? *this->particleSys : *this->sweepSystems[i];
+		body.setCavityPressure(pressure);
+	}
+}
+
+
+void MyGLWidget::_clearSweep() {
+	this->sweepSystems.clear();
+
+	/* Called from the GUI slots as well, where the context is not necessarily current. */
+	if (this->body_renderer->getBodyCount() > 0) {
+		this->makeCurrent();
+		this->body_renderer->release();
+	}
 }
 
 
@@ -405,6 +868,25 @@ void MyGLWidget::keyPressEvent(QKeyEvent* e) {
 
 
 void MyGLWidget::slotTimeout() {
+	this->scheduler.advance(this->simulation_time);
+	this->_updateActivation();
 	this->particleSys->updateParticleSystem(this->timeStep);
+	for (size_t i = 1; i < this->sweepSystems.size(); i++)
+		this->sweepSystems[i]->updateParticleSystem(this->timeStep);
+
+	this->simulation_time += this->timeStep;
+	if (this->heart_beating)
+		this->volume_tracker.addSample(this->particleSys->getCavityVolume());
+
+	for (size_t i = 0; i < this->sweepSystems.size(); i++)
+		this->body_renderer->updateBody(i, *this->sweepSystems[i]);
+
+	if (this->renderSys != nullptr)
+		this->renderSys->followEmbedding(*this->embedding, *this->particleSys);
+
+	/* Captured frames are rendered offscreen, independent of whether the widget is visible. */
+	if (this->capture->isActive())
+		this->_captureFrame();
+
 	this->updateGL();
 }
\ No newline at end of file
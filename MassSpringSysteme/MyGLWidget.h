@@ -2,12 +2,24 @@
 
 #include <gl/glew.h>
 #include "ParticleSystem.h"
+#include <FEMSystem.h>
+#include <ActivationWaveform.h>
+#include <EventScheduler.h>
+#include <ActivationMap.h>
+#include <FiberField.h>
+#include <RegionMaterials.h>
+#include <CavityVolumeTracker.h>
 #include <MouseCamera.h>
 #include <Matrix4.h>
 #include <QGLWidget>
 #include <QtOpenGL>
 #include <memory>
 #include <Grid.h>
+#include <ResourceManager.h>
+#include <EmbeddedMesh.h>
+#include <FrameCapture.h>
+#include <RenderQueue.h>
+#include <MultiBodyRenderer.h>
 
 class MyGLWidget : public QGLWidget, protected QGLFunctions {
 	Q_OBJECT
@@ -20,6 +32,7 @@ public:
 	void setTimerEnd();
 	inline void setParticleSystemGeneralAttributes(float particle_mass, float spring_rest_length, float spring_stiffness, Vector3f gravity);
 	void setParticleSystemEnergyAttributes(float bounce_energy_loss_ratio);
+	void setLinearDampingAttributes(float a, float b, float t, float k_max);
 	void setHomogeneous(bool is_homo);
 	bool getHomegeneous() const;
 
@@ -30,16 +43,84 @@ public:
 
 	//This function will load a mesh into the program and will be handled by this interface.
 	void constructMesh(size_t particle_num, size_t springs_num, vector<Vector3f> starting_positions, vector<Vector2f> starting_springs, vector<Vector3f> faces);
+
+	/*	Like constructMesh(), but the mesh is simulated as co-rotational finite elements over @tetrahedrons
+	*	instead of as a spring network. The springs are only drawn.	*/
+	void constructFEMMesh(size_t particle_num, size_t springs_num, vector<Vector3f> starting_positions, vector<Vector2f> starting_springs, vector<Vector3f> faces, const vector<unsigned int> &tetrahedrons);
 	long double printSpringsAverageRestLength();
 
+	/*	Resist volume change of the current spring mesh over its @tetrahedrons with @bulk_modulus. Call after
+	*	constructMesh(). Stiff moduli need smaller time steps, like stiff springs.	*/
+	bool constructVolumePreservation(const vector<unsigned int> &tetrahedrons, float bulk_modulus);
+
+	/*	Delay the contraction of every spring by the time the excitation, started at the pacing sites and
+	*	conducted at @velocity, takes to reach it. @positions, @springs, @tetrahedrons, the current mesh; the
+	*	wave is marched through the tetrahedra. @cache_path, the file the activation map is kept in between
+	*	runs, empty for none. Call after constructSweep().	*/
+	bool constructActivationMap(const vector<Vector3f> &positions, const vector<Vector2f> &springs, const vector<unsigned int> &tetrahedrons,
+		float velocity, const string &cache_path);
+
+	/*	Make the springs stiffer and more contractile along the muscle fibers. The fibers are read from
+	*	@fiber_path if it exists, otherwise they wind around the long axis by the usual helix rule. The
+	*	current stiffness of each body is the stiffness along the fibers. Call after constructSweep().	*/
+	bool constructFibers(const vector<Vector3f> &positions, const vector<Vector2f> &springs, const string &fiber_path);
+
+	/*	Give the tissue regions of the mesh their materials from @material_path. The regions are the TetGen
+	*	region attributes spread to the springs, particles and tetrahedra. Does nothing for meshes without
+	*	regions or without a material file. Call after constructFibers().	*/
+	bool constructRegionMaterials(const vector<unsigned int> &spring_regions, const vector<unsigned int> &particle_regions,
+		const vector<unsigned int> &tetrahedron_regions, const string &material_path);
+
+	//Particles the excitation starts at. Empty (the default) paces the apex, the lowest particle. Used by the next constructActivationMap().
+	void setPacingSites(const vector<unsigned int> &sites);
+
+	/*	Display a detailed surface mesh that follows the current (coarse) tetrahedral mesh instead of the
+	*	simulated one. Call after constructMesh() and before uploadParticleSystem().
+	*	@tetrahedrons, the tetrahedra of the current mesh. @fine_positions, @fine_faces, the render mesh.	*/
+	void constructEmbeddedMesh(const vector<unsigned int> &tetrahedrons, const vector<Vector3f> &fine_positions, const vector<Vector3f> &fine_faces);
+
+	/*	Simulate @body_count copies of the current mesh side by side, with the springs' stiffness spread evenly
+	*	from @stiffness_min to @stiffness_max. Needs a mesh with faces. Call after constructMesh() and before
+	*	uploadParticleSystem(). All bodies are drawn with one instanced call.	*/
+	bool constructSweep(size_t body_count, float stiffness_min, float stiffness_max);
+
+	//Hand the current particle system its program and vertex buffer from the resource cache. Call after any construct*() function.
+	void uploadParticleSystem();
+
+	//Enable the on-disk program binary cache. Must be called before the widget is shown.
+	void setShaderCacheDirectory(const string& directory);
+
+	//Skip interior particles and springs when drawing. Kept across mesh reloads.
+	void setSurfaceOnly(bool surface_only);
+
+	/*	Write every simulation step as a PNG into @directory, rendered offscreen at the widget's size.
+	*	@frames, stop after this many written frames (0 means until stopCapture()). @quit_when_done, exit the application
+	*	then; such a run waits for the encoders instead of dropping frames.	*/
+	bool startCapture(const string& directory, size_t frames = 0, bool quit_when_done = false);
+	void stopCapture();
+
 	/*	@inc, the increasement of the springs' rest length.
 	*	@dec, the decreasement of the springs' rest length.
 	*	@homo_inc, the homogeneous increasement for springs.	*/
 	void setHeartCharacteristics(float inc, float dec, float homo_inc, float homo_dec, float heart_rate);
+	/*	The heartbeat runs on simulation time: startHeartTimer() beats continuously, one cycle every
+	*	60 / heart_rate simulated seconds, pumpOnce() plays a single cycle.	*/
 	void startHeartTimer();
 	void stopHeartTimer();
 	void pumpOnce();
 
+	//The contraction over one cardiac cycle, followed by every step while the heart beats.
+	ActivationWaveform& getHeartWaveform();
+
+	/*	Blood pressure in the cavities of the mesh, following the waveform from @diastole at rest to @systole
+	*	at full contraction. Kept across mesh reloads. Meshes without inner surfaces ignore it.	*/
+	void setCavityPressures(float diastole, float systole);
+
+	/*	End diastolic and end systolic cavity volume and ejection fraction of every beat since the heart
+	*	was started on the current mesh, of body 0 in a sweep. Each beat is also printed when it ends.
+	*	For a mesh without cavities these are whole body volumes and the ejection fraction is meaningless.	*/
+	const CavityVolumeTracker& getCavityVolumes() const;
+
 	void mouseMoveEvent(QMouseEvent* e);
 	void mousePressEvent(QMouseEvent* e);
 	void mouseReleaseEvent(QMouseEvent* e);
@@ -47,11 +128,20 @@ public:
 
 public slots:
 	void slotTimeout();
+
+	//Start a single cardiac cycle at the current simulation time.
 	void heartBeat();
 
 public:
 	shared_ptr< ParticleSystem<float> > particleSys;
 
+	//Render only mesh driven by particleSys. Null unless constructEmbeddedMesh() was called for the current mesh.
+	shared_ptr< ParticleSystem<float> > renderSys;
+	shared_ptr<EmbeddedMesh> embedding;
+
+	//The bodies of a stiffness sweep, body 0 is particleSys. Empty unless constructSweep() was called for the current mesh.
+	vector< shared_ptr< ParticleSystem<float> > > sweepSystems;
+
 	//Line's info. The starting attributes of the particles. The info about the springs. Basically, this tells which particles are connected.
 	vector<Vector3f> starting_positions;
 	vector< vector<size_t> > starting_springs;
@@ -68,7 +158,7 @@ public:
 	float heart_homo_dec;
 	float heart_rate;
 
-	// Either a systole or a diastol is counted as a beat.
+	//Cardiac cycles started since the heartbeat was started.
 	size_t beats_count;
 	bool pump_once;
 
@@ -79,6 +169,14 @@ protected:
 
 protected:
 	shared_ptr<Grid> grid;
+
+	//Draw calls of the ground and the current mesh, recorded once per mesh.
+	shared_ptr<RenderQueue> render_queue;
+
+	//Draws all bodies of a sweep, sweep_spacing apart.
+	shared_ptr<MultiBodyRenderer> body_renderer;
+	float sweep_spacing;
+	shared_ptr<ResourceManager> resources;
 	shared_ptr<MouseCameraf> camera;
 	Matrix4f modelViewMatrix;
 	Matrix4f projectionMatrix;
@@ -88,9 +186,59 @@ protected:
 	QTimer *timer;
 	float timeStep;
 
-	QTimer *heart_rate_timer;
-	float heart_beated;
+	//Simulated seconds, advanced by timeStep in every step.
+	double simulation_time;
+
+	//Actions on simulation time, run before every step. Schedules the beats of the heart.
+	EventScheduler scheduler;
+
+	//The contraction over a cardiac cycle and the simulation time the current cycle started at.
+	ActivationWaveform heart_waveform;
+	double beat_start_time;
+	bool heart_beating;
+
+	//True while the next beat is scheduled, false in the last cycle of a single pump.
+	bool beat_pending;
+
+	vector<unsigned int> pacing_sites;
+
+	float diastolic_pressure;
+	float systolic_pressure;
+
+	//The cavity volume of every step while the heart beats, kept as the volumes of each beat.
+	CavityVolumeTracker volume_tracker;
 
 	//If it is false, it means using heterogeneous method.
 	bool is_homogeneous;
+
+	bool is_surface_only;
+
+	shared_ptr<FrameCapture> capture;
+	size_t capture_frame_limit;
+	bool quit_after_capture;
+
+protected:
+	//Render the current state into the capture framebuffer and queue it for encoding.
+	void _captureFrame();
+
+	//Set the rest length activation of every simulated body.
+	void _setActivation(float scale, float offset);
+
+	//Set the cavity pressure of every simulated body.
+	void _setCavityPressure(float pressure);
+
+	//Forget the bodies of a sweep and free their GPU buffers.
+	void _clearSweep();
+
+	//Set the activation of the current point of the cardiac cycle. Called before every step.
+	void _updateActivation();
+
+	//Close the beat of the volume tracker and print its volumes.
+	void _endBeat();
+
+	//Start a cardiac cycle at simulation time @time.
+	void _startCycle(double time);
+
+	//Schedule a beat at simulation time @time, which schedules the next one unless pumping once.
+	void _scheduleBeat(double time);
 };
\ No newline at end of file
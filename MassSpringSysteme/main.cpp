@@ -7,6 +7,54 @@ int main(int argc, char *argv[])
 {
 	QApplication a(argc, argv);
 	MassSpringSysteme w;
+
+	/* -shadercache <dir>: reuse linked program binaries between runs. */
+	QStringList args = a.arguments();
+	int cache_arg = args.indexOf("-shadercache");
+	if (cache_arg >= 0 && cache_arg + 1 < args.size())
+		w.setShaderCacheDirectory(args[cache_arg + 1].toStdString());
+
+	/* -pacing <i,j,...>: particles the excitation of the heart starts at, instead of the apex. */
+	int pacing_arg = args.indexOf("-pacing");
+	if (pacing_arg >= 0 && pacing_arg + 1 < args.size()) {
+		vector<unsigned int> sites;
+		QStringList indices = args[pacing_arg + 1].split(',', QString::SkipEmptyParts);
+		for (int i = 0; i < indices.size(); i++)
+			sites.push_back(indices[i].toUInt());
+		w.setPacingSites(sites);
+	}
+
+	/* -pressure <diastole,systole>: blood pressure in the cavities of meshes with inner surfaces. */
+	int pressure_arg = args.indexOf("-pressure");
+	if (pressure_arg >= 0 && pressure_arg + 1 < args.size()) {
+		QStringList pressures = args[pressure_arg + 1].split(',', QString::SkipEmptyParts);
+		if (pressures.size() == 2)
+			w.setCavityPressures(pressures[0].toFloat(), pressures[1].toFloat());
+	}
+
+	/*	-capture <dir> [-frames <n>] [-mesh <index>] [-headless]: write the animation as numbered PNGs.
+	*	-headless keeps the window off screen and quits after the last frame; use it with a software GL
+	*	(e.g. QT_QPA_PLATFORM=offscreen and Mesa llvmpipe) on machines without a display.	*/
+	bool headless = args.contains("-headless");
+	if (headless)
+		w.setAttribute(Qt::WA_DontShowOnScreen);
+
 	w.show();
+
+	int capture_arg = args.indexOf("-capture");
+	if (capture_arg >= 0 && capture_arg + 1 < args.size()) {
+		int frames_arg = args.indexOf("-frames");
+		int mesh_arg = args.indexOf("-mesh");
+		size_t frames = (frames_arg >= 0 && frames_arg + 1 < args.size()) ? args[frames_arg + 1].toUInt() : 0;
+		int mesh = (mesh_arg >= 0 && mesh_arg + 1 < args.size()) ? args[mesh_arg + 1].toInt() : -1;
+
+		//Without a frame limit a headless run would never end.
+		if (headless && frames == 0)
+			frames = 600;
+
+		if (!w.startCapture(args[capture_arg + 1].toStdString(), frames, mesh, headless) && headless)
+			return 1;
+	}
+
 	return a.exec();
 }
@@ -64,6 +64,36 @@ void MassSpringSysteme::updateHeartCharacteristics() {
 }
 
 
+void MassSpringSysteme::setShaderCacheDirectory(const string& directory) {
+	ui.glwidget->setShaderCacheDirectory(directory);
+}
+
+
+void MassSpringSysteme::setPacingSites(const vector<unsigned int>& sites) {
+	ui.glwidget->setPacingSites(sites);
+}
+
+
+void MassSpringSysteme::setCavityPressures(float diastole, float systole) {
+	ui.glwidget->setCavityPressures(diastole, systole);
+}
+
+
+bool MassSpringSysteme::startCapture(const string& directory, size_t frames, int mesh_index, bool quit_when_done) {
+	if (mesh_index >= 0 && mesh_index < ui.combo_box_load_mesh->count()) {
+		ui.combo_box_load_mesh->setCurrentIndex(mesh_index);
+		this->slotButtonLoad();
+	}
+
+	if (!ui.glwidget->startCapture(directory, frames, quit_when_done))
+		return false;
+
+	this->slotButtonStart();
+	this->slotPushButtonAnimate();
+	return true;
+}
+
+
 void MassSpringSysteme::slotButtonStart() {
 	ui.glwidget->setTimerStart();
 }
@@ -75,8 +105,7 @@ void MassSpringSysteme::slotButtonEnd() {
 
 void MassSpringSysteme::slotButtonLine() {
 	ui.glwidget->constructLine();
-	ui.glwidget->particleSys->loadShader("shaders/gridShader.vert", "shaders/gridShader.frag");
-	ui.glwidget->particleSys->constructOnGPU();
+	ui.glwidget->uploadParticleSystem();
 
 	this->setWidgetsValues();
 	ui.glwidget->updateGL();
@@ -85,8 +114,7 @@ void MassSpringSysteme::slotButtonLine() {
 
 void MassSpringSysteme::slotButtonTetrahedron() {
 	ui.glwidget->constructTetrahedron();
-	ui.glwidget->particleSys->loadShader("shaders/gridShader.vert", "shaders/gridShader.frag");
-	ui.glwidget->particleSys->constructOnGPU();
+	ui.glwidget->uploadParticleSystem();
 
 	this->setWidgetsValues();
 	ui.glwidget->updateGL();
@@ -95,8 +123,7 @@ void MassSpringSysteme::slotButtonTetrahedron() {
 
 void MassSpringSysteme::slotButtonCube() {
 	ui.glwidget->constructCube();
-	ui.glwidget->particleSys->loadShader("shaders/gridShader.vert", "shaders/gridShader.frag");
-	ui.glwidget->particleSys->constructOnGPU();
+	ui.glwidget->uploadParticleSystem();
 
 	this->setWidgetsValues();
 	ui.glwidget->updateGL();
@@ -105,6 +132,10 @@ void MassSpringSysteme::slotButtonCube() {
 
 void MassSpringSysteme::slotButtonLoad() {
 	int idx = ui.combo_box_load_mesh->currentIndex();
+	shared_ptr<LoadTetGenFiles> render_mesh;
+	size_t sweep_count = 0;
+	bool use_fem = false;
+	bool use_fibers = false;
 
 	switch (idx){
 	case 0:
@@ -121,24 +152,74 @@ void MassSpringSysteme::slotButtonLoad() {
 		this->tetGenObjs = make_shared<LoadTetGenFiles>("meshes/heart_simple/heart_simple.1.node", 
 														"meshes/heart_simple/heart_simple.1.ele", 
 														"meshes/heart_simple/heart_simple.1.face");
+		use_fibers = true;
 		break;
 	case 3:
 		this->tetGenObjs = make_shared<LoadTetGenFiles>("meshes/heart_simple/heart_simple_2.1.node", 
 														"meshes/heart_simple/heart_simple_2.1.ele", 
 														"meshes/heart_simple/heart_simple_2.1.face");
+		use_fibers = true;
 		break;
 	case 4:
 		this->tetGenObjs = make_shared<LoadTetGenFiles>("meshes/my_heart/my_heart.1.node",
 														"meshes/my_heart/my_heart.1.ele",
 														"meshes/my_heart/my_heart.1.face");
+		use_fibers = true;
+		break;
+	case 5:
+		/* Simulate the simple heart, display the real one. Only the surface of the real heart is needed. */
+		this->tetGenObjs = make_shared<LoadTetGenFiles>("meshes/heart_simple/heart_simple.1.node", 
+														"meshes/heart_simple/heart_simple.1.ele", 
+														"meshes/heart_simple/heart_simple.1.face");
+		render_mesh = make_shared<LoadTetGenFiles>("meshes/my_heart/my_heart.1.node",
+												   "meshes/my_heart/my_heart.1.face");
+		use_fibers = true;
+		break;
+	case 6:
+		/* Sixteen simple hearts, from soft to stiff. */
+		this->tetGenObjs = make_shared<LoadTetGenFiles>("meshes/heart_simple/heart_simple.1.node", 
+														"meshes/heart_simple/heart_simple.1.ele", 
+														"meshes/heart_simple/heart_simple.1.face");
+		sweep_count = 16;
+		use_fibers = true;
+		break;
+	case 7:
+		this->tetGenObjs = make_shared<LoadTetGenFiles>("meshes/my_heart/my_heart.1.node",
+														"meshes/my_heart/my_heart.1.ele",
+														"meshes/my_heart/my_heart.1.face");
+		use_fem = true;
 		break;
 	default:
 		break;
 	}
 
-	ui.glwidget->constructMesh(this->tetGenObjs->particles_num, this->tetGenObjs->springs_num, this->tetGenObjs->starting_positions, this->tetGenObjs->starting_springs, this->tetGenObjs->faces);
-	ui.glwidget->particleSys->loadShader("shaders/gridShader.vert", "shaders/gridShader.frag");
-	ui.glwidget->particleSys->constructOnGPU();
+	if (use_fem)
+		ui.glwidget->constructFEMMesh(this->tetGenObjs->particles_num, this->tetGenObjs->springs_num, this->tetGenObjs->starting_positions, this->tetGenObjs->starting_springs, this->tetGenObjs->faces, this->tetGenObjs->tetrahedrons);
+	else {
+		ui.glwidget->constructMesh(this->tetGenObjs->particles_num, this->tetGenObjs->springs_num, this->tetGenObjs->starting_positions, this->tetGenObjs->starting_springs, this->tetGenObjs->faces);
+		ui.glwidget->constructVolumePreservation(this->tetGenObjs->tetrahedrons, 100.0f);
+	}
+	if (render_mesh != nullptr)
+		ui.glwidget->constructEmbeddedMesh(this->tetGenObjs->tetrahedrons, render_mesh->starting_positions, render_mesh->faces);
+	if (sweep_count > 0)
+		ui.glwidget->constructSweep(sweep_count, 60.0f, 300.0f);
+
+	/* A fiber file next to the .node file, e.g. reconstructed from DT-MRI, replaces the helix rule. */
+	string mesh_base = this->tetGenObjs->node_file_name.substr(0, this->tetGenObjs->node_file_name.rfind('.'));
+	if (use_fibers)
+		ui.glwidget->constructFibers(this->tetGenObjs->starting_positions, this->tetGenObjs->starting_springs, mesh_base + ".fiber");
+
+	/* Meshes tagged with TetGen region attributes take their region materials from <mesh>.mat. */
+	if (!use_fem)
+		ui.glwidget->constructRegionMaterials(this->tetGenObjs->spring_regions, this->tetGenObjs->particle_regions, this->tetGenObjs->tetrahedron_regions, mesh_base + ".mat");
+
+	/* Conduction at 0.5 m/s, the meshes are in millimetres. The map is cached next to the .node file. */
+	if (!use_fem) {
+		ui.glwidget->constructActivationMap(this->tetGenObjs->starting_positions, this->tetGenObjs->starting_springs, this->tetGenObjs->tetrahedrons,
+			500.0f, mesh_base + ".act");
+	}
+
+	ui.glwidget->uploadParticleSystem();
 
 	this->setWidgetsValues();
 	ui.glwidget->updateGL();
@@ -165,7 +246,7 @@ void MassSpringSysteme::slotPushButtonUpdate() {
 
 	ui.glwidget->setParticleSystemGeneralAttributes((float)mass, (float)rc, (float)ks, Vector3f(0.0f, (float)gravity, 0.0f));
 	ui.glwidget->setParticleSystemEnergyAttributes((float)bel);
-	ui.glwidget->particleSys->setLinearDampingAttributes(a, b, t, k_max);
+	ui.glwidget->setLinearDampingAttributes(a, b, t, k_max);
 	ui.glwidget->updateGL();
 }
 
@@ -210,4 +291,10 @@ void MassSpringSysteme::slotActionSurfaceShading() {
 		ui.glwidget->particleSys->is_lines_shading = false;
 
 	ui.glwidget->updateGL();
+}
+
+
+void MassSpringSysteme::slotActionSurfaceOnly(bool checked) {
+	ui.glwidget->setSurfaceOnly(checked);
+	ui.glwidget->updateGL();
 }
\ No newline at end of file
@@ -15,6 +15,17 @@ public:
 
 	void setWidgetsValues();
 	void updateHeartCharacteristics();
+	void setShaderCacheDirectory(const string& directory);
+
+	//Particles the excitation starts at in the meshes loaded from now on.
+	void setPacingSites(const vector<unsigned int>& sites);
+
+	//Cavity blood pressure at rest and at full contraction.
+	void setCavityPressures(float diastole, float systole);
+
+	/*	Load mesh @mesh_index of the mesh list (-1 keeps the current one), start the simulation
+	*	and the heartbeat, and write @frames frames into @directory.	*/
+	bool startCapture(const string& directory, size_t frames, int mesh_index, bool quit_when_done);
 
 public:
 	shared_ptr<LoadTetGenFiles> tetGenObjs;
@@ -57,6 +68,8 @@ public slots:
 
 	void slotActionSurfaceShading();
 
+	void slotActionSurfaceOnly(bool checked);
+
 private:
 	Ui::MassSpringSystemeClass ui;
 };
@@ -0,0 +1,40 @@
+#version 330 
+#extension GL_ARB_explicit_attrib_location : require 
+
+/* One model matrix per body, the only vertex attribute. It takes the locations 0 to 3. */
+layout(location = 0) in mat4 bodyMatrix;
+
+/* The vertices of all bodies, body after body, as single floats in the layout of ParticleVertex. */
+uniform samplerBuffer bodyVertices;
+uniform int vertexCount;
+uniform int floatsPerVertex;
+
+/* Uniform variables for Camera */ 
+uniform mat4 modelViewMatrix;
+uniform mat4 projectionMatrix;
+
+out vec3 interpSurfaceNormal;
+out vec3 interpVertexPosition;
+out vec3 interpColor;
+
+vec3 fetchVector(int first) {
+	return vec3(texelFetch(bodyVertices, first).r, texelFetch(bodyVertices, first + 1).r, texelFetch(bodyVertices, first + 2).r);
+}
+
+void main(void) {
+	/* Position, color and normal come first, three floats each. gl_VertexID is the index read from the shared element buffer. */
+	int first = (gl_InstanceID * vertexCount + gl_VertexID) * floatsPerVertex;
+	vec3 position = fetchVector(first);
+	vec3 color = fetchVector(first + 3);
+	vec3 normal = fetchVector(first + 6);
+
+	mat4 bodyModelView = modelViewMatrix * bodyMatrix;
+	vec3 vertexPositionEye = vec3(bodyModelView * vec4(position, 1.0f));
+	interpVertexPosition = vertexPositionEye;
+
+	/* The bodies are only moved, so the upper 3x3 part still transforms the normals. */
+	interpSurfaceNormal = mat3(bodyModelView) * normal;
+	interpColor = color;
+
+	gl_Position = projectionMatrix * vec4(vertexPositionEye, 1.0f);
+}
\ No newline at end of file
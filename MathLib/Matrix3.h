@@ -30,6 +30,7 @@
 #include <cmath>
 #include <cstring>
 #include <type_traits>
+#include <stdexcept>
 #include <iomanip>
 
 #include "Vector3.h"
@@ -39,7 +40,7 @@ template <typename Real>
 class Matrix3;
 
 template <typename Real>
-std::ostream& operator << <> (std::ostream& out, const Matrix3<Real>& m);
+std::ostream& operator << (std::ostream& out, const Matrix3<Real>& m);
 
 /* 
  * Matrix3: Representation of any numerical 3x3 matrix.
@@ -48,7 +49,9 @@ std::ostream& operator << <> (std::ostream& out, const Matrix3<Real>& m);
  * [a21 a22 a23]
  * [a31 a32 a33]
  * 
- * This implementation also foregoes vectorization (SSE).
+ * This implementation also foregoes vectorization (SSE). Construction, element
+ * access, multiplication, transpose, determinant and inverse are constexpr, so a
+ * matrix built from constants is folded at compile time.
  * This implementation is aimed at a flexibility while preserving 
  * understandability and complete modularity.
  */
@@ -67,93 +70,95 @@ class Matrix3 {
                    A_13, A_23, A_33,
                    COMPONENT_COUNT };
 public:
-    Matrix3(bool identity = true);
-    Matrix3(const Real* const data);
-    Matrix3(const Matrix3<Real>& m);
-    Matrix3(Real a11, Real a12, Real a13, 
+    constexpr Matrix3(bool identity = true);
+    constexpr Matrix3(const Real* const data);
+    constexpr Matrix3(const Matrix3<Real>& m);
+    constexpr Matrix3(Real a11, Real a12, Real a13, 
             Real a21, Real a22, Real a23, 
             Real a31, Real a32, Real a33, bool colMajor = true);
-    ~Matrix3();
 
-    void set(const Matrix3<Real>& m);
-    void set(const Real* const data);
-    void set(std::size_t i, std::size_t j, Real value);
-    void set(Real a11, Real a12, Real a13, 
+    constexpr void set(const Matrix3<Real>& m);
+    constexpr void set(const Real* const data);
+    constexpr void set(std::size_t i, std::size_t j, Real value);
+    constexpr void set(Real a11, Real a12, Real a13, 
              Real a21, Real a22, Real a23, 
              Real a31, Real a32, Real a33, bool colMajor = true);
 
-    void setRow(std::size_t i, Real x, Real y, Real z);
-    void setRow(std::size_t i, const Vector3<Real>& row);
-    void setColumn(std::size_t i, Real x, Real y, Real z);
-    void setColumn(std::size_t i, const Vector3<Real>& column);
+    constexpr void setRow(std::size_t i, Real x, Real y, Real z);
+    constexpr void setRow(std::size_t i, const Vector3<Real>& row);
+    constexpr void setColumn(std::size_t i, Real x, Real y, Real z);
+    constexpr void setColumn(std::size_t i, const Vector3<Real>& column);
 
-    bool isZero(Real epsilon);
-    bool isIdentity(Real epsilon);
+    constexpr bool isZero(Real epsilon);
+    constexpr bool isIdentity(Real epsilon);
     bool isEquivalent(const Matrix3<Real>& m, Real epsilon);
 
-    void zero();
-    void transpose();
-    void identity();
+    constexpr void zero();
+    constexpr void transpose();
+    constexpr void identity();
 
     virtual void invert();
 
-    void clear(bool identity = true);
+    constexpr void clear(bool identity = true);
     void toRawMatrix(Real* const matrix, bool colMajor = true) const;
     void getData(Real* const matrix, bool colMajor = true) const;
-    
-    Real determinant() const;
-    Matrix3<Real> inverse() const;
-    Matrix3<Real> inversed() const;
-    Matrix3<Real> transposed() const;
+
+    constexpr Real determinant() const;
+    constexpr Matrix3<Real> inverse() const;
+    constexpr Matrix3<Real> inversed() const;
+    constexpr Matrix3<Real> transposed() const;
 
     template <typename RealCastType>
     Matrix3<RealCastType> cast();
 
-    Real& get(std::size_t i, std::size_t j);
-    const Real& get(std::size_t i, std::size_t j) const;
-    Vector3<Real> getRow(std::size_t i) const;
-    Vector3<Real> getColumn(std::size_t i) const;
+    constexpr Real& get(std::size_t i, std::size_t j);
+    constexpr const Real& get(std::size_t i, std::size_t j) const;
+    constexpr Vector3<Real> getRow(std::size_t i) const;
+    constexpr Vector3<Real> getColumn(std::size_t i) const;
 
-    Matrix3<Real> toTranspose() const;
-    Matrix3<Real> toInverse() const;
+    constexpr Matrix3<Real> toTranspose() const;
+    constexpr Matrix3<Real> toInverse() const;
     Matrix3<Real> apply(const Vector3<Real>& v, bool colMajor = true) const;
-    Vector3<Real> applyTo(const Vector3<Real>& v) const;
-	Vector4<Real> applyTo(const Vector4<Real>& v) const;
+    constexpr Vector3<Real> applyTo(const Vector3<Real>& v) const;
+	constexpr Vector4<Real> applyTo(const Vector4<Real>& v) const;
 
-    const Real* const constData() const;
-    operator const Real* const () const;
+    constexpr const Real* const constData() const;
+    constexpr operator const Real* const () const;
 
-    Real& operator () (std::size_t i, std::size_t j);
-    const Real& operator () (std::size_t i, std::size_t j) const;
+    constexpr Real& operator () (std::size_t i, std::size_t j);
+    constexpr const Real& operator () (std::size_t i, std::size_t j) const;
 
-    void set(unsigned int index, Real value);
-    Real get(unsigned int index);
+    constexpr void set(unsigned int index, Real value);
+    constexpr Real get(unsigned int index);
 
     friend std::ostream& operator << <> (std::ostream& out, const Matrix3<Real>& m);
 
-    bool operator == (const Matrix3<Real>& m);
-	bool operator != (const Matrix3<Real>& m);
+    constexpr bool operator == (const Matrix3<Real>& m);
+	constexpr bool operator != (const Matrix3<Real>& m);
 
-    Matrix3<Real>& operator = (const Matrix3<Real>& m);
-	Matrix3<Real>& operator = (const Real* data);
+    constexpr Matrix3<Real>& operator = (const Matrix3<Real>& m);
+	constexpr Matrix3<Real>& operator = (const Real* data);
 
-    Vector3<Real> operator * (const Vector3<Real>& v);
-	Matrix3<Real> operator * (const Matrix3<Real>& m);
-    Matrix3<Real>& operator *= (const Matrix3<Real>& m);
+    constexpr Vector3<Real> operator * (const Vector3<Real>& v);
+	constexpr Matrix3<Real> operator * (const Matrix3<Real>& m);
+    constexpr Matrix3<Real>& operator *= (const Matrix3<Real>& m);
 
     static void ToRawMatrix(const Matrix3<Real>& m, Real* const matrix, bool colMajor = true);
-    static void Clear(Matrix3<Real>& m);
-    static void Identity(Matrix3<Real>& m);
-    static void Zero(Matrix3<Real>& m);
-    static Real Determinant(const Matrix3<Real>& m);
-    static Matrix3<Real> Multiply(const Matrix3<Real>& a, const Matrix3<Real>& b);
-    static Matrix3<Real> Transpose(const Matrix3<Real>& m);
-    static Matrix3<Real> Inverse(const Matrix3<Real>& m);
+    static constexpr void Clear(Matrix3<Real>& m);
+    static constexpr void Identity(Matrix3<Real>& m);
+    static constexpr void Zero(Matrix3<Real>& m);
+    static constexpr Real Determinant(const Matrix3<Real>& m);
+    static constexpr Matrix3<Real> Multiply(const Matrix3<Real>& a, const Matrix3<Real>& b);
+    static constexpr Matrix3<Real> Transpose(const Matrix3<Real>& m);
+    static constexpr Matrix3<Real> Inverse(const Matrix3<Real>& m);
 
-    static Matrix3<Real> Zero();
-    static Matrix3<Real> Identity();
+    static constexpr Matrix3<Real> Zero();
+    static constexpr Matrix3<Real> Identity();
 
 protected:
+    /* std::swap is not constexpr. */
+    static constexpr void Swap(Real& a, Real& b);
+
 	const static int ROW_COUNT = 3;
 	const static int COL_COUNT = 3;
 
@@ -161,9 +166,7 @@ protected:
 };
 
 template <typename Real>
-Matrix3<Real>::Matrix3(bool identity) {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
-
+constexpr Matrix3<Real>::Matrix3(bool identity) : data() {
     if ( identity ) {
         this->data[A_11] = Real(1);
         this->data[A_22] = Real(1);
@@ -172,43 +175,40 @@ Matrix3<Real>::Matrix3(bool identity) {
 }
 
 template <typename Real>
-Matrix3<Real>::Matrix3(const Real* const data) {
-    std::memcpy(this->data, data, COMPONENT_COUNT * sizeof(Real));
+constexpr Matrix3<Real>::Matrix3(const Real* const data) : data() {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = data[i];
 }
 
 template <typename Real>
-Matrix3<Real>::Matrix3(const Matrix3<Real>& m) {
-    std::memcpy(this->data, m.data, COMPONENT_COUNT * sizeof(Real));
+constexpr Matrix3<Real>::Matrix3(const Matrix3<Real>& m) : data() {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = m.data[i];
 }
 
 template <typename Real>
-Matrix3<Real>::Matrix3(Real a11, Real a12, Real a13, Real a21, Real a22, Real a23, Real a31, Real a32, Real a33, bool colMajor) {
+constexpr Matrix3<Real>::Matrix3(Real a11, Real a12, Real a13, Real a21, Real a22, Real a23, Real a31, Real a32, Real a33, bool colMajor) : data() {
     this->set(a11, a12, a13, a21, a22, a23, a31, a32, a33, colMajor);
 }
 
 template <typename Real>
-Matrix3<Real>::~Matrix3() {}
-
-template <typename Real>
-void Matrix3<Real>::set(const Matrix3<Real>& m) {
-    std::memcpy(this->data, m.data, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix3<Real>::set(const Matrix3<Real>& m) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = m.data[i];
 }
 
 template <typename Real>
-void Matrix3<Real>::set(const Real* const data) {
-    std::memcpy(this->data, data, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix3<Real>::set(const Real* const data) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = data[i];
 }
 
 template <typename Real>
-void Matrix3<Real>::set(std::size_t i, std::size_t j, Real value) {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix3:set] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix3:set] Index j out of bounds.");
+constexpr void Matrix3<Real>::set(std::size_t i, std::size_t j, Real value) {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix3:set] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix3:set] Index j out of bounds.");
 
     this->data[i * ROW_COUNT + j] = value;
 }
 
 template <typename Real>
-void Matrix3<Real>::set(Real a11, Real a12, Real a13, Real a21, Real a22, Real a23, Real a31, Real a32, Real a33, bool colMajor) {
+constexpr void Matrix3<Real>::set(Real a11, Real a12, Real a13, Real a21, Real a22, Real a23, Real a31, Real a32, Real a33, bool colMajor) {
     this->data[A_11] = a11;
     this->data[A_22] = a22;
     this->data[A_33] = a33;
@@ -232,8 +232,8 @@ void Matrix3<Real>::set(Real a11, Real a12, Real a13, Real a21, Real a22, Real a
 }
 
 template <typename Real>
-void Matrix3<Real>::setColumn(std::size_t i, Real x, Real y, Real z) {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix3:setRow] Error: Row index out of bounds.");
+constexpr void Matrix3<Real>::setColumn(std::size_t i, Real x, Real y, Real z) {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix3:setRow] Error: Row index out of bounds.");
 
     if ( i == 0 ) {
         this->data[A_11] = x;
@@ -255,13 +255,13 @@ void Matrix3<Real>::setColumn(std::size_t i, Real x, Real y, Real z) {
 }
 
 template <typename Real>
-void Matrix3<Real>::setRow(std::size_t i, const Vector3<Real>& row) {
+constexpr void Matrix3<Real>::setRow(std::size_t i, const Vector3<Real>& row) {
     this->setRow(i, row.x(), row.y(), row.z());
 }
 
 template <typename Real>
-void Matrix3<Real>::setRow(std::size_t i, Real x, Real y, Real z) {
-    if ( i >= COL_COUNT ) throw std::exception("[Matrix3:getColumn] Error: Column index out of bounds.");
+constexpr void Matrix3<Real>::setRow(std::size_t i, Real x, Real y, Real z) {
+    if ( i >= COL_COUNT ) throw std::out_of_range("[Matrix3:getColumn] Error: Column index out of bounds.");
 
     if ( i == 0 ) {
         this->data[A_11] = x;
@@ -283,12 +283,12 @@ void Matrix3<Real>::setRow(std::size_t i, Real x, Real y, Real z) {
 }
 
 template <typename Real>
-void Matrix3<Real>::setColumn(std::size_t i, const Vector3<Real>& column) {
+constexpr void Matrix3<Real>::setColumn(std::size_t i, const Vector3<Real>& column) {
     this->setColumn(i, column.x(), column.y(), column.z());
 }
 
 template <typename Real>
-bool Matrix3<Real>::isZero(Real epsilon) {
+constexpr bool Matrix3<Real>::isZero(Real epsilon) {
     for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) {
         Real value = this->data[i];
 
@@ -299,7 +299,7 @@ bool Matrix3<Real>::isZero(Real epsilon) {
 }
 
 template <typename Real>
-bool Matrix3<Real>::isIdentity(Real epsilon) {
+constexpr bool Matrix3<Real>::isIdentity(Real epsilon) {
     if ( this->data[A_11] < Real(1) - epsilon || this->data[A_11] > Real(1) + epsilon ) return false;
     if ( this->data[A_22] < Real(1) - epsilon || this->data[A_22] > Real(1) + epsilon ) return false;
     if ( this->data[A_33] < Real(1) - epsilon || this->data[A_33] > Real(1) + epsilon ) return false;
@@ -344,20 +344,20 @@ bool Matrix3<Real>::isEquivalent(const Matrix3<Real>& m, Real epsilon) {
 }
 
 template <typename Real>
-void Matrix3<Real>::zero() {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix3<Real>::zero() {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = Real(0);
 }
 
 template <typename Real>
-void Matrix3<Real>::transpose() {
-    std::swap(this->data[A_12], this->data[A_21]);
-    std::swap(this->data[A_13], this->data[A_31]);
-    std::swap(this->data[A_23], this->data[A_32]);
+constexpr void Matrix3<Real>::transpose() {
+    Swap(this->data[A_12], this->data[A_21]);
+    Swap(this->data[A_13], this->data[A_31]);
+    Swap(this->data[A_23], this->data[A_32]);
 }
 
 template <typename Real>
-void Matrix3<Real>::identity() {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix3<Real>::identity() {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = Real(0);
     this->data[A_11] = Real(1);
     this->data[A_22] = Real(1);
     this->data[A_33] = Real(1);
@@ -366,12 +366,12 @@ void Matrix3<Real>::identity() {
 template <typename Real>
 void Matrix3<Real>::invert() {
     Matrix3<Real> inverse = Matrix3<Real>::Inverse(*this);
-    std::memcpy(this->data, inverse.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = inverse.data[i];
 }
 
 template <typename Real>
-void Matrix3<Real>::clear(bool identity) {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix3<Real>::clear(bool identity) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = Real(0);
 
     if ( identity ) {
         this->data[A_11] = Real(1);
@@ -385,7 +385,7 @@ void Matrix3<Real>::toRawMatrix(Real* const matrix, bool colMajor) const {
     if ( nullptr == matrix ) return;
     Matrix3<Real> result = (*this);
     if ( colMajor == false ) result.transpose();
-    std::memcpy(matrix, result.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) matrix[i] = result.data[i];
 }
 
 template <typename Real>
@@ -394,22 +394,22 @@ void Matrix3<Real>::getData(Real* const matrix, bool colMajor) const {
 }
 
 template <typename Real>
-Real Matrix3<Real>::determinant() const {
+constexpr Real Matrix3<Real>::determinant() const {
     return Matrix3<Real>::Determinant(*this);
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::inverse() const {
+constexpr Matrix3<Real> Matrix3<Real>::inverse() const {
     return Matrix3<Real>::Inverse(*this);
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::inversed() const {
+constexpr Matrix3<Real> Matrix3<Real>::inversed() const {
     return Matrix3<Real>::Inverse(*this);
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::transposed() const {
+constexpr Matrix3<Real> Matrix3<Real>::transposed() const {
     return Matrix3<Real>::Transpose(*this);
 }
 
@@ -423,45 +423,45 @@ Matrix3<RealCastType> Matrix3<Real>::cast() {
 }
 
 template <typename Real>
-Real& Matrix3<Real>::get(std::size_t i, std::size_t j) {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix3:get] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix3:get] Index j out of bounds.");
+constexpr Real& Matrix3<Real>::get(std::size_t i, std::size_t j) {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix3:get] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix3:get] Index j out of bounds.");
 
-    return this->data[i * ROW_SIZE + j];
+    return this->data[i * ROW_COUNT + j];
 }
 
 template <typename Real>
-const Real& Matrix3<Real>::get(std::size_t i, std::size_t j) const {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix3:get] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix3:get] Index j out of bounds.");
+constexpr const Real& Matrix3<Real>::get(std::size_t i, std::size_t j) const {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix3:get] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix3:get] Index j out of bounds.");
 
-    return this->data[i * ROW_SIZE + j];
+    return this->data[i * ROW_COUNT + j];
 }
 
 template <typename Real>
-Vector3<Real> Matrix3<Real>::getRow(std::size_t i) const {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix3:getRow] Error: Row index out of bounds.");
+constexpr Vector3<Real> Matrix3<Real>::getRow(std::size_t i) const {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix3:getRow] Error: Row index out of bounds.");
     if ( i == 0 ) return Vector3<Real>(this->data[A_11], this->data[A_12], this->data[A_13]);
     if ( i == 1 ) return Vector3<Real>(this->data[A_21], this->data[A_22], this->data[A_23]);
     if ( i == 2 ) return Vector3<Real>(this->data[A_31], this->data[A_32], this->data[A_33]);
 }
 
 template <typename Real>
-Vector3<Real> Matrix3<Real>::getColumn(std::size_t i) const {
-    if ( i >= COL_COUNT ) throw std::exception("[Matrix3:getColumn] Error: Column index out of bounds.");
+constexpr Vector3<Real> Matrix3<Real>::getColumn(std::size_t i) const {
+    if ( i >= COL_COUNT ) throw std::out_of_range("[Matrix3:getColumn] Error: Column index out of bounds.");
     if ( i == 0 ) return Vector3<Real>(this->data[A_11], this->data[A_21], this->data[A_31]);
     if ( i == 1 ) return Vector3<Real>(this->data[A_12], this->data[A_22], this->data[A_32]);
     if ( i == 2 ) return Vector3<Real>(this->data[A_13], this->data[A_23], this->data[A_33]);
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::toTranspose() const {
+constexpr Matrix3<Real> Matrix3<Real>::toTranspose() const {
     Matrix3<Real> result = (*this);
     return Matrix3<Real>::Transpose(result);
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::toInverse() const {
+constexpr Matrix3<Real> Matrix3<Real>::toInverse() const {
     Matrix3<Real> result = (*this);
     return Matrix3<Real>::Inverse(result);
 }
@@ -478,7 +478,7 @@ Matrix3<Real> Matrix3<Real>::apply(const Vector3<Real>& v, bool colMajor) const
 }
 
 template <typename Real>
-Vector3<Real> Matrix3<Real>::applyTo(const Vector3<Real>& v) const {
+constexpr Vector3<Real> Matrix3<Real>::applyTo(const Vector3<Real>& v) const {
     Vector3<Real> result;
     result.x() = this->data[A_11] * v.x() + this->data[A_12] * v.y() + this->data[A_13] * v.z();
     result.y() = this->data[A_21] * v.x() + this->data[A_22] * v.y() + this->data[A_23] * v.z();
@@ -487,7 +487,7 @@ Vector3<Real> Matrix3<Real>::applyTo(const Vector3<Real>& v) const {
 }
 
 template <typename Real>
-Vector4<Real> Matrix3<Real>::applyTo(const Vector4<Real>& v) const {
+constexpr Vector4<Real> Matrix3<Real>::applyTo(const Vector4<Real>& v) const {
     Vector4<Real> result;
     result.x() = this->data[A_11] * v.x() + this->data[A_12] * v.y() + this->data[A_13] * v.z();
     result.y() = this->data[A_21] * v.x() + this->data[A_22] * v.y() + this->data[A_23] * v.z();
@@ -497,40 +497,40 @@ Vector4<Real> Matrix3<Real>::applyTo(const Vector4<Real>& v) const {
 }
 
 template <typename Real>
-const Real* const Matrix3<Real>::constData() const {
+constexpr const Real* const Matrix3<Real>::constData() const {
     return this->data;
 }
 
 template <typename Real>
-Matrix3<Real>::operator const Real* const () const {
+constexpr Matrix3<Real>::operator const Real* const () const {
     return this->data;
 }
 
 template <typename Real>
-Real& Matrix3<Real>::operator () (std::size_t i, std::size_t j) {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix3:()] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix3:()] Index j out of bounds.");
+constexpr Real& Matrix3<Real>::operator () (std::size_t i, std::size_t j) {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix3:()] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix3:()] Index j out of bounds.");
 
     return this->data[i * ROW_COUNT + j];
 }
 
 template <typename Real>
-const Real& Matrix3<Real>::operator () (std::size_t i, std::size_t j) const {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix3:()] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix3:()] Index j out of bounds.");
+constexpr const Real& Matrix3<Real>::operator () (std::size_t i, std::size_t j) const {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix3:()] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix3:()] Index j out of bounds.");
 
     return this->data[i * ROW_COUNT + j];
 }
 
 template <typename Real>
-void Matrix3<Real>::set(unsigned int index, Real value) {
-    if ( index >= COMPONENT_COUNT ) throw std::exception("[Matrix3:set] Index out of bounds.");
+constexpr void Matrix3<Real>::set(unsigned int index, Real value) {
+    if ( index >= COMPONENT_COUNT ) throw std::out_of_range("[Matrix3:set] Index out of bounds.");
     this->data[index] = value;
 }
 
 template <typename Real>
-Real Matrix3<Real>::get(unsigned int index) {
-    if ( index >= COMPONENT_COUNT ) throw std::exception("[Matrix3:get] Index out of bounds.");
+constexpr Real Matrix3<Real>::get(unsigned int index) {
+    if ( index >= COMPONENT_COUNT ) throw std::out_of_range("[Matrix3:get] Index out of bounds.");
     return this->data[index];
 }
 
@@ -544,45 +544,45 @@ std::ostream& operator << (std::ostream& out, const Matrix3<Real>& m) {
 }
 
 template <typename Real>
-bool Matrix3<Real>::operator == (const Matrix3<Real>& m) {
+constexpr bool Matrix3<Real>::operator == (const Matrix3<Real>& m) {
     for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ )
         if ( this->data[i] != m.data[i] ) return false;
     return true;
 }
 
 template <typename Real>
-bool Matrix3<Real>::operator != (const Matrix3<Real>& m) {
+constexpr bool Matrix3<Real>::operator != (const Matrix3<Real>& m) {
     return !(*this == m);
 }
 
 template <typename Real>
-Matrix3<Real>& Matrix3<Real>::operator = (const Matrix3<Real>& m) {
+constexpr Matrix3<Real>& Matrix3<Real>::operator = (const Matrix3<Real>& m) {
     if ( this == &m ) return *this;
-    std::memcpy(this->data, m.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = m.data[i];
     return *this;
 }
 
 template <typename Real>
-Matrix3<Real>& Matrix3<Real>::operator = (const Real* data) {
+constexpr Matrix3<Real>& Matrix3<Real>::operator = (const Real* data) {
     if ( nullptr == data ) return *this;
-    std::memcpy(this->data, data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = data[i];
     return *this;
 }
 
 template <typename Real>
-Vector3<Real> Matrix3<Real>::operator * (const Vector3<Real>& v) {
+constexpr Vector3<Real> Matrix3<Real>::operator * (const Vector3<Real>& v) {
     return this->applyTo(v);
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::operator * (const Matrix3<Real>& m) {
+constexpr Matrix3<Real> Matrix3<Real>::operator * (const Matrix3<Real>& m) {
     return Matrix3<Real>::Multiply(*this, m);
 }
 
 template <typename Real>
-Matrix3<Real>& Matrix3<Real>::operator *= (const Matrix3<Real>& m) {
+constexpr Matrix3<Real>& Matrix3<Real>::operator *= (const Matrix3<Real>& m) {
     Matrix3<Real> result = Matrix3<Real>::Multiply(*this, m);
-    std::memcpy(this->data, result.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = result.data[i];
     return *this;
 }
 
@@ -595,26 +595,29 @@ void Matrix3<Real>::ToRawMatrix(const Matrix3<Real>& m, Real* const matrix, bool
 
     Matrix3<Real> result = m;
     if ( colMajor == false ) result.transpose();
-    std::memcpy(matrix, result.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) matrix[i] = result.data[i];
 }
 
 template <typename Real>
-void Matrix3<Real>::Clear(Matrix3<Real>& m) {
-    std::memset(m.data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix3<Real>::Clear(Matrix3<Real>& m) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) m.data[i] = Real(0);
 }
 
 template <typename Real>
-void Matrix3<Real>::Identity(Matrix3<Real>& m) {
-    std::memset(m.data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix3<Real>::Identity(Matrix3<Real>& m) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) m.data[i] = Real(0);
+    m.data[A_11] = Real(1);
+    m.data[A_22] = Real(1);
+    m.data[A_33] = Real(1);
 }
 
 template <typename Real>
-void Matrix3<Real>::Zero(Matrix3<Real>& m) {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix3<Real>::Zero(Matrix3<Real>& m) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) m.data[i] = Real(0);
 }
 
 template <typename Real>
-Real Matrix3<Real>::Determinant(const Matrix3<Real>& m) {
+constexpr Real Matrix3<Real>::Determinant(const Matrix3<Real>& m) {
     Real d = 0.0;
     for ( unsigned int i = 0; i < ROW_COUNT; i++ ) {
         d += (m(0, i) * (m(1, (i+1)%3) * m(2, (i+2)%3) - m(1, (i+2)%3) * m(2, (i+1)%3)));
@@ -625,7 +628,7 @@ Real Matrix3<Real>::Determinant(const Matrix3<Real>& m) {
 
 /* Memory friendly matrix multiplication (Gita A., Lan V.) */
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::Multiply(const Matrix3<Real>& a, const Matrix3<Real>& b) {
+constexpr Matrix3<Real> Matrix3<Real>::Multiply(const Matrix3<Real>& a, const Matrix3<Real>& b) {
     Matrix3<Real> result(false);
 
     for ( unsigned int i = 0; i < ROW_COUNT; i++ )
@@ -636,22 +639,22 @@ Matrix3<Real> Matrix3<Real>::Multiply(const Matrix3<Real>& a, const Matrix3<Real
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::Transpose(const Matrix3<Real>& m) {
+constexpr Matrix3<Real> Matrix3<Real>::Transpose(const Matrix3<Real>& m) {
     Matrix3<Real> result = m;
-    std::swap(result.data[A_12], result.data[A_21]);
-    std::swap(result.data[A_13], result.data[A_31]);
-    std::swap(result.data[A_23], result.data[A_32]);
+    Swap(result.data[A_12], result.data[A_21]);
+    Swap(result.data[A_13], result.data[A_31]);
+    Swap(result.data[A_23], result.data[A_32]);
     return result;
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::Inverse(const Matrix3<Real>& m) {
+constexpr Matrix3<Real> Matrix3<Real>::Inverse(const Matrix3<Real>& m) {
     Matrix3<Real> result;
     Real d = Matrix3<Real>::Determinant(m);
 
     for ( unsigned int i = 0; i < ROW_COUNT; i++ ) {
         for ( unsigned int j = 0; j < COL_COUNT; j++ ) {
-            result(i, j) = ((m((i+1) % 3, (j+1) % 3) * m((i+2) % 3, (j+2) % 3)) - 
+            result(j, i) = ((m((i+1) % 3, (j+1) % 3) * m((i+2) % 3, (j+2) % 3)) - 
                             (m((i+1) % 3, (j+2) % 3) * m((i+2) % 3, (j+1) % 3))) / d;
         }
     }
@@ -660,15 +663,22 @@ Matrix3<Real> Matrix3<Real>::Inverse(const Matrix3<Real>& m) {
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::Zero() {
+constexpr Matrix3<Real> Matrix3<Real>::Zero() {
     return Matrix3<Real>(false);
 }
 
 template <typename Real>
-Matrix3<Real> Matrix3<Real>::Identity() {
+constexpr Matrix3<Real> Matrix3<Real>::Identity() {
     return Matrix3<Real>(true);
 }
 
+template <typename Real>
+constexpr void Matrix3<Real>::Swap(Real& a, Real& b) {
+    Real t = a;
+    a = b;
+    b = t;
+}
+
 typedef Matrix3<float> Matrix3f;
 typedef Matrix3<double> Matrix3d;
 typedef Matrix3<long> Matrix3l;
@@ -683,4 +693,12 @@ typedef Matrix3<short> Mat3s;
 
 typedef Matrix3<float> Mat3;
 
+/* Compile time checks: these only compile while the functions stay constexpr. The inverse of a determinant -4 matrix is exact. */
+static_assert(Matrix3<double>::Determinant(Matrix3<double>(2, 1, 0, 1, 1, 3, 0, 1, 2, false)) == -4.0,
+    "[Matrix3:Determinant] Error: Not folded at compile time.");
+static_assert(Matrix3<double>::Multiply(Matrix3<double>(2, 1, 0, 1, 1, 3, 0, 1, 2, false), Matrix3<double>::Inverse(Matrix3<double>(2, 1, 0, 1, 1, 3, 0, 1, 2, false))) == Matrix3<double>::Identity(),
+    "[Matrix3:Inverse] Error: A * Inverse(A) is not the identity.");
+static_assert(Matrix3<double>::Transpose(Matrix3<double>(1, 2, 3, 4, 5, 6, 7, 8, 9, false)) == Matrix3<double>(1, 4, 7, 2, 5, 8, 3, 6, 9, false),
+    "[Matrix3:Transpose] Error: Not folded at compile time.");
+
 #endif
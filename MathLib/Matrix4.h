@@ -29,6 +29,7 @@
 #include <iostream>
 #include <cmath>
 #include <type_traits>
+#include <stdexcept>
 
 #include "Matrix3.h"
 #include "Vector3.h"
@@ -38,7 +39,7 @@ template <typename Real>
 class Matrix4;
 
 template <typename Real>
-std::ostream& operator << <> (std::ostream& out, const Matrix4<Real>& m);
+std::ostream& operator << (std::ostream& out, const Matrix4<Real>& m);
 
 /* 
  * Matrix4: Representation of any numerical 4x4 matrix.
@@ -63,66 +64,65 @@ class Matrix4 {
                    A_14, A_24, A_34, A_44,
                    COMPONENT_COUNT };
 public:
-    Matrix4(bool identity = true);
-    Matrix4(const Real* const data);
-    Matrix4(const Matrix3<Real>& m, bool homogeneous = true);
-    Matrix4(const Matrix4<Real>& m);
-    Matrix4(Real a11, Real a12, Real a13, Real a14,
+    constexpr Matrix4(bool identity = true);
+    constexpr Matrix4(const Real* const data);
+    constexpr Matrix4(const Matrix3<Real>& m, bool homogeneous = true);
+    constexpr Matrix4(const Matrix4<Real>& m);
+    constexpr Matrix4(Real a11, Real a12, Real a13, Real a14,
             Real a21, Real a22, Real a23, Real a24,
             Real a31, Real a32, Real a33, Real a34,
             Real a41, Real a42, Real a43, Real a44, bool colMajor = true);
-    ~Matrix4();
 
-    void set(const Matrix3<Real>& m, bool homogeneous = true);
-    void set(const Matrix4<Real>& m);
-    void set(const Real* const data);
-    void set(std::size_t i, std::size_t j, Real value);
-    void set(Real a11, Real a12, Real a13, Real a14,
+    constexpr void set(const Matrix3<Real>& m, bool homogeneous = true);
+    constexpr void set(const Matrix4<Real>& m);
+    constexpr void set(const Real* const data);
+    constexpr void set(std::size_t i, std::size_t j, Real value);
+    constexpr void set(Real a11, Real a12, Real a13, Real a14,
              Real a21, Real a22, Real a23, Real a24,
              Real a31, Real a32, Real a33, Real a34,
              Real a41, Real a42, Real a43, Real a44, bool colMajor = true);
 
-    void setRow(std::size_t i, Real w, Real x, Real y, Real z);
-    void setRow(std::size_t i, const Vector4<Real>& row);
-    void setColumn(std::size_t i, Real w, Real x, Real y, Real z);
-    void setColumn(std::size_t i, const Vector4<Real>& column);
+    constexpr void setRow(std::size_t i, Real w, Real x, Real y, Real z);
+    constexpr void setRow(std::size_t i, const Vector4<Real>& row);
+    constexpr void setColumn(std::size_t i, Real w, Real x, Real y, Real z);
+    constexpr void setColumn(std::size_t i, const Vector4<Real>& column);
 
-    bool isZero(Real epsilon);
-    bool isIdentity(Real epsilon);
+    constexpr bool isZero(Real epsilon);
+    constexpr bool isIdentity(Real epsilon);
     bool isEquivalent(const Matrix4<Real>& m, Real epsilon);
 
-    void zero();
-    void transpose();
-    void identity();
+    constexpr void zero();
+    constexpr void transpose();
+    constexpr void identity();
 
     void invert();
 
-    void clear(bool identity = true);
+    constexpr void clear(bool identity = true);
     void toRawMatrix(Real* const matrix, bool colMajor = true) const;
     void getData(Real* const matrix, bool colMajor = true) const;
 
-    Real determinant() const;
-    Matrix4<Real> inverse() const;
-    Matrix4<Real> inversed() const;
-    Matrix4<Real> transposed() const;
+    constexpr Real determinant() const;
+    constexpr Matrix4<Real> inverse() const;
+    constexpr Matrix4<Real> inversed() const;
+    constexpr Matrix4<Real> transposed() const;
 
     template <typename RealCastType>
     Matrix4<RealCastType> cast();
 
-    Real& get(std::size_t i, std::size_t j);
-    const Real& get(std::size_t i, std::size_t j) const;
-    Vector4<Real> getRow(std::size_t i) const;
-    Vector4<Real> getColumn(std::size_t i) const;
+    constexpr Real& get(std::size_t i, std::size_t j);
+    constexpr const Real& get(std::size_t i, std::size_t j) const;
+    constexpr Vector4<Real> getRow(std::size_t i) const;
+    constexpr Vector4<Real> getColumn(std::size_t i) const;
 
-    Matrix4<Real> toTranspose() const;
-    Matrix4<Real> toInverse() const;
+    constexpr Matrix4<Real> toTranspose() const;
+    constexpr Matrix4<Real> toInverse() const;
     Matrix4<Real> apply(const Vector3<Real>& v, bool colMajor = true) const;
     Matrix4<Real> apply(const Vector4<Real>& v, bool colMajor = true) const;
-    Vector3<Real> applyTo(const Vector3<Real>& v) const;
-	Vector4<Real> applyTo(const Vector4<Real>& v) const;
+    constexpr Vector3<Real> applyTo(const Vector3<Real>& v) const;
+	constexpr Vector4<Real> applyTo(const Vector4<Real>& v) const;
 
-    const Real* const constData() const;
-    operator const Real* const () const;
+    constexpr const Real* const constData() const;
+    constexpr operator const Real* const () const;
 
     void set(unsigned int index, Real value) {
         this->data[index] = value;
@@ -132,38 +132,41 @@ public:
         return this->data[index];
     }
 
-    Real& operator () (std::size_t i, std::size_t j);
-    const Real& operator () (std::size_t i, std::size_t j) const;
+    constexpr Real& operator () (std::size_t i, std::size_t j);
+    constexpr const Real& operator () (std::size_t i, std::size_t j) const;
 
     friend std::ostream& operator << <> (std::ostream& out, const Matrix4<Real>& m);
 
-    bool operator == (const Matrix4<Real>& m);
-	bool operator != (const Matrix4<Real>& m);
+    constexpr bool operator == (const Matrix4<Real>& m);
+	constexpr bool operator != (const Matrix4<Real>& m);
 
-    Matrix4<Real>& operator = (const Matrix4<Real>& m);
-	Matrix4<Real>& operator = (const Real* data);
+    constexpr Matrix4<Real>& operator = (const Matrix4<Real>& m);
+	constexpr Matrix4<Real>& operator = (const Real* data);
 
-    Vector3<Real> operator * (const Vector3<Real>& v);
-	Matrix4<Real> operator * (const Matrix4<Real>& m);
-    Matrix4<Real>& operator *= (const Matrix4<Real>& m);
+    constexpr Vector3<Real> operator * (const Vector3<Real>& v);
+	constexpr Matrix4<Real> operator * (const Matrix4<Real>& m);
+    constexpr Matrix4<Real>& operator *= (const Matrix4<Real>& m);
 
     static void ToRawMatrix(const Matrix4<Real>& m, Real* const matrix, bool colMajor = true);
-    static void Clear(Matrix4<Real>& m);
-    static void Identity(Matrix4<Real>& m);
-    static void Zero(Matrix4<Real>& m);
-    static Real Determinant(const Matrix4<Real>& m);
-    static Real Determinant(const Matrix4<Real>& matrix, Real* const adjoint);
-    static Matrix4<Real> Multiply(const Matrix4<Real>& a, const Matrix4<Real>& b);
-    static Matrix4<Real> Transpose(const Matrix4<Real>& m);
-    static Matrix4<Real> Inverse(const Matrix4<Real>& m);
+    static constexpr void Clear(Matrix4<Real>& m);
+    static constexpr void Identity(Matrix4<Real>& m);
+    static constexpr void Zero(Matrix4<Real>& m);
+    static constexpr Real Determinant(const Matrix4<Real>& m);
+    static constexpr Real Determinant(const Matrix4<Real>& matrix, Real* const adjoint);
+    static constexpr Matrix4<Real> Multiply(const Matrix4<Real>& a, const Matrix4<Real>& b);
+    static constexpr Matrix4<Real> Transpose(const Matrix4<Real>& m);
+    static constexpr Matrix4<Real> Inverse(const Matrix4<Real>& m);
     static Matrix4<Real> LookAt(const Vector3<Real>& eye, const Vector3<Real>& lookat, const Vector3<Real>& up);
     static Matrix4<Real> LookAt(Real eyex, Real eyey, Real eyez, Real atx, Real aty, Real atz, Real upx, Real upy, Real upz);
     static Matrix3<Real> NormalMatrix(const Matrix4<Real>& modelViewMatrix);
 
-    static Matrix4<Real> Zero();
-    static Matrix4<Real> Identity();
+    static constexpr Matrix4<Real> Zero();
+    static constexpr Matrix4<Real> Identity();
 
 protected:
+    /* std::swap is not constexpr. */
+    static constexpr void Swap(Real& a, Real& b);
+
 	const static int ROW_COUNT = 4;
 	const static int COL_COUNT = 4;
 
@@ -171,9 +174,7 @@ protected:
 };
 
 template <typename Real>
-Matrix4<Real>::Matrix4(bool identity) {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
-
+constexpr Matrix4<Real>::Matrix4(bool identity) : data() {
     if ( identity ) {
         this->data[A_11] = Real(1);
         this->data[A_22] = Real(1);
@@ -183,25 +184,25 @@ Matrix4<Real>::Matrix4(bool identity) {
 }
 
 template <typename Real>
-Matrix4<Real>::Matrix4(const Real* const data) {
-    std::memcpy(this->data, data, COMPONENT_COUNT * sizeof(Real));
+constexpr Matrix4<Real>::Matrix4(const Real* const data) : data() {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = data[i];
 }
 
 template <typename Real>
-Matrix4<Real>::Matrix4(const Matrix3<Real>& m, bool homogeneous) {
+constexpr Matrix4<Real>::Matrix4(const Matrix3<Real>& m, bool homogeneous) : data() {
     this->set(m, homogeneous);
 }
 
 template <typename Real>
-Matrix4<Real>::Matrix4(const Matrix4<Real>& m) {
-    std::memcpy(this->data, m.data, COMPONENT_COUNT * sizeof(Real));
+constexpr Matrix4<Real>::Matrix4(const Matrix4<Real>& m) : data() {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = m.data[i];
 }
 
 template <typename Real>
-Matrix4<Real>::Matrix4(Real a11, Real a12, Real a13, Real a14,
+constexpr Matrix4<Real>::Matrix4(Real a11, Real a12, Real a13, Real a14,
                        Real a21, Real a22, Real a23, Real a24,
                        Real a31, Real a32, Real a33, Real a34,
-                       Real a41, Real a42, Real a43, Real a44, bool colMajor) {
+                       Real a41, Real a42, Real a43, Real a44, bool colMajor) : data() {
     this->set(
         a11, a12, a13, a14, 
         a21, a22, a23, a24, 
@@ -212,11 +213,8 @@ Matrix4<Real>::Matrix4(Real a11, Real a12, Real a13, Real a14,
 }
 
 template <typename Real>
-Matrix4<Real>::~Matrix4() {}
-
-template <typename Real>
-void Matrix4<Real>::set(const Matrix3<Real>& m, bool homogeneous) {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::set(const Matrix3<Real>& m, bool homogeneous) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = Real(0);
 
     if ( homogeneous ) this->data[A_44] = Real(1);
 
@@ -234,25 +232,25 @@ void Matrix4<Real>::set(const Matrix3<Real>& m, bool homogeneous) {
 }
 
 template <typename Real>
-void Matrix4<Real>::set(const Matrix4<Real>& m) {
-    std::memcpy(this->data, m.data, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::set(const Matrix4<Real>& m) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = m.data[i];
 }
 
 template <typename Real>
-void Matrix4<Real>::set(const Real* const data) {
-    std::memcpy(this->data, data, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::set(const Real* const data) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = data[i];
 }
 
 template <typename Real>
-void Matrix4<Real>::set(std::size_t i, std::size_t j, Real value) {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix4:set] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix4:set] Index j out of bounds.");
+constexpr void Matrix4<Real>::set(std::size_t i, std::size_t j, Real value) {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix4:set] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix4:set] Index j out of bounds.");
 
     this->data[i * ROW_COUNT + j] = value;
 }
 
 template <typename Real>
-void Matrix4<Real>::set(Real a11, Real a12, Real a13, Real a14,
+constexpr void Matrix4<Real>::set(Real a11, Real a12, Real a13, Real a14,
                         Real a21, Real a22, Real a23, Real a24,
                         Real a31, Real a32, Real a33, Real a34,
                         Real a41, Real a42, Real a43, Real a44, bool colMajor) {
@@ -292,8 +290,8 @@ void Matrix4<Real>::set(Real a11, Real a12, Real a13, Real a14,
 }
 
 template <typename Real>
-void Matrix4<Real>::setRow(std::size_t i, Real w, Real x, Real y, Real z) {
-    if ( i >= COL_COUNT ) throw std::exception("[Matrix4:getColumn] Error: Column index out of bounds.");
+constexpr void Matrix4<Real>::setRow(std::size_t i, Real w, Real x, Real y, Real z) {
+    if ( i >= COL_COUNT ) throw std::out_of_range("[Matrix4:getColumn] Error: Column index out of bounds.");
 
     if ( i == 0 ) {
         this->data[A_11] = w;
@@ -325,13 +323,13 @@ void Matrix4<Real>::setRow(std::size_t i, Real w, Real x, Real y, Real z) {
 }
 
 template <typename Real>
-void Matrix4<Real>::setRow(std::size_t i, const Vector4<Real>& row) {
+constexpr void Matrix4<Real>::setRow(std::size_t i, const Vector4<Real>& row) {
     this->setRow(i, row.w(), row.x(), row.y(), row.z());
 }
 
 template <typename Real>
-void Matrix4<Real>::setColumn(std::size_t i, Real w, Real x, Real y, Real z) {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix4:setRow] Error: Row index out of bounds.");
+constexpr void Matrix4<Real>::setColumn(std::size_t i, Real w, Real x, Real y, Real z) {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix4:setRow] Error: Row index out of bounds.");
 
     if ( i == 0 ) {
         this->data[A_11] = w;
@@ -363,12 +361,12 @@ void Matrix4<Real>::setColumn(std::size_t i, Real w, Real x, Real y, Real z) {
 }
 
 template <typename Real>
-void Matrix4<Real>::setColumn(std::size_t i, const Vector4<Real>& column) {
+constexpr void Matrix4<Real>::setColumn(std::size_t i, const Vector4<Real>& column) {
     this->setColumn(i, column.w(), column.x(), column.y(), column.z());
 }
 
 template <typename Real>
-bool Matrix4<Real>::isZero(Real epsilon) {
+constexpr bool Matrix4<Real>::isZero(Real epsilon) {
     for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) {
         Real value = this->data[i];
 
@@ -379,7 +377,7 @@ bool Matrix4<Real>::isZero(Real epsilon) {
 }
 
 template <typename Real>
-bool Matrix4<Real>::isIdentity(Real epsilon) {
+constexpr bool Matrix4<Real>::isIdentity(Real epsilon) {
     if ( this->data[A_11] < Real(1) - epsilon || this->data[A_11] > Real(1) + epsilon ) return false;
     if ( this->data[A_22] < Real(1) - epsilon || this->data[A_22] > Real(1) + epsilon ) return false;
     if ( this->data[A_33] < Real(1) - epsilon || this->data[A_33] > Real(1) + epsilon ) return false;
@@ -425,23 +423,23 @@ bool Matrix4<Real>::isEquivalent(const Matrix4<Real>& m, Real epsilon) {
 }
 
 template <typename Real>
-void Matrix4<Real>::zero() {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::zero() {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = Real(0);
 }
 
 template <typename Real>
-void Matrix4<Real>::transpose() {
-    std::swap(this->data[A_12], this->data[A_21]);
-    std::swap(this->data[A_13], this->data[A_31]);
-    std::swap(this->data[A_14], this->data[A_41]);
-    std::swap(this->data[A_23], this->data[A_32]);
-    std::swap(this->data[A_24], this->data[A_42]);
-    std::swap(this->data[A_34], this->data[A_43]);
+constexpr void Matrix4<Real>::transpose() {
+    Swap(this->data[A_12], this->data[A_21]);
+    Swap(this->data[A_13], this->data[A_31]);
+    Swap(this->data[A_14], this->data[A_41]);
+    Swap(this->data[A_23], this->data[A_32]);
+    Swap(this->data[A_24], this->data[A_42]);
+    Swap(this->data[A_34], this->data[A_43]);
 }
 
 template <typename Real>
-void Matrix4<Real>::identity() {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::identity() {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = Real(0);
     this->data[A_11] = Real(1);
     this->data[A_22] = Real(1);
     this->data[A_33] = Real(1);
@@ -451,12 +449,12 @@ void Matrix4<Real>::identity() {
 template <typename Real>
 void Matrix4<Real>::invert() {
     Matrix4<Real> inverse = Matrix4<Real>::Inverse(*this);
-    std::memcpy(this->data, inverse.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = inverse.data[i];
 }
 
 template <typename Real>
-void Matrix4<Real>::clear(bool identity) {
-    std::memset(this->data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::clear(bool identity) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = Real(0);
 
     if ( identity ) {
         this->data[A_11] = Real(1);
@@ -470,7 +468,7 @@ void Matrix4<Real>::toRawMatrix(Real* const matrix, bool colMajor) const {
     if ( nullptr == matrix ) return;
     Matrix4<Real> result = (*this);
     if ( colMajor == false ) result.transpose();
-    std::memcpy(matrix, result.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) matrix[i] = result.data[i];
 }
 
 template <typename Real>
@@ -479,22 +477,22 @@ void Matrix4<Real>::getData(Real* const matrix, bool colMajor) const {
 }
 
 template <typename Real>
-Real Matrix4<Real>::determinant() const {
+constexpr Real Matrix4<Real>::determinant() const {
     return Matrix4<Real>::Determinant(*this);
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::inverse() const {
+constexpr Matrix4<Real> Matrix4<Real>::inverse() const {
     return Matrix4<Real>::Inverse(*this);
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::inversed() const {
+constexpr Matrix4<Real> Matrix4<Real>::inversed() const {
     return Matrix4<Real>::Inverse(*this);
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::transposed() const {
+constexpr Matrix4<Real> Matrix4<Real>::transposed() const {
     return Matrix4<Real>::Transpose(*this);
 }
 
@@ -509,34 +507,34 @@ Matrix4<RealCastType> Matrix4<Real>::cast() {
 
 
 template <typename Real>
-Real& Matrix4<Real>::get(std::size_t i, std::size_t j) {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix4:get] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix4:get] Index j out of bounds.");
+constexpr Real& Matrix4<Real>::get(std::size_t i, std::size_t j) {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix4:get] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix4:get] Index j out of bounds.");
 
-    return this->data[i * ROW_SIZE + j];
+    return this->data[i * ROW_COUNT + j];
 }
 
 template <typename Real>
-const Real& Matrix4<Real>::get(std::size_t i, std::size_t j) const {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix4:get] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix4:get] Index j out of bounds.");
+constexpr const Real& Matrix4<Real>::get(std::size_t i, std::size_t j) const {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix4:get] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix4:get] Index j out of bounds.");
 
-    return this->data[i * ROW_SIZE + j];
+    return this->data[i * ROW_COUNT + j];
 }
 
 template <typename Real>
-Vector4<Real> Matrix4<Real>::getColumn(std::size_t i) const {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix4:getRow] Error: Row index out of bounds.");
+constexpr Vector4<Real> Matrix4<Real>::getColumn(std::size_t i) const {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix4:getRow] Error: Row index out of bounds.");
     if ( i == 0 ) return Vector4<Real>(this->data[A_14], this->data[A_11], this->data[A_12], this->data[A_13]);
     if ( i == 1 ) return Vector4<Real>(this->data[A_24], this->data[A_21], this->data[A_22], this->data[A_23]);
     if ( i == 2 ) return Vector4<Real>(this->data[A_34], this->data[A_31], this->data[A_32], this->data[A_33]);
     if ( i == 3 ) return Vector4<Real>(this->data[A_44], this->data[A_41], this->data[A_42], this->data[A_43]);
-    return Vector4<Real>::Zero()
+    return Vector4<Real>::Zero();
 }
 
 template <typename Real>
-Vector4<Real> Matrix4<Real>::getRow(std::size_t i) const {
-    if ( i >= COL_COUNT ) throw std::exception("[Matrix4:getColumn] Error: Column index out of bounds.");
+constexpr Vector4<Real> Matrix4<Real>::getRow(std::size_t i) const {
+    if ( i >= COL_COUNT ) throw std::out_of_range("[Matrix4:getColumn] Error: Column index out of bounds.");
     if ( i == 0 ) return Vector4<Real>(this->data[A_41], this->data[A_11], this->data[A_21], this->data[A_31]);
     if ( i == 1 ) return Vector4<Real>(this->data[A_42], this->data[A_12], this->data[A_22], this->data[A_32]);
     if ( i == 2 ) return Vector4<Real>(this->data[A_43], this->data[A_13], this->data[A_23], this->data[A_33]);
@@ -545,13 +543,13 @@ Vector4<Real> Matrix4<Real>::getRow(std::size_t i) const {
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::toTranspose() const {
+constexpr Matrix4<Real> Matrix4<Real>::toTranspose() const {
     Matrix4<Real> result = (*this);
     return Matrix4<Real>::Transpose(result);
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::toInverse() const {
+constexpr Matrix4<Real> Matrix4<Real>::toInverse() const {
     Matrix4<Real> result = (*this);
     return Matrix4<Real>::Inverse(result);
 }
@@ -580,7 +578,7 @@ Matrix4<Real> Matrix4<Real>::apply(const Vector4<Real>& v, bool colMajor) const
 }
 
 template <typename Real>
-Vector3<Real> Matrix4<Real>::applyTo(const Vector3<Real>& v) const {
+constexpr Vector3<Real> Matrix4<Real>::applyTo(const Vector3<Real>& v) const {
     Vector4<Real> result;
     result.x() = this->data[A_21] * v.w() + this->data[A_22] * v.x() + this->data[A_23] * v.y() + this->data[A_24] * v.z();
     result.y() = this->data[A_31] * v.w() + this->data[A_32] * v.x() + this->data[A_33] * v.y() + this->data[A_34] * v.z();
@@ -589,7 +587,7 @@ Vector3<Real> Matrix4<Real>::applyTo(const Vector3<Real>& v) const {
 }
 
 template <typename Real>
-Vector4<Real> Matrix4<Real>::applyTo(const Vector4<Real>& v) const {
+constexpr Vector4<Real> Matrix4<Real>::applyTo(const Vector4<Real>& v) const {
     Vector4<Real> result;
     result.w() = this->data[A_11] * v.w() + this->data[A_12] * v.x() + this->data[A_13] * v.y() + this->data[A_14] * v.z();
     result.x() = this->data[A_21] * v.w() + this->data[A_22] * v.x() + this->data[A_23] * v.y() + this->data[A_24] * v.z();
@@ -599,27 +597,27 @@ Vector4<Real> Matrix4<Real>::applyTo(const Vector4<Real>& v) const {
 }
 
 template <typename Real>
-const Real* const Matrix4<Real>::constData() const {
+constexpr const Real* const Matrix4<Real>::constData() const {
     return this->data;
 }
 
 template <typename Real>
-Matrix4<Real>::operator const Real* const () const {
+constexpr Matrix4<Real>::operator const Real* const () const {
     return this->data;
 }
 
 template <typename Real>
-Real& Matrix4<Real>::operator () (std::size_t i, std::size_t j) {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix4:()] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix4:()] Index j out of bounds.");
+constexpr Real& Matrix4<Real>::operator () (std::size_t i, std::size_t j) {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix4:()] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix4:()] Index j out of bounds.");
 
     return this->data[i * ROW_COUNT + j];
 }
 
 template <typename Real>
-const Real& Matrix4<Real>::operator () (std::size_t i, std::size_t j) const {
-    if ( i >= ROW_COUNT ) throw std::exception("[Matrix4:()] Index i out of bounds.");
-	if ( j >= COL_COUNT ) throw std::exception("[Matrix4:()] Index j out of bounds.");
+constexpr const Real& Matrix4<Real>::operator () (std::size_t i, std::size_t j) const {
+    if ( i >= ROW_COUNT ) throw std::out_of_range("[Matrix4:()] Index i out of bounds.");
+	if ( j >= COL_COUNT ) throw std::out_of_range("[Matrix4:()] Index j out of bounds.");
 
     return this->data[i * ROW_COUNT + j];
 }
@@ -635,46 +633,46 @@ std::ostream& operator << (std::ostream& out, const Matrix4<Real>& m) {
 }
 
 template <typename Real>
-bool Matrix4<Real>::operator == (const Matrix4<Real>& m) {
+constexpr bool Matrix4<Real>::operator == (const Matrix4<Real>& m) {
     for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ )
         if ( this->data[i] != m.data[i] ) return false;
     return true;
 }
 
 template <typename Real>
-bool Matrix4<Real>::operator != (const Matrix4<Real>& m) {
+constexpr bool Matrix4<Real>::operator != (const Matrix4<Real>& m) {
     return !(*this == m);
 }
 
 template <typename Real>
-Matrix4<Real>& Matrix4<Real>::operator = (const Matrix4<Real>& m) {
+constexpr Matrix4<Real>& Matrix4<Real>::operator = (const Matrix4<Real>& m) {
     if ( this == &m ) return *this;
-    std::memcpy(this->data, m.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = m.data[i];
     return *this;
 }
 
 template <typename Real>
-Matrix4<Real>& Matrix4<Real>::operator = (const Real* data) {
+constexpr Matrix4<Real>& Matrix4<Real>::operator = (const Real* data) {
     if ( nullptr == data ) return *this;
-    std::memcpy(this->data, data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = data[i];
     return *this;
 }
 
 template <typename Real>
-Vector3<Real> Matrix4<Real>::operator * (const Vector3<Real>& v) {
+constexpr Vector3<Real> Matrix4<Real>::operator * (const Vector3<Real>& v) {
     return this->applyTo(v);
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::operator * (const Matrix4<Real>& m) {
+constexpr Matrix4<Real> Matrix4<Real>::operator * (const Matrix4<Real>& m) {
     Matrix4<Real> t = (*this);
     return Matrix4<Real>::Multiply(t, m);
 }
 
 template <typename Real>
-Matrix4<Real>& Matrix4<Real>::operator *= (const Matrix4<Real>& m) {
+constexpr Matrix4<Real>& Matrix4<Real>::operator *= (const Matrix4<Real>& m) {
     Matrix4<Real> result = Matrix4<Real>::Multiply(*this, m);
-    std::memcpy(this->data, result.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) this->data[i] = result.data[i];
     return *this;
 }
 
@@ -687,17 +685,17 @@ void Matrix4<Real>::ToRawMatrix(const Matrix4<Real>& m, Real* const matrix, bool
 
     Matrix4<Real> result = m;
     if ( colMajor == false ) result.transpose();
-    std::memcpy(matrix, result.data, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) matrix[i] = result.data[i];
 }
 
 template <typename Real>
-void Matrix4<Real>::Clear(Matrix4<Real>& m) {
-    std::memset(m.data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::Clear(Matrix4<Real>& m) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) m.data[i] = Real(0);
 }
 
 template <typename Real>
-void Matrix4<Real>::Identity(Matrix4<Real>& m) {
-    std::memset(m.data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::Identity(Matrix4<Real>& m) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) m.data[i] = Real(0);
     m.data[A_11] = Real(1);
     m.data[A_22] = Real(1);
     m.data[A_33] = Real(1);
@@ -705,21 +703,21 @@ void Matrix4<Real>::Identity(Matrix4<Real>& m) {
 }
 
 template <typename Real>
-void Matrix4<Real>::Zero(Matrix4<Real>& m) {
-    std::memset(m.data, 0, COMPONENT_COUNT * sizeof(Real));
+constexpr void Matrix4<Real>::Zero(Matrix4<Real>& m) {
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) m.data[i] = Real(0);
 }
 
 template <typename Real>
-Real Matrix4<Real>::Determinant(const Matrix4<Real>& matrix) {
-    Real adjoint[COMPONENT_COUNT];
+constexpr Real Matrix4<Real>::Determinant(const Matrix4<Real>& matrix) {
+    Real adjoint[COMPONENT_COUNT] = {};
     return Matrix4<Real>::Determinant(matrix, adjoint);
 }
 
 /* Loop-unroll determinant */
 template <typename Real>
-Real Matrix4<Real>::Determinant(const Matrix4<Real>& matrix, Real* const adjoint) {
-    Real m[COMPONENT_COUNT];
-    std::memcpy(m, matrix.data, COMPONENT_COUNT * sizeof(Real));
+constexpr Real Matrix4<Real>::Determinant(const Matrix4<Real>& matrix, Real* const adjoint) {
+    Real m[COMPONENT_COUNT] = {};
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) m[i] = matrix.data[i];
 
     adjoint[0] = m[5]  * m[10] * m[15] - 
              m[5]  * m[11] * m[14] - 
@@ -838,7 +836,7 @@ Real Matrix4<Real>::Determinant(const Matrix4<Real>& matrix, Real* const adjoint
 
 /* Memory friendly matrix multiplication (Gita A., Lan V.) */
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::Multiply(const Matrix4<Real>& a, const Matrix4<Real>& b) {
+constexpr Matrix4<Real> Matrix4<Real>::Multiply(const Matrix4<Real>& a, const Matrix4<Real>& b) {
     Matrix4<Real> result(false);
     for ( unsigned int i = 0; i < ROW_COUNT; i++ )
 		for ( unsigned int j = 0; j < ROW_COUNT; j++ )
@@ -854,24 +852,24 @@ Matrix4<Real> Matrix4<Real>::Multiply(const Matrix4<Real>& a, const Matrix4<Real
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::Transpose(const Matrix4<Real>& m) {
+constexpr Matrix4<Real> Matrix4<Real>::Transpose(const Matrix4<Real>& m) {
     Matrix4<Real> result = m;
-    std::swap(result.data[A_12], result.data[A_21]);
-    std::swap(result.data[A_13], result.data[A_31]);
-    std::swap(result.data[A_14], result.data[A_41]);
-    std::swap(result.data[A_23], result.data[A_32]);
-    std::swap(result.data[A_24], result.data[A_42]);
-    std::swap(result.data[A_34], result.data[A_43]);
+    Swap(result.data[A_12], result.data[A_21]);
+    Swap(result.data[A_13], result.data[A_31]);
+    Swap(result.data[A_14], result.data[A_41]);
+    Swap(result.data[A_23], result.data[A_32]);
+    Swap(result.data[A_24], result.data[A_42]);
+    Swap(result.data[A_34], result.data[A_43]);
     return result;
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::Inverse(const Matrix4<Real>& matrix) {
-    Real m[COMPONENT_COUNT];
-    Real adjoint[COMPONENT_COUNT];
+constexpr Matrix4<Real> Matrix4<Real>::Inverse(const Matrix4<Real>& matrix) {
+    Real m[COMPONENT_COUNT] = {};
+    Real adjoint[COMPONENT_COUNT] = {};
 
-    std::memcpy(m, matrix.data, COMPONENT_COUNT * sizeof(Real));
-    std::memset(adjoint, 0, COMPONENT_COUNT * sizeof(Real));
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) m[i] = matrix.data[i];
+    for ( unsigned int i = 0; i < COMPONENT_COUNT; i++ ) adjoint[i] = Real(0);
 	
     Real det = Matrix4<Real>::Determinant(matrix, adjoint);
     if ( det == Real(0) ) return Matrix4<Real>(true);
@@ -943,15 +941,22 @@ Matrix3<Real> Matrix4<Real>::NormalMatrix(const Matrix4<Real>& modelViewMatrix)
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::Zero() {
+constexpr Matrix4<Real> Matrix4<Real>::Zero() {
     return Matrix4<Real>(false);
 }
 
 template <typename Real>
-Matrix4<Real> Matrix4<Real>::Identity() {
+constexpr Matrix4<Real> Matrix4<Real>::Identity() {
     return Matrix4<Real>(true);
 }
 
+template <typename Real>
+constexpr void Matrix4<Real>::Swap(Real& a, Real& b) {
+    Real t = a;
+    a = b;
+    b = t;
+}
+
 typedef Matrix4<float> Matrix4f;
 typedef Matrix4<double> Matrix4d;
 typedef Matrix4<long> Matrix4l;
@@ -965,4 +970,11 @@ typedef Matrix4<short> Mat4s;
 
 typedef Matrix4<float> Mat4;
 
+/* Compile time checks: these only compile while the functions stay constexpr. */
+static_assert(Matrix4<double>::Determinant(Matrix4<double>(2, 0, 0, 1, 0, 1, 0, 0, 0, 0, 4, 0, 1, 0, 0, 1, false)) == 4.0,
+    "[Matrix4:Determinant] Error: Not folded at compile time.");
+static_assert(Matrix4<double>::Multiply(Matrix4<double>(2, 0, 0, 1, 0, 1, 0, 0, 0, 0, 4, 0, 1, 0, 0, 1, false),
+    Matrix4<double>::Inverse(Matrix4<double>(2, 0, 0, 1, 0, 1, 0, 0, 0, 0, 4, 0, 1, 0, 0, 1, false))) == Matrix4<double>::Identity(),
+    "[Matrix4:Inverse] Error: A * Inverse(A) is not the identity.");
+
 #endif
@@ -0,0 +1,454 @@
+#ifndef MATRIX_BATCH_H
+#define MATRIX_BATCH_H
+
+#include <cmath>
+#include <cstddef>
+#include "Matrix3.h"
+#include "VectorBatch.h"
+
+/*
+ * FloatLanes1/4/8: One float per lane of a scalar, SSE or AVX register, with the
+ * handful of operations the batch kernels below need. The kernels are written once
+ * against this interface and instantiated for every width that is available.
+ *
+ * Gather3() loads the x y z components of WIDTH vectors, one per lane, and ScatterAdd3()
+ * adds x y z to them. Lane j works on the vector at base + 4 * indices[j * step], e.g. one
+ * corner of WIDTH consecutive tetrahedra with a step of 4. The vectors are read and written
+ * as four floats, so they must be padded like PaddedVector3f; the padding is left unchanged.
+ * The lanes are added one after the other, so several lanes may refer to the same vector.
+ */
+struct FloatLanes1 {
+    typedef bool Mask;
+    static const std::size_t WIDTH = 1;
+
+    float v;
+
+    FloatLanes1() {}
+    FloatLanes1(float s) : v(s) {}
+
+    static FloatLanes1 Load(const float* p) { return FloatLanes1(*p); }
+    void store(float* p) const { *p = this->v; }
+
+    static void Gather3(const float* base, const unsigned int* indices, std::size_t step, FloatLanes1& x, FloatLanes1& y, FloatLanes1& z) {
+        const float* p = base + 4 * static_cast<std::size_t>(indices[0]);
+        x.v = p[0];
+        y.v = p[1];
+        z.v = p[2];
+    }
+
+    static void ScatterAdd3(float* base, const unsigned int* indices, std::size_t step, const FloatLanes1& x, const FloatLanes1& y, const FloatLanes1& z) {
+        float* p = base + 4 * static_cast<std::size_t>(indices[0]);
+        p[0] += x.v;
+        p[1] += y.v;
+        p[2] += z.v;
+    }
+};
+
+inline FloatLanes1 operator + (const FloatLanes1& a, const FloatLanes1& b) { return FloatLanes1(a.v + b.v); }
+inline FloatLanes1 operator - (const FloatLanes1& a, const FloatLanes1& b) { return FloatLanes1(a.v - b.v); }
+inline FloatLanes1 operator * (const FloatLanes1& a, const FloatLanes1& b) { return FloatLanes1(a.v * b.v); }
+inline FloatLanes1 operator - (const FloatLanes1& a) { return FloatLanes1(-a.v); }
+inline FloatLanes1 Abs(const FloatLanes1& a) { return FloatLanes1(std::fabs(a.v)); }
+inline FloatLanes1 InverseSqrt(const FloatLanes1& a) { return FloatLanes1(1.0f / std::sqrt(a.v)); }
+inline FloatLanes1 Reciprocal(const FloatLanes1& a) { return FloatLanes1(1.0f / a.v); }
+inline bool Less(const FloatLanes1& a, const FloatLanes1& b) { return a.v < b.v; }
+inline FloatLanes1 Select(bool mask, const FloatLanes1& a, const FloatLanes1& b) { return mask ? a : b; }
+
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+struct FloatLanes4 {
+    typedef FloatLanes4 Mask;
+    static const std::size_t WIDTH = 4;
+
+    __m128 v;
+
+    FloatLanes4() {}
+    FloatLanes4(__m128 v) : v(v) {}
+    FloatLanes4(float s) : v(_mm_set1_ps(s)) {}
+
+    static FloatLanes4 Load(const float* p) { return FloatLanes4(_mm_loadu_ps(p)); }
+    void store(float* p) const { _mm_storeu_ps(p, this->v); }
+
+    static void Gather3(const float* base, const unsigned int* indices, std::size_t step, FloatLanes4& x, FloatLanes4& y, FloatLanes4& z) {
+        __m128 r0 = _mm_loadu_ps(base + 4 * static_cast<std::size_t>(indices[0]));
+        __m128 r1 = _mm_loadu_ps(base + 4 * static_cast<std::size_t>(indices[step]));
+        __m128 r2 = _mm_loadu_ps(base + 4 * static_cast<std::size_t>(indices[2 * step]));
+        __m128 r3 = _mm_loadu_ps(base + 4 * static_cast<std::size_t>(indices[3 * step]));
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        x.v = r0;
+        y.v = r1;
+        z.v = r2;
+    }
+
+    static void ScatterAdd3(float* base, const unsigned int* indices, std::size_t step, const FloatLanes4& x, const FloatLanes4& y, const FloatLanes4& z) {
+        __m128 r0 = x.v, r1 = y.v, r2 = z.v, r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        float* p0 = base + 4 * static_cast<std::size_t>(indices[0]);
+        _mm_storeu_ps(p0, _mm_add_ps(_mm_loadu_ps(p0), r0));
+        float* p1 = base + 4 * static_cast<std::size_t>(indices[step]);
+        _mm_storeu_ps(p1, _mm_add_ps(_mm_loadu_ps(p1), r1));
+        float* p2 = base + 4 * static_cast<std::size_t>(indices[2 * step]);
+        _mm_storeu_ps(p2, _mm_add_ps(_mm_loadu_ps(p2), r2));
+        float* p3 = base + 4 * static_cast<std::size_t>(indices[3 * step]);
+        _mm_storeu_ps(p3, _mm_add_ps(_mm_loadu_ps(p3), r3));
+    }
+};
+
+inline FloatLanes4 operator + (const FloatLanes4& a, const FloatLanes4& b) { return FloatLanes4(_mm_add_ps(a.v, b.v)); }
+inline FloatLanes4 operator - (const FloatLanes4& a, const FloatLanes4& b) { return FloatLanes4(_mm_sub_ps(a.v, b.v)); }
+inline FloatLanes4 operator * (const FloatLanes4& a, const FloatLanes4& b) { return FloatLanes4(_mm_mul_ps(a.v, b.v)); }
+inline FloatLanes4 operator - (const FloatLanes4& a) { return FloatLanes4(_mm_xor_ps(a.v, _mm_set1_ps(-0.0f))); }
+inline FloatLanes4 Abs(const FloatLanes4& a) { return FloatLanes4(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)); }
+inline FloatLanes4 Less(const FloatLanes4& a, const FloatLanes4& b) { return FloatLanes4(_mm_cmplt_ps(a.v, b.v)); }
+inline FloatLanes4 Select(const FloatLanes4& mask, const FloatLanes4& a, const FloatLanes4& b) {
+    return FloatLanes4(_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)));
+}
+
+/* The 12 bit estimates refined by one Newton-Raphson step. */
+inline FloatLanes4 InverseSqrt(const FloatLanes4& a) {
+    __m128 r = _mm_rsqrt_ps(a.v);
+    return FloatLanes4(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), r), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(a.v, r), r))));
+}
+
+inline FloatLanes4 Reciprocal(const FloatLanes4& a) {
+    __m128 r = _mm_rcp_ps(a.v);
+    return FloatLanes4(_mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(a.v, r))));
+}
+#endif
+
+#if defined(VECTOR_BATCH_AVX)
+struct FloatLanes8 {
+    typedef FloatLanes8 Mask;
+    static const std::size_t WIDTH = 8;
+
+    __m256 v;
+
+    FloatLanes8() {}
+    FloatLanes8(__m256 v) : v(v) {}
+    FloatLanes8(float s) : v(_mm256_set1_ps(s)) {}
+
+    static FloatLanes8 Load(const float* p) { return FloatLanes8(_mm256_loadu_ps(p)); }
+    void store(float* p) const { _mm256_storeu_ps(p, this->v); }
+
+    /*
+     * Register j holds the vectors of lanes j and j + 4 in its two halves, so both 4 x 4
+     * transposes are done at once with the in-lane shuffles of AVX.
+     */
+    static __m256 _LoadPair(const float* base, const unsigned int* indices, std::size_t step, std::size_t j) {
+        __m128 low = _mm_loadu_ps(base + 4 * static_cast<std::size_t>(indices[j * step]));
+        __m128 high = _mm_loadu_ps(base + 4 * static_cast<std::size_t>(indices[(j + 4) * step]));
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+    }
+
+    static void _AddPair(float* base, const unsigned int* indices, std::size_t step, std::size_t j, __m256 pair) {
+        float* low = base + 4 * static_cast<std::size_t>(indices[j * step]);
+        _mm_storeu_ps(low, _mm_add_ps(_mm_loadu_ps(low), _mm256_castps256_ps128(pair)));
+        float* high = base + 4 * static_cast<std::size_t>(indices[(j + 4) * step]);
+        _mm_storeu_ps(high, _mm_add_ps(_mm_loadu_ps(high), _mm256_extractf128_ps(pair, 1)));
+    }
+
+    static void Gather3(const float* base, const unsigned int* indices, std::size_t step, FloatLanes8& x, FloatLanes8& y, FloatLanes8& z) {
+        __m256 r0 = _LoadPair(base, indices, step, 0), r1 = _LoadPair(base, indices, step, 1);
+        __m256 r2 = _LoadPair(base, indices, step, 2), r3 = _LoadPair(base, indices, step, 3);
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpacklo_ps(r2, r3);
+        __m256 t2 = _mm256_unpackhi_ps(r0, r1), t3 = _mm256_unpackhi_ps(r2, r3);
+        x.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+        y.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+        z.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    }
+
+    static void ScatterAdd3(float* base, const unsigned int* indices, std::size_t step, const FloatLanes8& x, const FloatLanes8& y, const FloatLanes8& z) {
+        __m256 zero = _mm256_setzero_ps();
+        __m256 t0 = _mm256_unpacklo_ps(x.v, y.v), t1 = _mm256_unpacklo_ps(z.v, zero);
+        __m256 t2 = _mm256_unpackhi_ps(x.v, y.v), t3 = _mm256_unpackhi_ps(z.v, zero);
+        _AddPair(base, indices, step, 0, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)));
+        _AddPair(base, indices, step, 1, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)));
+        _AddPair(base, indices, step, 2, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+        _AddPair(base, indices, step, 3, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+};
+
+inline FloatLanes8 operator + (const FloatLanes8& a, const FloatLanes8& b) { return FloatLanes8(_mm256_add_ps(a.v, b.v)); }
+inline FloatLanes8 operator - (const FloatLanes8& a, const FloatLanes8& b) { return FloatLanes8(_mm256_sub_ps(a.v, b.v)); }
+inline FloatLanes8 operator * (const FloatLanes8& a, const FloatLanes8& b) { return FloatLanes8(_mm256_mul_ps(a.v, b.v)); }
+inline FloatLanes8 operator - (const FloatLanes8& a) { return FloatLanes8(_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))); }
+inline FloatLanes8 Abs(const FloatLanes8& a) { return FloatLanes8(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)); }
+inline FloatLanes8 Less(const FloatLanes8& a, const FloatLanes8& b) { return FloatLanes8(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)); }
+inline FloatLanes8 Select(const FloatLanes8& mask, const FloatLanes8& a, const FloatLanes8& b) { return FloatLanes8(_mm256_blendv_ps(b.v, a.v, mask.v)); }
+
+inline FloatLanes8 InverseSqrt(const FloatLanes8& a) {
+    __m256 r = _mm256_rsqrt_ps(a.v);
+    return FloatLanes8(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), r), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(_mm256_mul_ps(a.v, r), r))));
+}
+
+inline FloatLanes8 Reciprocal(const FloatLanes8& a) {
+    __m256 r = _mm256_rcp_ps(a.v);
+    return FloatLanes8(_mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(a.v, r))));
+}
+#endif
+
+/*
+ * MatrixBatch: Polar decomposition and SVD of many 3x3 float matrices at once.
+ *
+ * Matrices are read through constData(), so element (row r, column c) is
+ * data[3 * c + r], the layout applyTo() works with. They are transposed into
+ * structure of arrays form eight (AVX, where VectorBatch::HasAVX() allows it), four
+ * (SSE) or one at a time and every lane runs the same branch free iteration.
+ *
+ * Polar() computes A = R * S with R a rotation and S symmetric. R is found with the
+ * quaternion iteration of Mueller et al. ("A Robust Method to Extract the Rotational
+ * Part of Deformations", 2016), which always yields a proper rotation, also for
+ * inverted elements, and converges in one or two steps when started from the rotation
+ * of the previous time step. Pass the same @rotations array (four floats per matrix,
+ * x y z w, initialized to 0 0 0 1) every step to get that warm start; without it every
+ * call starts from the identity and needs more @iterations. A matrix that is already
+ * inverted at a cold start begins near a saddle point and can take a hundred iterations;
+ * with the warm start the rotation follows an element through the inversion instead.
+ *
+ * SVD() computes A = U * diag(sigma) * V^T from the polar decomposition by
+ * diagonalizing S with Jacobi rotations (McAdams et al., "Computing the Singular
+ * Value Decomposition of 3x3 matrices with minimal branching and elementary floating
+ * point operations", 2011). U and V are rotations, so for an inverted element one
+ * singular value is negative. The singular values are not sorted.
+ */
+class MatrixBatch {
+public:
+    static void Polar(const Matrix3<float>* a, Matrix3<float>* r, Matrix3<float>* s, std::size_t count, float* rotations = NULL, int iterations = 4);
+    static void SVD(const Matrix3<float>* a, Matrix3<float>* u, Vector3<float>* sigma, Matrix3<float>* v, std::size_t count, float* rotations = NULL, int iterations = 4);
+
+    /* Iterations used when no warm start is given. */
+    static const int COLD_START_ITERATIONS = 16;
+
+    /* Jacobi sweeps over the three off-diagonal pairs in SVD(). */
+    static const int JACOBI_SWEEPS = 4;
+
+protected:
+    template <class L>
+    static std::size_t _Polar(const Matrix3<float>* a, Matrix3<float>* r, Matrix3<float>* s, Matrix3<float>* u, Vector3<float>* sigma, Matrix3<float>* v, std::size_t count, float* rotations, int iterations);
+
+    /* Iterate the quaternion @q towards the rotation of @a (column-major). */
+    template <class L>
+    static void _Rotation(const L* a, L* q, int iterations);
+
+    template <class L>
+    static void _QuaternionToMatrix(const L* q, L* m);
+
+    /* One Jacobi rotation of the symmetric @s (xx yy zz xy xz yz) in the (p, q) plane, accumulated into the columns of @v. */
+    template <class L>
+    static void _Jacobi(L& spp, L& sqq, L& spq, L& spk, L& sqk, L* vp, L* vq);
+};
+
+template <class L>
+inline void MatrixBatch::_QuaternionToMatrix(const L* q, L* m) {
+    const L one(1.0f), two(2.0f);
+    L x = q[0], y = q[1], z = q[2], w = q[3];
+
+    m[0] = one - two * (y * y + z * z);
+    m[1] = two * (x * y + w * z);
+    m[2] = two * (x * z - w * y);
+    m[3] = two * (x * y - w * z);
+    m[4] = one - two * (x * x + z * z);
+    m[5] = two * (y * z + w * x);
+    m[6] = two * (x * z + w * y);
+    m[7] = two * (y * z - w * x);
+    m[8] = one - two * (x * x + y * y);
+}
+
+template <class L>
+inline void MatrixBatch::_Rotation(const L* a, L* q, int iterations) {
+    const L half(0.5f), epsilon(1.0e-9f);
+
+    for ( int k = 0; k < iterations; k++ ) {
+        L r[9];
+        MatrixBatch::_QuaternionToMatrix(q, r);
+
+        /* omega = sum(r_i x a_i) / (|sum(r_i . a_i)| + epsilon), the axis-angle step towards the rotation of a. */
+        L wx = (r[1] * a[2] - r[2] * a[1]) + (r[4] * a[5] - r[5] * a[4]) + (r[7] * a[8] - r[8] * a[7]);
+        L wy = (r[2] * a[0] - r[0] * a[2]) + (r[5] * a[3] - r[3] * a[5]) + (r[8] * a[6] - r[6] * a[8]);
+        L wz = (r[0] * a[1] - r[1] * a[0]) + (r[3] * a[4] - r[4] * a[3]) + (r[6] * a[7] - r[7] * a[6]);
+        L d = r[0] * a[0] + r[1] * a[1] + r[2] * a[2] + r[3] * a[3] + r[4] * a[4] + r[5] * a[5] + r[6] * a[6] + r[7] * a[7] + r[8] * a[8];
+        L scale = half * Reciprocal(Abs(d) + epsilon);
+        wx = wx * scale;
+        wy = wy * scale;
+        wz = wz * scale;
+
+        /* q = normalize((w / 2, 1) * q). For small steps this is the exact exponential map to first order. */
+        L x = q[3] * wx + q[0] + (wy * q[2] - wz * q[1]);
+        L y = q[3] * wy + q[1] + (wz * q[0] - wx * q[2]);
+        L z = q[3] * wz + q[2] + (wx * q[1] - wy * q[0]);
+        L w = q[3] - (wx * q[0] + wy * q[1] + wz * q[2]);
+        L n = InverseSqrt(x * x + y * y + z * z + w * w);
+        q[0] = x * n;
+        q[1] = y * n;
+        q[2] = z * n;
+        q[3] = w * n;
+    }
+}
+
+template <class L>
+inline void MatrixBatch::_Jacobi(L& spp, L& sqq, L& spq, L& spk, L& sqk, L* vp, L* vq) {
+    const L one(1.0f), two(2.0f), gamma(5.828427124f), cstar(0.923879532f), sstar(0.382683432f);
+
+    /* Approximate Givens quaternion (McAdams et al.), exact enough to converge within a few sweeps. */
+    L ch = two * (spp - sqq);
+    L sh = spq;
+    typename L::Mask use_estimate = Less(gamma * sh * sh, ch * ch);
+    L w = InverseSqrt(ch * ch + sh * sh);
+    ch = Select(use_estimate, w * ch, cstar);
+    sh = Select(use_estimate, w * sh, sstar);
+
+    L c = ch * ch - sh * sh;
+    L s = two * ch * sh;
+
+    L cc = c * c, ss = s * s, cs = c * s;
+    L pp = cc * spp + two * cs * spq + ss * sqq;
+    L qq = ss * spp - two * cs * spq + cc * sqq;
+    L pq = (cc - ss) * spq - cs * (spp - sqq);
+    L pk = c * spk + s * sqk;
+    L qk = c * sqk - s * spk;
+    spp = pp;
+    sqq = qq;
+    spq = pq;
+    spk = pk;
+    sqk = qk;
+
+    for ( int i = 0; i < 3; i++ ) {
+        L p = vp[i];
+        vp[i] = c * p + s * vq[i];
+        vq[i] = c * vq[i] - s * p;
+    }
+}
+
+/* Returns how many matrices were processed, a multiple of the lane width. @s, @u, @sigma and @v may be NULL. */
+template <class L>
+std::size_t MatrixBatch::_Polar(const Matrix3<float>* a, Matrix3<float>* r, Matrix3<float>* s, Matrix3<float>* u, Vector3<float>* sigma, Matrix3<float>* v, std::size_t count, float* rotations, int iterations) {
+    const std::size_t W = L::WIDTH;
+    const L half(0.5f);
+
+    float block_a[9 * W];
+    float block_q[4 * W];
+    float block_out[9 * W];
+    float result[9];
+
+    std::size_t i = 0;
+    for ( ; i + W <= count; i += W ) {
+        for ( std::size_t lane = 0; lane < W; lane++ ) {
+            const float* m = a[i + lane].constData();
+            for ( std::size_t k = 0; k < 9; k++ ) block_a[k * W + lane] = m[k];
+
+            for ( std::size_t k = 0; k < 4; k++ )
+                block_q[k * W + lane] = (rotations != NULL) ? rotations[4 * (i + lane) + k] : (k == 3 ? 1.0f : 0.0f);
+        }
+
+        L am[9], q[4], rm[9];
+        for ( std::size_t k = 0; k < 9; k++ ) am[k] = L::Load(block_a + k * W);
+        for ( std::size_t k = 0; k < 4; k++ ) q[k] = L::Load(block_q + k * W);
+
+        MatrixBatch::_Rotation(am, q, iterations);
+        MatrixBatch::_QuaternionToMatrix(q, rm);
+
+        if ( rotations != NULL ) {
+            for ( std::size_t k = 0; k < 4; k++ ) q[k].store(block_q + k * W);
+            for ( std::size_t lane = 0; lane < W; lane++ )
+                for ( std::size_t k = 0; k < 4; k++ ) rotations[4 * (i + lane) + k] = block_q[k * W + lane];
+        }
+
+        if ( r != NULL ) {
+            for ( std::size_t k = 0; k < 9; k++ ) rm[k].store(block_out + k * W);
+            for ( std::size_t lane = 0; lane < W; lane++ ) {
+                for ( std::size_t k = 0; k < 9; k++ ) result[k] = block_out[k * W + lane];
+                r[i + lane].set(result);
+            }
+        }
+
+        if ( s == NULL && u == NULL && sigma == NULL && v == NULL ) continue;
+
+        /* S = R^T A, symmetrized: element (i, j) is column i of R dotted with column j of A. */
+        L sxx = rm[0] * am[0] + rm[1] * am[1] + rm[2] * am[2];
+        L syy = rm[3] * am[3] + rm[4] * am[4] + rm[5] * am[5];
+        L szz = rm[6] * am[6] + rm[7] * am[7] + rm[8] * am[8];
+        L sxy = half * ((rm[0] * am[3] + rm[1] * am[4] + rm[2] * am[5]) + (rm[3] * am[0] + rm[4] * am[1] + rm[5] * am[2]));
+        L sxz = half * ((rm[0] * am[6] + rm[1] * am[7] + rm[2] * am[8]) + (rm[6] * am[0] + rm[7] * am[1] + rm[8] * am[2]));
+        L syz = half * ((rm[3] * am[6] + rm[4] * am[7] + rm[5] * am[8]) + (rm[6] * am[3] + rm[7] * am[4] + rm[8] * am[5]));
+
+        if ( s != NULL ) {
+            L sm[9] = { sxx, sxy, sxz, sxy, syy, syz, sxz, syz, szz };
+            for ( std::size_t k = 0; k < 9; k++ ) sm[k].store(block_out + k * W);
+            for ( std::size_t lane = 0; lane < W; lane++ ) {
+                for ( std::size_t k = 0; k < 9; k++ ) result[k] = block_out[k * W + lane];
+                s[i + lane].set(result);
+            }
+        }
+
+        if ( u == NULL && sigma == NULL && v == NULL ) continue;
+
+        /* S = V diag(sigma) V^T, so A = (R V) diag(sigma) V^T. */
+        L vm[9] = { L(1.0f), L(0.0f), L(0.0f), L(0.0f), L(1.0f), L(0.0f), L(0.0f), L(0.0f), L(1.0f) };
+        for ( int sweep = 0; sweep < JACOBI_SWEEPS; sweep++ ) {
+            MatrixBatch::_Jacobi(sxx, syy, sxy, sxz, syz, vm + 0, vm + 3);
+            MatrixBatch::_Jacobi(sxx, szz, sxz, sxy, syz, vm + 0, vm + 6);
+            MatrixBatch::_Jacobi(syy, szz, syz, sxy, sxz, vm + 3, vm + 6);
+        }
+
+        if ( sigma != NULL ) {
+            sxx.store(block_out);
+            syy.store(block_out + W);
+            szz.store(block_out + 2 * W);
+            for ( std::size_t lane = 0; lane < W; lane++ )
+                sigma[i + lane].set(block_out[lane], block_out[W + lane], block_out[2 * W + lane]);
+        }
+
+        if ( v != NULL ) {
+            for ( std::size_t k = 0; k < 9; k++ ) vm[k].store(block_out + k * W);
+            for ( std::size_t lane = 0; lane < W; lane++ ) {
+                for ( std::size_t k = 0; k < 9; k++ ) result[k] = block_out[k * W + lane];
+                v[i + lane].set(result);
+            }
+        }
+
+        if ( u != NULL ) {
+            for ( std::size_t c = 0; c < 3; c++ )
+                for ( std::size_t k = 0; k < 3; k++ )
+                    (rm[k] * vm[3 * c] + rm[3 + k] * vm[3 * c + 1] + rm[6 + k] * vm[3 * c + 2]).store(block_out + (3 * c + k) * W);
+            for ( std::size_t lane = 0; lane < W; lane++ ) {
+                for ( std::size_t k = 0; k < 9; k++ ) result[k] = block_out[k * W + lane];
+                u[i + lane].set(result);
+            }
+        }
+    }
+
+    return i;
+}
+
+inline void MatrixBatch::Polar(const Matrix3<float>* a, Matrix3<float>* r, Matrix3<float>* s, std::size_t count, float* rotations, int iterations) {
+    if ( rotations == NULL && iterations < COLD_START_ITERATIONS ) iterations = COLD_START_ITERATIONS;
+
+    std::size_t i = 0;
+#if defined(VECTOR_BATCH_AVX)
+    if ( VectorBatch::HasAVX() ) {
+        i += MatrixBatch::_Polar<FloatLanes8>(a, r, s, NULL, NULL, NULL, count, rotations, iterations);
+        _mm256_zeroupper();
+    }
+#endif
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+    i += MatrixBatch::_Polar<FloatLanes4>(a + i, r != NULL ? r + i : NULL, s != NULL ? s + i : NULL, NULL, NULL, NULL, count - i, rotations != NULL ? rotations + 4 * i : NULL, iterations);
+#endif
+    MatrixBatch::_Polar<FloatLanes1>(a + i, r != NULL ? r + i : NULL, s != NULL ? s + i : NULL, NULL, NULL, NULL, count - i, rotations != NULL ? rotations + 4 * i : NULL, iterations);
+}
+
+inline void MatrixBatch::SVD(const Matrix3<float>* a, Matrix3<float>* u, Vector3<float>* sigma, Matrix3<float>* v, std::size_t count, float* rotations, int iterations) {
+    if ( rotations == NULL && iterations < COLD_START_ITERATIONS ) iterations = COLD_START_ITERATIONS;
+
+    std::size_t i = 0;
+#if defined(VECTOR_BATCH_AVX)
+    if ( VectorBatch::HasAVX() ) {
+        i += MatrixBatch::_Polar<FloatLanes8>(a, NULL, NULL, u, sigma, v, count, rotations, iterations);
+        _mm256_zeroupper();
+    }
+#endif
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+    i += MatrixBatch::_Polar<FloatLanes4>(a + i, NULL, NULL, u != NULL ? u + i : NULL, sigma != NULL ? sigma + i : NULL, v != NULL ? v + i : NULL, count - i, rotations != NULL ? rotations + 4 * i : NULL, iterations);
+#endif
+    MatrixBatch::_Polar<FloatLanes1>(a + i, NULL, NULL, u != NULL ? u + i : NULL, sigma != NULL ? sigma + i : NULL, v != NULL ? v + i : NULL, count - i, rotations != NULL ? rotations + 4 * i : NULL, iterations);
+}
+
+#endif
\ No newline at end of file
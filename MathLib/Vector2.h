@@ -29,28 +29,29 @@
 #include <iostream>
 #include <cmath>
 #include <type_traits>
+#include <stdexcept>
 #include <iomanip>
 
 template <typename Real>
 class Vector2;
 
 template <typename Real>
-Vector2<Real> operator + (const Vector2<Real>& u, const Vector2<Real>& v);
+constexpr Vector2<Real> operator + (const Vector2<Real>& u, const Vector2<Real>& v);
 
 template <typename Real>
-Vector2<Real> operator - (const Vector2<Real>& u, const Vector2<Real>& v);
+constexpr Vector2<Real> operator - (const Vector2<Real>& u, const Vector2<Real>& v);
 
 template <typename Real>
-Vector2<Real> operator - (const Vector2<Real>& v);
+constexpr Vector2<Real> operator - (const Vector2<Real>& v);
 
 template <typename Real>
-Vector2<Real> operator * (const Vector2<Real>& v, Real scalar);
+constexpr Vector2<Real> operator * (const Vector2<Real>& v, Real scalar);
 
 template <typename Real>
-Vector2<Real> operator * (Real scalar, const Vector2<Real>& v);
+constexpr Vector2<Real> operator * (Real scalar, const Vector2<Real>& v);
 
 template <typename Real>
-Vector2<Real> operator / (const Vector2<Real>& v, Real scalar);
+constexpr Vector2<Real> operator / (const Vector2<Real>& v, Real scalar);
 
 template <typename Real>
 std::ostream& operator << (std::ostream& out, const Vector2<Real>& vector);
@@ -80,21 +81,20 @@ class Vector2 {
     enum Axis { X, Y, COMPONENT_COUNT };
 
 public:
-    Vector2(Real x = Real(0), Real y = Real(0));
-    Vector2(const Vector2<Real>& v);
-    Vector2(Real v[2]);
-    Vector2(const Vector2<Real>& from, const Vector2<Real>& to);
-    ~Vector2();
-
-    void add(const Vector2<Real>& v);
-    void subtract(const Vector2<Real>& v);
-    void multiply(Real scalar);
+    constexpr Vector2(Real x = Real(0), Real y = Real(0));
+    constexpr Vector2(const Vector2<Real>& v);
+    constexpr Vector2(Real v[2]);
+    constexpr Vector2(const Vector2<Real>& from, const Vector2<Real>& to);
+
+    constexpr void add(const Vector2<Real>& v);
+    constexpr void subtract(const Vector2<Real>& v);
+    constexpr void multiply(Real scalar);
     void normalize();
-    void inverse();
-    
-    void zero();
-    bool isZero(Real epsilon);
-    bool isEqual(const Vector2<Real>& v);
+    constexpr void inverse();
+
+    constexpr void zero();
+    constexpr bool isZero(Real epsilon);
+    constexpr bool isEqual(const Vector2<Real>& v);
     bool isEquivalent(const Vector2<Real>& v, Real epsilon) const;
 
     template <typename RealCastType>
@@ -102,7 +102,7 @@ public:
 
     Vector2<Real> normalized() const;
     Vector2<Real> linearInterpolation(const Vector2<Real>& v, Real t);
-    double dot(const Vector2<Real>& v) const;
+    constexpr double dot(const Vector2<Real>& v) const;
     
     double angle(const Vector2<Real>& v) const;
     double magnitude() const;
@@ -113,68 +113,68 @@ public:
     double distance(const Vector2<Real>& v) const;
     double distanceSquared(const Vector2<Real>& v) const;
 
-    void set(Real x, Real y);
-    void set(const Vector2<Real>& v);
-    void setX(Real x);
-    void setY(Real y);
+    constexpr void set(Real x, Real y);
+    constexpr void set(const Vector2<Real>& v);
+    constexpr void setX(Real x);
+    constexpr void setY(Real y);
 
-    const Real& getX() const;
-    const Real& getY() const;
-    const Real& x() const;
-	const Real& y() const;
-	
-    Real& getX();
-    Real& getY();
-	Real& x();
-	Real& y();
-
-    const Real* const constData() const;
-    operator const Real* const () const;
-    Real operator () (const Vector2<Real>& v) const;
-    bool operator () (const Vector2<Real>& u, const Vector2<Real>& v) const;
-
-    Real& operator [] (std::size_t index);
-    const Real& operator [] (std::size_t index) const;
-
-    friend Vector2<Real> operator + <> (const Vector2<Real>& u, const Vector2<Real>& v);
-    friend Vector2<Real> operator - <> (const Vector2<Real>& u, const Vector2<Real>& v);
-    friend Vector2<Real> operator - <> (const Vector2<Real>& v);
-    friend Vector2<Real> operator * <> (const Vector2<Real>& v, Real scalar);
-    friend Vector2<Real> operator * <> (Real scalar, const Vector2<Real>& v);
-    friend Vector2<Real> operator / <> (const Vector2<Real>& v, Real scalar);
+    constexpr const Real& getX() const;
+    constexpr const Real& getY() const;
+    constexpr const Real& x() const;
+	constexpr const Real& y() const;
+
+    constexpr Real& getX();
+    constexpr Real& getY();
+	constexpr Real& x();
+	constexpr Real& y();
+
+    constexpr const Real* const constData() const;
+    constexpr operator const Real* const () const;
+    constexpr Real operator () (const Vector2<Real>& v) const;
+    constexpr bool operator () (const Vector2<Real>& u, const Vector2<Real>& v) const;
+
+    constexpr Real& operator [] (std::size_t index);
+    constexpr const Real& operator [] (std::size_t index) const;
+
+    friend constexpr Vector2<Real> operator + <> (const Vector2<Real>& u, const Vector2<Real>& v);
+    friend constexpr Vector2<Real> operator - <> (const Vector2<Real>& u, const Vector2<Real>& v);
+    friend constexpr Vector2<Real> operator - <> (const Vector2<Real>& v);
+    friend constexpr Vector2<Real> operator * <> (const Vector2<Real>& v, Real scalar);
+    friend constexpr Vector2<Real> operator * <> (Real scalar, const Vector2<Real>& v);
+    friend constexpr Vector2<Real> operator / <> (const Vector2<Real>& v, Real scalar);
 
     friend std::ostream& operator << <> (std::ostream& out, const Vector2<Real>& v);
     friend std::istream& operator >> <> (std::istream& in, Vector2<Real>& v);
 
-    Vector2<Real> operator - (const Vector2<Real>& v) const;
-	Vector2<Real> operator + (const Vector2<Real>& v) const;
-	Vector2<Real> operator * (const Real& scalar) const;
-	Vector2<Real> operator * (const Vector2<Real>& v) const;
+    constexpr Vector2<Real> operator - (const Vector2<Real>& v) const;
+	constexpr Vector2<Real> operator + (const Vector2<Real>& v) const;
+	constexpr Vector2<Real> operator * (const Real& scalar) const;
+	constexpr Vector2<Real> operator * (const Vector2<Real>& v) const;
 
-    Vector2<Real>& operator = (const Vector2<Real>& v);
+    constexpr Vector2<Real>& operator = (const Vector2<Real>& v);
 
-    Vector2<Real>& operator += (const Vector2<Real>& v);
-    Vector2<Real>& operator -= (const Vector2<Real>& v);
-    Vector2<Real>& operator *= (const Vector2<Real>& v);
-    Vector2<Real>& operator *= (Real scalar);
+    constexpr Vector2<Real>& operator += (const Vector2<Real>& v);
+    constexpr Vector2<Real>& operator -= (const Vector2<Real>& v);
+    constexpr Vector2<Real>& operator *= (const Vector2<Real>& v);
+    constexpr Vector2<Real>& operator *= (Real scalar);
 
-    bool operator == (const Vector2<Real>& v) const;
-	bool operator != (const Vector2<Real>& v) const;
+    constexpr bool operator == (const Vector2<Real>& v) const;
+	constexpr bool operator != (const Vector2<Real>& v) const;
 	
     bool operator < (const Vector2<Real>& v);
     bool operator <= (const Vector2<Real>& v);
     bool operator > (const Vector2<Real>& v);
     bool operator >= (const Vector2<Real>& v);
 
-    static Vector2<Real> Add(const Vector2<Real>& u, const Vector2<Real>& v);
-    static Vector2<Real> Subtract(const Vector2<Real>& u, const Vector2<Real>& v);
-    static Vector2<Real> Multiply(Real scalar, const Vector2<Real>& v);
+    static constexpr Vector2<Real> Add(const Vector2<Real>& u, const Vector2<Real>& v);
+    static constexpr Vector2<Real> Subtract(const Vector2<Real>& u, const Vector2<Real>& v);
+    static constexpr Vector2<Real> Multiply(Real scalar, const Vector2<Real>& v);
     static Vector2<Real> Normalize(const Vector2<Real>& v);
     static Vector2<Real> LinearInterpolation(const Vector2<Real>& u, const Vector2<Real>& v, Real t);
     static Vector2<Real> Project(const Vector2<Real>& u, const Vector2<Real>& v);
 
     static double Angle(const Vector2<Real>& u, const Vector2<Real>& v);
-    static double Dot(const Vector2<Real>& u, const Vector2<Real>& v);
+    static constexpr double Dot(const Vector2<Real>& u, const Vector2<Real>& v);
     static double Magnitude(const Vector2<Real>& v);
     static double Norm(const Vector2<Real>& v);
     static double NormSquared(const Vector2<Real>& v);
@@ -183,57 +183,54 @@ public:
     static double Distance(const Vector2<Real>& u, const Vector2<Real>& v);
     static double DistanceSquared(const Vector2<Real>& u, const Vector2<Real>& v);
 
-    static Vector2<Real> Zero();
-	static Vector2<Real> UnitX();
-	static Vector2<Real> UnitY();
-    static Vector2<Real> UnitNX();
-    static Vector2<Real> UnitNY();
+    static constexpr Vector2<Real> Zero();
+	static constexpr Vector2<Real> UnitX();
+	static constexpr Vector2<Real> UnitY();
+    static constexpr Vector2<Real> UnitNX();
+    static constexpr Vector2<Real> UnitNY();
 
 protected:
     Real data[COMPONENT_COUNT];
 };
 
 template <typename Real>
-Vector2<Real>::Vector2(Real x, Real y) {
+constexpr Vector2<Real>::Vector2(Real x, Real y) : data() {
     this->data[X] = x;
     this->data[Y] = y;
 }
 
 template <typename Real>
-Vector2<Real>::Vector2(const Vector2<Real>& v) {
+constexpr Vector2<Real>::Vector2(const Vector2<Real>& v) : data() {
     this->data[X] = v.data[X];
     this->data[Y] = v.data[Y];
 }
 
 template <typename Real>
-Vector2<Real>::Vector2(Real v[2]) {
+constexpr Vector2<Real>::Vector2(Real v[2]) : data() {
     this->data[X] = v[0];
     this->data[Y] = v[1];
 }
 
 template <typename Real>
-Vector2<Real>::Vector2(const Vector2<Real>& from, const Vector2<Real>& to) {
+constexpr Vector2<Real>::Vector2(const Vector2<Real>& from, const Vector2<Real>& to) : data() {
     this->data[X] = to.data[X] - from.data[X];
     this->data[Y] = to.data[Y] - from.data[Y];
 }
 
 template <typename Real>
-Vector2<Real>::~Vector2() {}
-
-template <typename Real>
-void Vector2<Real>::add(const Vector2<Real>& v) {
+constexpr void Vector2<Real>::add(const Vector2<Real>& v) {
     this->data[X] += v.data[X];
     this->data[Y] += v.data[Y];
 }
 
 template <typename Real>
-void Vector2<Real>::subtract(const Vector2<Real>& v) {
+constexpr void Vector2<Real>::subtract(const Vector2<Real>& v) {
     this->data[X] -= v.data[X];
     this->data[Y] -= v.data[Y];
 }
 
 template <typename Real>
-void Vector2<Real>::multiply(Real scalar) {
+constexpr void Vector2<Real>::multiply(Real scalar) {
     this->data[X] *= scalar;
     this->data[y] *= scalar;
 }
@@ -246,19 +243,19 @@ void Vector2<Real>::normalize() {
 }
 
 template <typename Real>
-void Vector2<Real>::inverse() {
+constexpr void Vector2<Real>::inverse() {
     this->data[X] = -this->data[X];
     this->data[Y] = -this->data[Y];
 }
     
 template <typename Real>
-void Vector2<Real>::zero() {
+constexpr void Vector2<Real>::zero() {
     this->data[X] = Real(0);
     this->data[Y] = Real(0);
 }
 
 template <typename Real>
-bool Vector2<Real>::isZero(Real epsilon) {
+constexpr bool Vector2<Real>::isZero(Real epsilon) {
     if ( (this->data[X] > -epsilon) && 
          (this->data[X] < epsilon ) &&
          (this->data[Y] > -epsilon) &&
@@ -268,8 +265,8 @@ bool Vector2<Real>::isZero(Real epsilon) {
 }
 
 template <typename Real>
-bool Vector2<Real>::isEqual(const Vector2<Real>& v) {
-    if ( *this == vector ) return true;
+constexpr bool Vector2<Real>::isEqual(const Vector2<Real>& v) {
+    if ( *this == v ) return true;
     return false;
 }
 
@@ -297,7 +294,7 @@ Vector2<Real> Vector2<Real>::linearInterpolation(const Vector2<Real>& v, Real t)
 }
 
 template <typename Real>
-double Vector2<Real>::dot(const Vector2<Real>& v) const {
+constexpr double Vector2<Real>::dot(const Vector2<Real>& v) const {
     return Vector2<Real>::Dot(*this, v);
 }
     
@@ -342,102 +339,102 @@ double Vector2<Real>::distanceSquared(const Vector2<Real>& v) const {
 }
 
 template <typename Real>
-void Vector2<Real>::set(Real x, Real y) {
+constexpr void Vector2<Real>::set(Real x, Real y) {
     this->data[X] = x;
     this->data[Y] = y;
 }
 
 template <typename Real>
-void Vector2<Real>::set(const Vector2<Real>& v) {
+constexpr void Vector2<Real>::set(const Vector2<Real>& v) {
     this->data[X] = v.data[X];
     this->data[Y] = v.data[Y];
 }
 
 template <typename Real>
-void Vector2<Real>::setX(Real x) {
+constexpr void Vector2<Real>::setX(Real x) {
     this->data[Y] = y;
 }
 
 template <typename Real>
-void Vector2<Real>::setY(Real y) {
+constexpr void Vector2<Real>::setY(Real y) {
     this->data[Y] = y;
 }
 
 template <typename Real>
-const Real& Vector2<Real>::getX() const {
+constexpr const Real& Vector2<Real>::getX() const {
     return this->data[X];
 }
 
 template <typename Real>
-const Real& Vector2<Real>::getY() const {
+constexpr const Real& Vector2<Real>::getY() const {
     return this->data[Y];
 }
 
 template <typename Real>
-const Real& Vector2<Real>::x() const {
+constexpr const Real& Vector2<Real>::x() const {
     return this->data[X];
 }
 
 template <typename Real>
-const Real& Vector2<Real>::y() const {
+constexpr const Real& Vector2<Real>::y() const {
     return this->data[Y];
 }
 	
 template <typename Real>
-Real& Vector2<Real>::getX() {
+constexpr Real& Vector2<Real>::getX() {
     return this->data[X];
 }
 
 template <typename Real>
-Real& Vector2<Real>::getY() {
+constexpr Real& Vector2<Real>::getY() {
     return this->data[Y];
 }
 
 template <typename Real>
-Real& Vector2<Real>::x() {
+constexpr Real& Vector2<Real>::x() {
     return this->data[X];
 }
 
 template <typename Real>
-Real& Vector2<Real>::y() {
+constexpr Real& Vector2<Real>::y() {
     return this->data[Y];
 }
 
 template <typename Real>
-const Real* const Vector2<Real>::constData() const {
+constexpr const Real* const Vector2<Real>::constData() const {
     return this->data;
 }
 
 template <typename Real>
-Vector2<Real>::operator const Real* const () const {
+constexpr Vector2<Real>::operator const Real* const () const {
     return this->data;
 }
 
 template <typename Real>
-Real Vector2<Real>::operator () (const Vector2<Real>& v) const {
+constexpr Real Vector2<Real>::operator () (const Vector2<Real>& v) const {
     return this->data[X] + this->data[Y];
 }
 
 template <typename Real>
-bool Vector2<Real>::operator () (const Vector2<Real>& u, const Vector2<Real>& v) const {
+constexpr bool Vector2<Real>::operator () (const Vector2<Real>& u, const Vector2<Real>& v) const {
     if ( u.data[X] == v.data[X] && u.data[Y] == v.data[Y] ) return true;
     return false;
 }
 
 template <typename Real>
-Real& Vector2<Real>::operator [] (std::size_t index) {
-    if ( index >= COMPONENT_COUNT ) throw std::exception("[Vector2:[]] Error: Index out of bounds.");
+constexpr Real& Vector2<Real>::operator [] (std::size_t index) {
+    if ( index >= COMPONENT_COUNT ) throw std::out_of_range("[Vector2:[]] Error: Index out of bounds.");
     return this->data[index];
 }
 
 template <typename Real>
-const Real& Vector2<Real>::operator [] (std::size_t index) const {
-    if ( index >= COMPONENT_COUNT ) throw std::exception("[Vector2:[]] Error: Index out of bounds.");
+constexpr const Real& Vector2<Real>::operator [] (std::size_t index) const {
+    if ( index >= COMPONENT_COUNT ) throw std::out_of_range("[Vector2:[]] Error: Index out of bounds.");
     return this->data[index];
 }
 
 template <typename Real>
-Vector2<Real> operator + (const Vector2<Real>& u, const Vector2<Real>& v) {
+constexpr Vector2<Real> operator + (const Vector2<Real>& u, const Vector2<Real>& v) {
     Vector2<Real> result;
     result.data[Vector2<Real>::X] = u.data[Vector2<Real>::X] + v.data[Vector2<Real>::X];
     result.data[Vector2<Real>::Y] = u.data[Vector2<Real>::Y] + v.data[Vector2<Real>::Y];
@@ -445,7 +442,7 @@ Vector2<Real> operator + (const Vector2<Real>& u, const Vector2<Real>& v) {
 }
 
 template <typename Real>
-Vector2<Real> operator - (const Vector2<Real>& u, const Vector2<Real>& v) {
+constexpr Vector2<Real> operator - (const Vector2<Real>& u, const Vector2<Real>& v) {
     Vector2<Real> result;
     result.data[Vector2<Real>::X] = u.data[Vector2<Real>::X] - v.data[Vector2<Real>::X];
     result.data[Vector2<Real>::Y] = u.data[Vector2<Real>::Y] - v.data[Vector2<Real>::Y];
@@ -453,12 +450,12 @@ Vector2<Real> operator - (const Vector2<Real>& u, const Vector2<Real>& v) {
 }
 
 template <typename Real>
-Vector2<Real> operator - (const Vector2<Real>& v) {
+constexpr Vector2<Real> operator - (const Vector2<Real>& v) {
     return Vector2<Real>(-v.data[Vector2<Real>::X], -v.data[Vector2<Real>::Y]);
 }
 
 template <typename Real>
-Vector2<Real> operator * (const Vector2<Real>& v, Real scalar) {
+constexpr Vector2<Real> operator * (const Vector2<Real>& v, Real scalar) {
     Vector2<Real> result;
     result.data[Vector2<Real>::X] = v.data[Vector2<Real>::X] * scalar;
     result.data[Vector2<Real>::Y] = v.data[Vector2<Real>::Y] * scalar;
@@ -466,7 +463,7 @@ Vector2<Real> operator * (const Vector2<Real>& v, Real scalar) {
 }
 
 template <typename Real>
-Vector2<Real> operator * (Real scalar, const Vector2<Real>& v) {
+constexpr Vector2<Real> operator * (Real scalar, const Vector2<Real>& v) {
     Vector2<Real> result;
     result.data[Vector2<Real>::X] = scalar * v.data[Vector2<Real>::X];
     result.data[Vector2<Real>::Y] = scalar * v.data[Vector2<Real>::Y];
@@ -474,7 +471,7 @@ Vector2<Real> operator * (Real scalar, const Vector2<Real>& v) {
 }
 
 template <typename Real>
-Vector2<Real> operator / (const Vector2<Real>& v, Real scalar) {
+constexpr Vector2<Real> operator / (const Vector2<Real>& v, Real scalar) {
     Vector2<Real> result;
     result.data[Vector2<Real>::X] = v.data[Vector2<Real>::X] / scalar;
     result.data[Vector2<Real>::Y] = v.data[Vector2<Real>::Y] / scalar;
@@ -496,7 +493,7 @@ std::istream& operator >> (std::istream& in, Vector2<Real>& v) {
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::operator - (const Vector2<Real>& v) const {
+constexpr Vector2<Real> Vector2<Real>::operator - (const Vector2<Real>& v) const {
     Vector2<Real> result;
     result.data[X] = this->data[X] - v.data[X];
     result.data[Y] = this->data[Y] - v.data[Y];
@@ -504,7 +501,7 @@ Vector2<Real> Vector2<Real>::operator - (const Vector2<Real>& v) const {
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::operator + (const Vector2<Real>& v) const {
+constexpr Vector2<Real> Vector2<Real>::operator + (const Vector2<Real>& v) const {
     Vector2<Real> result;
     result.data[X] = this->data[X] + v.data[X];
     result.data[Y] = this->data[Y] + v.data[Y];
@@ -512,7 +509,7 @@ Vector2<Real> Vector2<Real>::operator + (const Vector2<Real>& v) const {
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::operator * (const Real& scalar) const {
+constexpr Vector2<Real> Vector2<Real>::operator * (const Real& scalar) const {
     Vector2<Real> result;
     result.data[X] = this->data[X] * scalar;
     result.data[Y] = this->data[Y] * scalar;
@@ -520,7 +517,7 @@ Vector2<Real> Vector2<Real>::operator * (const Real& scalar) const {
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::operator * (const Vector2<Real>& v) const {
+constexpr Vector2<Real> Vector2<Real>::operator * (const Vector2<Real>& v) const {
     Vector2<Real> result;
     result.data[X] = this->data[X] * v.data[X];
     result.data[Y] = this->data[Y] * v.data[Y];
@@ -528,7 +525,7 @@ Vector2<Real> Vector2<Real>::operator * (const Vector2<Real>& v) const {
 }
 
 template <typename Real>
-Vector2<Real>& Vector2<Real>::operator = (const Vector2<Real>& v) {
+constexpr Vector2<Real>& Vector2<Real>::operator = (const Vector2<Real>& v) {
     if ( this == &v ) return *this;
     this->data[X] = v.data[X];
     this->data[Y] = v.data[Y];
@@ -536,43 +533,43 @@ Vector2<Real>& Vector2<Real>::operator = (const Vector2<Real>& v) {
 }
 
 template <typename Real>
-Vector2<Real>& Vector2<Real>::operator += (const Vector2<Real>& v) {
+constexpr Vector2<Real>& Vector2<Real>::operator += (const Vector2<Real>& v) {
     this->data[X] += v.data[X];
     this->data[Y] += v.data[Y];
     return *this;
 }
 
 template <typename Real>
-Vector2<Real>& Vector2<Real>::operator -= (const Vector2<Real>& v) {
+constexpr Vector2<Real>& Vector2<Real>::operator -= (const Vector2<Real>& v) {
     this->data[X] -= v.data[X];
     this->data[Y] -= v.data[Y];
     return *this;
 }
 
 template <typename Real>
-Vector2<Real>& Vector2<Real>::operator *= (const Vector2<Real>& v) {
+constexpr Vector2<Real>& Vector2<Real>::operator *= (const Vector2<Real>& v) {
     this->data[X] *= v.data[X];
     this->data[Y] *= v.data[Y];
     return *this;
 }
 
 template <typename Real>
-Vector2<Real>& Vector2<Real>::operator *= (Real scalar) {
+constexpr Vector2<Real>& Vector2<Real>::operator *= (Real scalar) {
     this->data[X] *= scalar;
     this->data[Y] *= scalar;
     return *this;
 }
 
 template <typename Real>
-bool Vector2<Real>::operator == (const Vector2<Real>& v) const {
+constexpr bool Vector2<Real>::operator == (const Vector2<Real>& v) const {
     if ( this->data[X] == v.data[X] && 
          this->data[Y] == v.data[Y] ) return true;
     return false;
 }
 
 template <typename Real>
-bool Vector2<Real>::operator != (const Vector2<Real>& v) const {
-    return !(*this == vector);
+constexpr bool Vector2<Real>::operator != (const Vector2<Real>& v) const {
+    return !(*this == v);
 }
 	
 template <typename Real>
@@ -600,7 +597,7 @@ bool Vector2<Real>::operator >= (const Vector2<Real>& v) {
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::Add(const Vector2<Real>& u, const Vector2<Real>& v) {
+constexpr Vector2<Real> Vector2<Real>::Add(const Vector2<Real>& u, const Vector2<Real>& v) {
     Vector2<Real> result;
     result.data[X] = u.data[X] + v.data[X];
     result.data[Y] = u.data[Y] + v.data[Y];
@@ -608,7 +605,7 @@ Vector2<Real> Vector2<Real>::Add(const Vector2<Real>& u, const Vector2<Real>& v)
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::Subtract(const Vector2<Real>& u, const Vector2<Real>& v) {
+constexpr Vector2<Real> Vector2<Real>::Subtract(const Vector2<Real>& u, const Vector2<Real>& v) {
     Vector2<Real> result;
     result.data[X] = u.data[X] - v.data[X];
     result.data[Y] = u.data[Y] - v.data[Y];
@@ -616,7 +613,7 @@ Vector2<Real> Vector2<Real>::Subtract(const Vector2<Real>& u, const Vector2<Real
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::Multiply(Real scalar, const Vector2<Real>& v) {
+constexpr Vector2<Real> Vector2<Real>::Multiply(Real scalar, const Vector2<Real>& v) {
     Vector2<Real> result;
     result.data[X] = scalar * v.data[X];
     result.data[Y] = scalar * v.data[Y];
@@ -634,7 +631,7 @@ Vector2<Real> Vector2<Real>::Normalize(const Vector2<Real>& v) {
 
 template <typename Real>
 Vector2<Real> Vector2<Real>::LinearInterpolation(const Vector2<Real>& u, const Vector2<Real>& v, Real t) {
-    return (a * t) + b * (Real(1) - t);
+    return u * (Real(1) - t) + v * t;
 }
 
 template <typename Real>
@@ -648,11 +645,11 @@ Vector2<Real> Vector2<Real>::Project(const Vector2<Real>& u, const Vector2<Real>
 
 template <typename Real>
 double Vector2<Real>::Angle(const Vector2<Real>& u, const Vector2<Real>& v) {
-    return std::acos((this->data[X] * vector.data[X] + this->data[Y] * vector.data[Y]) / (this->norm() * vector.norm()));
+    return std::acos(Vector2<Real>::Dot(u, v) / (u.norm() * v.norm()));
 }
 
 template <typename Real>
-double Vector2<Real>::Dot(const Vector2<Real>& u, const Vector2<Real>& v) {
+constexpr double Vector2<Real>::Dot(const Vector2<Real>& u, const Vector2<Real>& v) {
     return u.data[X] * v.data[X] + u.data[Y] * v.data[Y];
 }
 
@@ -692,27 +689,27 @@ double Vector2<Real>::DistanceSquared(const Vector2<Real>& u, const Vector2<Real
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::Zero() {
+constexpr Vector2<Real> Vector2<Real>::Zero() {
     return Vector2<Real>();
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::UnitX() {
+constexpr Vector2<Real> Vector2<Real>::UnitX() {
     return Vector2<Real>(Real(1), Real(0));
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::UnitY() {
+constexpr Vector2<Real> Vector2<Real>::UnitY() {
     return Vector2<Real>(Real(0), Real(1));
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::UnitNX() {
+constexpr Vector2<Real> Vector2<Real>::UnitNX() {
     return Vector2<Real>(Real(-1), Real(0));
 }
 
 template <typename Real>
-Vector2<Real> Vector2<Real>::UnitNY() {
+constexpr Vector2<Real> Vector2<Real>::UnitNY() {
     return Vector2<Real>(Real(0), Real(-1));
 }
 
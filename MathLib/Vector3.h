@@ -28,29 +28,38 @@
 
 #include <iostream>
 #include <cmath>
+#include <cstddef>
 #include <type_traits>
+#include <stdexcept>
 #include <iomanip>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#endif
 
 template <typename Real>
 class Vector3;
 
+/* Defined in VectorExpression.h, which must be included to use the expression members. */
+template <typename Real, std::size_t N, typename Derived>
+class VectorExpression;
+
 template <typename Real>
-Vector3<Real> operator + (const Vector3<Real>& u, const Vector3<Real>& v);
+constexpr Vector3<Real> operator + (const Vector3<Real>& u, const Vector3<Real>& v);
 
 template <typename Real>
-Vector3<Real> operator - (const Vector3<Real>& u, const Vector3<Real>& v);
+constexpr Vector3<Real> operator - (const Vector3<Real>& u, const Vector3<Real>& v);
 
 template <typename Real>
-Vector3<Real> operator - (const Vector3<Real>& v);
+constexpr Vector3<Real> operator - (const Vector3<Real>& v);
 
 template <typename Real>
-Vector3<Real> operator * (const Vector3<Real>& v, Real scalar);
+constexpr Vector3<Real> operator * (const Vector3<Real>& v, Real scalar);
 
 template <typename Real>
-Vector3<Real> operator * (Real scalar, const Vector3<Real>& v);
+constexpr Vector3<Real> operator * (Real scalar, const Vector3<Real>& v);
 
 template <typename Real>
-Vector3<Real> operator / (const Vector3<Real>& v, Real scalar);
+constexpr Vector3<Real> operator / (const Vector3<Real>& v, Real scalar);
 
 template <typename Real>
 std::ostream& operator << (std::ostream& out, const Vector3<Real>& vector);
@@ -65,10 +74,13 @@ std::istream& operator >> (std::istream& in, Vector3<Real>& vector);
  * 
  * Implements the mathematical defintion of a Vector3. Do not perform long 
  * "temp-chains" using overloaded operators. This implementaton does not utilize 
- * template meta programming.
+ * template meta programming; wrap the operands with Lazy() from VectorExpression.h
+ * to evaluate a chain without temporaries.
  * See: http://www.flipcode.com/archives/Faster_Vector_Math_Using_Templates.shtml
  *
- * This implementation also foregoes vectorization (SSE).
+ * This implementation also foregoes vectorization (SSE). For SIMD processing of
+ * whole arrays of vectors see VectorBatch.h.
+ * Everything that does not need a square root is constexpr (C++14).
  * This implementation is aimed at a flexibility while preserving 
  * understandability and complete modularity.
  */
@@ -80,179 +92,203 @@ class Vector3 {
     enum Axis { X, Y, Z, COMPONENT_COUNT };
 
 public:
-    Vector3(Real x = Real(0), Real y = Real(0), Real z = Real(0));
-    Vector3(const Vector3<Real>& v);
-    Vector3(Real v[3]);
-    Vector3(const Vector3<Real>& from, const Vector3<Real>& to);
-    ~Vector3();
-
-    void add(const Vector3<Real>& v);
-    void subtract(const Vector3<Real>& v);
-    void multiply(Real scalar);
+    constexpr Vector3(Real x = Real(0), Real y = Real(0), Real z = Real(0));
+    constexpr Vector3(const Vector3<Real>& v);
+    constexpr Vector3(Real v[3]);
+    constexpr Vector3(const Vector3<Real>& from, const Vector3<Real>& to);
+
+    constexpr void add(const Vector3<Real>& v);
+    constexpr void subtract(const Vector3<Real>& v);
+    constexpr void multiply(Real scalar);
     void normalize();
-    void inverse();
-    
-    void zero();
-    bool isZero(Real epsilon);
-    bool isEqual(const Vector3<Real>& v);
+    constexpr void inverse();
+
+    constexpr void zero();
+    constexpr bool isZero(Real epsilon);
+    constexpr bool isEqual(const Vector3<Real>& v);
     bool isEquivalent(const Vector3<Real>& v, Real epsilon) const;
 
     template <typename RealCastType>
     Vector3<RealCastType> cast();
 
     Vector3<Real> normalized() const;
-    Vector3<Real> cross(const Vector3<Real>& v) const;
+    constexpr Vector3<Real> cross(const Vector3<Real>& v) const;
     Vector3<Real> linearInterpolation(const Vector3<Real>& v, Real t);
-    double dot(const Vector3<Real>& v) const;
+    constexpr double dot(const Vector3<Real>& v) const;
     
     double angle(const Vector3<Real>& v) const;
     double magnitude() const;
     double length() const;
-    double lengthSquared() const;
+    constexpr double lengthSquared() const;
     double norm() const;
-    double normSquared() const;
+    constexpr double normSquared() const;
     double distance(const Vector3<Real>& v) const;
-    double distanceSquared(const Vector3<Real>& v) const;
-
-    void swapXY();
-    void swapXZ();
-    void swapYZ();
-
-    void set(Real x, Real y, Real z);
-    void set(const Vector3<Real>& v);
-    void setX(Real x);
-    void setY(Real y);
-    void setZ(Real z);
-
-    const Real& getX() const;
-    const Real& getY() const;
-    const Real& getZ() const;
-    const Real& x() const;
-	const Real& y() const;
-	const Real& z() const;
-	
-    Real& getX();
-    Real& getY();
-    Real& getZ();
-	Real& x();
-	Real& y();
-	Real& z();
-
-    const Real* const constData() const;
-    operator const Real* const () const;
-    Real operator () (const Vector3<Real>& v) const;
-    bool operator () (const Vector3<Real>& u, const Vector3<Real>& v) const;
-
-    Real& operator [] (std::size_t index);
-
-    friend Vector3<Real> operator + <> (const Vector3<Real>& u, const Vector3<Real>& v);
-    friend Vector3<Real> operator - <> (const Vector3<Real>& u, const Vector3<Real>& v);
-    friend Vector3<Real> operator - <> (const Vector3<Real>& v);
-    friend Vector3<Real> operator * <> (const Vector3<Real>& v, Real scalar);
-    friend Vector3<Real> operator * <> (Real scalar, const Vector3<Real>& v);
-    friend Vector3<Real> operator / <> (const Vector3<Real>& v, Real scalar);
+    constexpr double distanceSquared(const Vector3<Real>& v) const;
+
+    constexpr void swapXY();
+    constexpr void swapXZ();
+    constexpr void swapYZ();
+
+    constexpr void set(Real x, Real y, Real z);
+    constexpr void set(const Vector3<Real>& v);
+    constexpr void setX(Real x);
+    constexpr void setY(Real y);
+    constexpr void setZ(Real z);
+
+    constexpr const Real& getX() const;
+    constexpr const Real& getY() const;
+    constexpr const Real& getZ() const;
+    constexpr const Real& x() const;
+	constexpr const Real& y() const;
+	constexpr const Real& z() const;
+
+    constexpr Real& getX();
+    constexpr Real& getY();
+    constexpr Real& getZ();
+	constexpr Real& x();
+	constexpr Real& y();
+	constexpr Real& z();
+
+    constexpr const Real* const constData() const;
+    constexpr operator const Real* const () const;
+    constexpr Real operator () (const Vector3<Real>& v) const;
+    constexpr bool operator () (const Vector3<Real>& u, const Vector3<Real>& v) const;
+
+    constexpr Real& operator [] (std::size_t index);
+
+    friend constexpr Vector3<Real> operator + <> (const Vector3<Real>& u, const Vector3<Real>& v);
+    friend constexpr Vector3<Real> operator - <> (const Vector3<Real>& u, const Vector3<Real>& v);
+    friend constexpr Vector3<Real> operator - <> (const Vector3<Real>& v);
+    friend constexpr Vector3<Real> operator * <> (const Vector3<Real>& v, Real scalar);
+    friend constexpr Vector3<Real> operator * <> (Real scalar, const Vector3<Real>& v);
+    friend constexpr Vector3<Real> operator / <> (const Vector3<Real>& v, Real scalar);
 
     friend std::ostream& operator << <> (std::ostream& out, const Vector3<Real>& v);
     friend std::istream& operator >> <> (std::istream& in, Vector3<Real>& v);
 
-    Vector3<Real> operator - (const Vector3<Real>& v) const;
-	Vector3<Real> operator + (const Vector3<Real>& v) const;
-    Vector3<Real> operator / (const Real& scalar) const;
-	Vector3<Real> operator * (const Real& scalar) const;
-	Vector3<Real> operator * (const Vector3<Real>& v) const;
-
-    Vector3<Real>& operator = (const Vector3<Real>& v);
-
-    Vector3<Real>& operator += (const Vector3<Real>& v);
-    Vector3<Real>& operator -= (const Vector3<Real>& v);
-    Vector3<Real>& operator *= (const Vector3<Real>& v);
-    Vector3<Real>& operator *= (Real scalar);
-
-    bool operator == (const Vector3<Real>& v) const;
-	bool operator != (const Vector3<Real>& v) const;
+    constexpr Vector3<Real> operator - (const Vector3<Real>& v) const;
+	constexpr Vector3<Real> operator + (const Vector3<Real>& v) const;
+    constexpr Vector3<Real> operator / (const Real& scalar) const;
+	constexpr Vector3<Real> operator * (const Real& scalar) const;
+	constexpr Vector3<Real> operator * (const Vector3<Real>& v) const;
+
+    constexpr Vector3<Real>& operator = (const Vector3<Real>& v);
+
+    constexpr Vector3<Real>& operator += (const Vector3<Real>& v);
+    constexpr Vector3<Real>& operator -= (const Vector3<Real>& v);
+    constexpr Vector3<Real>& operator *= (const Vector3<Real>& v);
+    constexpr Vector3<Real>& operator *= (Real scalar);
+
+    /* Evaluate an expression built with Lazy() (VectorExpression.h) in one pass, without temporaries. */
+    template <typename E>
+    constexpr Vector3(const VectorExpression<Real, 3, E>& e);
+    template <typename E>
+    constexpr Vector3<Real>& operator = (const VectorExpression<Real, 3, E>& e);
+    template <typename E>
+    constexpr Vector3<Real>& operator += (const VectorExpression<Real, 3, E>& e);
+    template <typename E>
+    constexpr Vector3<Real>& operator -= (const VectorExpression<Real, 3, E>& e);
+
+    constexpr bool operator == (const Vector3<Real>& v) const;
+	constexpr bool operator != (const Vector3<Real>& v) const;
 	
     bool operator < (const Vector3<Real>& v);
     bool operator <= (const Vector3<Real>& v);
     bool operator > (const Vector3<Real>& v);
     bool operator >= (const Vector3<Real>& v);
 
-    static Vector3<Real> Add(const Vector3<Real>& u, const Vector3<Real>& v);
-    static Vector3<Real> Subtract(const Vector3<Real>& u, const Vector3<Real>& v);
-    static Vector3<Real> Multiply(Real scalar, const Vector3<Real>& v);
+    static constexpr Vector3<Real> Add(const Vector3<Real>& u, const Vector3<Real>& v);
+    static constexpr Vector3<Real> Subtract(const Vector3<Real>& u, const Vector3<Real>& v);
+    static constexpr Vector3<Real> Multiply(Real scalar, const Vector3<Real>& v);
     static Vector3<Real> Normalize(const Vector3<Real>& v);
-    static Vector3<Real> Cross(const Vector3<Real>& u, const Vector3<Real>& v);
+    static constexpr Vector3<Real> Cross(const Vector3<Real>& u, const Vector3<Real>& v);
     static Vector3<Real> LinearInterpolation(const Vector3<Real>& u, const Vector3<Real>& v, Real t);
     static Vector3<Real> Project(const Vector3<Real>& u, const Vector3<Real>& v);
 
     static double Angle(const Vector3<Real>& u, const Vector3<Real>& v);
-    static double Dot(const Vector3<Real>& u, const Vector3<Real>& v);
+    static constexpr double Dot(const Vector3<Real>& u, const Vector3<Real>& v);
     static double Magnitude(const Vector3<Real>& v);
     static double Norm(const Vector3<Real>& v);
-    static double NormSquared(const Vector3<Real>& v);
+    static constexpr double NormSquared(const Vector3<Real>& v);
     static double Length(const Vector3<Real>& v);
-    static double LengthSquared(const Vector3<Real>& v);
+    static constexpr double LengthSquared(const Vector3<Real>& v);
     static double Distance(const Vector3<Real>& u, const Vector3<Real>& v);
-    static double DistanceSquared(const Vector3<Real>& u, const Vector3<Real>& v);
-
-    static Vector3<Real> Zero();
-	static Vector3<Real> UnitX();
-	static Vector3<Real> UnitY();
-	static Vector3<Real> UnitZ();
-    static Vector3<Real> UnitNX();
-    static Vector3<Real> UnitNY();
-    static Vector3<Real> UnitNZ();
+    static constexpr double DistanceSquared(const Vector3<Real>& u, const Vector3<Real>& v);
+
+    /*
+     * The functions above return double whatever Real is. These compute and return
+     * Real instead, which avoids the float/double conversions in Vector3<float> code.
+     * FastNormalize() leaves a zero vector at zero.
+     */
+    static Real FastDot(const Vector3<Real>& u, const Vector3<Real>& v);
+    static Real FastNorm(const Vector3<Real>& v);
+    static Real FastNormSquared(const Vector3<Real>& v);
+    static Real FastDistance(const Vector3<Real>& u, const Vector3<Real>& v);
+    static Real FastDistanceSquared(const Vector3<Real>& u, const Vector3<Real>& v);
+    static Vector3<Real> FastNormalize(const Vector3<Real>& v);
+
+    /* 1 / sqrt(x) for x > 0. For float it uses the SSE estimate refined by one Newton-Raphson step when available. */
+    static Real InverseSqrt(Real x);
+
+    static constexpr Vector3<Real> Zero();
+	static constexpr Vector3<Real> UnitX();
+	static constexpr Vector3<Real> UnitY();
+	static constexpr Vector3<Real> UnitZ();
+    static constexpr Vector3<Real> UnitNX();
+    static constexpr Vector3<Real> UnitNY();
+    static constexpr Vector3<Real> UnitNZ();
 
 protected:
+    /* std::swap is not constexpr. */
+    static constexpr void Swap(Real& a, Real& b);
+
     Real data[COMPONENT_COUNT];
 };
 
 template <typename Real>
-Vector3<Real>::Vector3(Real x, Real y, Real z) {
+constexpr Vector3<Real>::Vector3(Real x, Real y, Real z) : data() {
     this->data[X] = x;
     this->data[Y] = y;
     this->data[Z] = z;
 }
 
 template <typename Real>
-Vector3<Real>::Vector3(const Vector3<Real>& v) {
+constexpr Vector3<Real>::Vector3(const Vector3<Real>& v) : data() {
     this->data[X] = v.data[X];
     this->data[Y] = v.data[Y];
     this->data[Z] = v.data[Z];
 }
 
 template <typename Real>
-Vector3<Real>::Vector3(Real v[3]) {
+constexpr Vector3<Real>::Vector3(Real v[3]) : data() {
     this->data[X] = v[0];
     this->data[Y] = v[1];
     this->data[Z] = v[2];
 }
 
 template <typename Real>
-Vector3<Real>::Vector3(const Vector3<Real>& from, const Vector3<Real>& to) {
+constexpr Vector3<Real>::Vector3(const Vector3<Real>& from, const Vector3<Real>& to) : data() {
     this->data[X] = to.data[X] - from.data[X];
     this->data[Y] = to.data[Y] - from.data[Y];
     this->data[Z] = to.data[Z] - from.data[Z];
 }
 
 template <typename Real>
-Vector3<Real>::~Vector3() {}
-
-template <typename Real>
-void Vector3<Real>::add(const Vector3<Real>& v) {
+constexpr void Vector3<Real>::add(const Vector3<Real>& v) {
     this->data[X] += v.data[X];
     this->data[Y] += v.data[Y];
     this->data[Z] += v.data[Z];
 }
 
 template <typename Real>
-void Vector3<Real>::subtract(const Vector3<Real>& v) {
+constexpr void Vector3<Real>::subtract(const Vector3<Real>& v) {
     this->data[X] -= v.data[X];
     this->data[Y] -= v.data[Y];
     this->data[Z] -= v.data[Z];
 }
 
 template <typename Real>
-void Vector3<Real>::multiply(Real scalar) {
+constexpr void Vector3<Real>::multiply(Real scalar) {
     this->data[X] *= scalar;
     this->data[Y] *= scalar;
     this->data[Z] *= scalar;
@@ -267,21 +303,21 @@ void Vector3<Real>::normalize() {
 }
 
 template <typename Real>
-void Vector3<Real>::inverse() {
+constexpr void Vector3<Real>::inverse() {
     this->data[X] = -this->data[X];
     this->data[Y] = -this->data[Y];
     this->data[Z] = -this->data[Z];
 }
     
 template <typename Real>
-void Vector3<Real>::zero() {
+constexpr void Vector3<Real>::zero() {
     this->data[X] = Real(0);
     this->data[Y] = Real(0);
     this->data[Z] = Real(0);
 }
 
 template <typename Real>
-bool Vector3<Real>::isZero(Real epsilon) {
+constexpr bool Vector3<Real>::isZero(Real epsilon) {
     if ( (this->data[X] > -epsilon) && 
          (this->data[X] < epsilon ) &&
          (this->data[Y] > -epsilon) &&
@@ -293,8 +329,8 @@ bool Vector3<Real>::isZero(Real epsilon) {
 }
 
 template <typename Real>
-bool Vector3<Real>::isEqual(const Vector3<Real>& v) {
-    if ( *this == vector ) return true;
+constexpr bool Vector3<Real>::isEqual(const Vector3<Real>& v) {
+    if ( *this == v ) return true;
     return false;
 }
 
@@ -318,7 +354,7 @@ Vector3<Real> Vector3<Real>::normalized() const {
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::cross(const Vector3<Real>& v) const {
+constexpr Vector3<Real> Vector3<Real>::cross(const Vector3<Real>& v) const {
     return Vector3<Real>::Cross(*this, v);
 }
 
@@ -328,7 +364,7 @@ Vector3<Real> Vector3<Real>::linearInterpolation(const Vector3<Real>& v, Real t)
 }
 
 template <typename Real>
-double Vector3<Real>::dot(const Vector3<Real>& v) const {
+constexpr double Vector3<Real>::dot(const Vector3<Real>& v) const {
     return Vector3<Real>::Dot(*this, v);
 }
 
@@ -348,7 +384,7 @@ double Vector3<Real>::length() const {
 }
 
 template <typename Real>
-double Vector3<Real>::lengthSquared() const {
+constexpr double Vector3<Real>::lengthSquared() const {
     return Vector3<Real>::LengthSquared(*this);
 }
 
@@ -358,7 +394,7 @@ double Vector3<Real>::norm() const {
 }
 
 template <typename Real>
-double Vector3<Real>::normSquared() const {
+constexpr double Vector3<Real>::normSquared() const {
     return Vector3<Real>::NormSquared(*this);
 }
 
@@ -368,143 +404,143 @@ double Vector3<Real>::distance(const Vector3<Real>& v) const {
 }
 
 template <typename Real>
-double Vector3<Real>::distanceSquared(const Vector3<Real>& v) const {
+constexpr double Vector3<Real>::distanceSquared(const Vector3<Real>& v) const {
     return Vector3<Real>::DistanceSquared(*this, v);
 }
 
 template <typename Real>
-void Vector3<Real>::swapXY() {
-    std::swap(this->data[X], this->data[Y]);
+constexpr void Vector3<Real>::swapXY() {
+    Swap(this->data[X], this->data[Y]);
 }
 
 template <typename Real>
-void Vector3<Real>::swapXZ() {
-    std::swap(this->data[X], this->data[Z]);
+constexpr void Vector3<Real>::swapXZ() {
+    Swap(this->data[X], this->data[Z]);
 }
 
 template <typename Real>
-void Vector3<Real>::swapYZ() {
-    std::swap(this->data[Y], this->data[Z]);
+constexpr void Vector3<Real>::swapYZ() {
+    Swap(this->data[Y], this->data[Z]);
 }
 
 template <typename Real>
-void Vector3<Real>::set(Real x, Real y, Real z) {
+constexpr void Vector3<Real>::set(Real x, Real y, Real z) {
     this->data[X] = x;
     this->data[Y] = y;
     this->data[Z] = z;
 }
 
 template <typename Real>
-void Vector3<Real>::set(const Vector3<Real>& v) {
+constexpr void Vector3<Real>::set(const Vector3<Real>& v) {
     this->data[X] = v.data[X];
     this->data[Y] = v.data[Y];
     this->data[Z] = v.data[Z];
 }
 
 template <typename Real>
-void Vector3<Real>::setX(Real x) {
+constexpr void Vector3<Real>::setX(Real x) {
     this->data[X] = x;
 }
 
 template <typename Real>
-void Vector3<Real>::setY(Real y) {
+constexpr void Vector3<Real>::setY(Real y) {
     this->data[Y] = y;
 }
 
 template <typename Real>
-void Vector3<Real>::setZ(Real z) {
+constexpr void Vector3<Real>::setZ(Real z) {
     this->data[Z] = z;
 }
 
 template <typename Real>
-const Real& Vector3<Real>::getX() const {
+constexpr const Real& Vector3<Real>::getX() const {
     return this->data[X];
 }
 
 template <typename Real>
-const Real& Vector3<Real>::getY() const {
+constexpr const Real& Vector3<Real>::getY() const {
     return this->data[Y];
 }
 
 template <typename Real>
-const Real& Vector3<Real>::getZ() const {
+constexpr const Real& Vector3<Real>::getZ() const {
     return this->data[Z];
 }
 
 template <typename Real>
-const Real& Vector3<Real>::x() const {
+constexpr const Real& Vector3<Real>::x() const {
     return this->data[X];
 }
 
 template <typename Real>
-const Real& Vector3<Real>::y() const {
+constexpr const Real& Vector3<Real>::y() const {
     return this->data[Y];
 }
 
 template <typename Real>
-const Real& Vector3<Real>::z() const {
+constexpr const Real& Vector3<Real>::z() const {
     return this->data[Z];
 }
 	
 template <typename Real>
-Real& Vector3<Real>::getX() {
+constexpr Real& Vector3<Real>::getX() {
     return this->data[X];
 }
 
 template <typename Real>
-Real& Vector3<Real>::getY() {
+constexpr Real& Vector3<Real>::getY() {
     return this->data[Y];
 }
 
 template <typename Real>
-Real& Vector3<Real>::getZ() {
+constexpr Real& Vector3<Real>::getZ() {
     return this->data[Z];
 }
 
 template <typename Real>
-Real& Vector3<Real>::x() {
+constexpr Real& Vector3<Real>::x() {
     return this->data[X];
 }
 
 template <typename Real>
-Real& Vector3<Real>::y() {
+constexpr Real& Vector3<Real>::y() {
     return this->data[Y];
 }
 
 template <typename Real>
-Real& Vector3<Real>::z() {
+constexpr Real& Vector3<Real>::z() {
     return this->data[Z];
 }
 
 template <typename Real>
-const Real* const Vector3<Real>::constData() const {
+constexpr const Real* const Vector3<Real>::constData() const {
     return this->data;
 }
 
 template <typename Real>
-Vector3<Real>::operator const Real* const () const {
+constexpr Vector3<Real>::operator const Real* const () const {
     return this->data;
 }
 
 template <typename Real>
-Real Vector3<Real>::operator () (const Vector3<Real>& v) const {
+constexpr Real Vector3<Real>::operator () (const Vector3<Real>& v) const {
     return this->data[X] + this->data[Y] + this->data[Z];
 }
 
 template <typename Real>
-bool Vector3<Real>::operator () (const Vector3<Real>& u, const Vector3<Real>& v) const {
+constexpr bool Vector3<Real>::operator () (const Vector3<Real>& u, const Vector3<Real>& v) const {
     if ( u.data[X] == v.data[X] && u.data[Y] == v.data[Y] && u.data[Z] == v.data[Z] ) return true;
     return false;
 }
 
 template <typename Real>
-Real& Vector3<Real>::operator [] (std::size_t index) {
-    if ( index >= COMPONENT_COUNT ) throw std::exception("[Vector3:[]] Error: Index out of bounds.");
+constexpr Real& Vector3<Real>::operator [] (std::size_t index) {
+    if ( index >= COMPONENT_COUNT ) throw std::out_of_range("[Vector3:[]] Error: Index out of bounds.");
     return this->data[index];
 }
 
 template <typename Real>
-Vector3<Real> operator + (const Vector3<Real>& u, const Vector3<Real>& v) {
+constexpr Vector3<Real> operator + (const Vector3<Real>& u, const Vector3<Real>& v) {
     Vector3<Real> result;
     result.data[Vector3<Real>::X] = u.data[Vector3<Real>::X] + v.data[Vector3<Real>::X];
     result.data[Vector3<Real>::Y] = u.data[Vector3<Real>::Y] + v.data[Vector3<Real>::Y];
@@ -513,7 +549,7 @@ Vector3<Real> operator + (const Vector3<Real>& u, const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real> operator - (const Vector3<Real>& u, const Vector3<Real>& v) {
+constexpr Vector3<Real> operator - (const Vector3<Real>& u, const Vector3<Real>& v) {
     Vector3<Real> result;
     result.data[Vector3<Real>::X] = u.data[Vector3<Real>::X] - v.data[Vector3<Real>::X];
     result.data[Vector3<Real>::Y] = u.data[Vector3<Real>::Y] - v.data[Vector3<Real>::Y];
@@ -522,12 +558,12 @@ Vector3<Real> operator - (const Vector3<Real>& u, const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real> operator - (const Vector3<Real>& v) {
+constexpr Vector3<Real> operator - (const Vector3<Real>& v) {
     return Vector3<Real>(-v.data[Vector3<Real>::X], -v.data[Vector3<Real>::Y], -v.data[Vector3<Real>::Z]);
 }
 
 template <typename Real>
-Vector3<Real> operator * (const Vector3<Real>& v, Real scalar) {
+constexpr Vector3<Real> operator * (const Vector3<Real>& v, Real scalar) {
     Vector3<Real> result;
     result.data[Vector3<Real>::X] = v.data[Vector3<Real>::X] * scalar;
     result.data[Vector3<Real>::Y] = v.data[Vector3<Real>::Y] * scalar;
@@ -536,7 +572,7 @@ Vector3<Real> operator * (const Vector3<Real>& v, Real scalar) {
 }
 
 template <typename Real>
-Vector3<Real> operator * (Real scalar, const Vector3<Real>& v) {
+constexpr Vector3<Real> operator * (Real scalar, const Vector3<Real>& v) {
     Vector3<Real> result;
     result.data[Vector3<Real>::X] = scalar * v.data[Vector3<Real>::X];
     result.data[Vector3<Real>::Y] = scalar * v.data[Vector3<Real>::Y];
@@ -545,7 +581,7 @@ Vector3<Real> operator * (Real scalar, const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real> operator / (const Vector3<Real>& v, Real scalar) {
+constexpr Vector3<Real> operator / (const Vector3<Real>& v, Real scalar) {
     Vector3<Real> result;
     result.data[Vector3<Real>::X] = v.data[Vector3<Real>::X] / scalar;
     result.data[Vector3<Real>::Y] = v.data[Vector3<Real>::Y] / scalar;
@@ -569,7 +605,7 @@ std::istream& operator >> (std::istream& in, Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::operator - (const Vector3<Real>& v) const {
+constexpr Vector3<Real> Vector3<Real>::operator - (const Vector3<Real>& v) const {
     Vector3<Real> result;
     result.data[X] = this->data[X] - v.data[X];
     result.data[Y] = this->data[Y] - v.data[Y];
@@ -578,7 +614,7 @@ Vector3<Real> Vector3<Real>::operator - (const Vector3<Real>& v) const {
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::operator + (const Vector3<Real>& v) const {
+constexpr Vector3<Real> Vector3<Real>::operator + (const Vector3<Real>& v) const {
     Vector3<Real> result;
     result.data[X] = this->data[X] + v.data[X];
     result.data[Y] = this->data[Y] + v.data[Y];
@@ -587,7 +623,7 @@ Vector3<Real> Vector3<Real>::operator + (const Vector3<Real>& v) const {
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::operator / (const Real& scalar) const {
+constexpr Vector3<Real> Vector3<Real>::operator / (const Real& scalar) const {
     Vector3<Real> result;
     result.data[X] = this->data[X] / scalar;
     result.data[Y] = this->data[Y] / scalar;
@@ -596,7 +632,7 @@ Vector3<Real> Vector3<Real>::operator / (const Real& scalar) const {
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::operator * (const Real& scalar) const {
+constexpr Vector3<Real> Vector3<Real>::operator * (const Real& scalar) const {
     Vector3<Real> result;
     result.data[X] = this->data[X] * scalar;
     result.data[Y] = this->data[Y] * scalar;
@@ -605,7 +641,7 @@ Vector3<Real> Vector3<Real>::operator * (const Real& scalar) const {
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::operator * (const Vector3<Real>& v) const {
+constexpr Vector3<Real> Vector3<Real>::operator * (const Vector3<Real>& v) const {
     Vector3<Real> result;
     result.data[X] = this->data[X] * v.data[X];
     result.data[Y] = this->data[Y] * v.data[Y];
@@ -614,7 +650,7 @@ Vector3<Real> Vector3<Real>::operator * (const Vector3<Real>& v) const {
 }
 
 template <typename Real>
-Vector3<Real>& Vector3<Real>::operator = (const Vector3<Real>& v) {
+constexpr Vector3<Real>& Vector3<Real>::operator = (const Vector3<Real>& v) {
     if ( this == &v ) return *this;
     this->data[X] = v.data[X];
     this->data[Y] = v.data[Y];
@@ -623,7 +659,7 @@ Vector3<Real>& Vector3<Real>::operator = (const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real>& Vector3<Real>::operator += (const Vector3<Real>& v) {
+constexpr Vector3<Real>& Vector3<Real>::operator += (const Vector3<Real>& v) {
     this->data[X] += v.data[X];
     this->data[Y] += v.data[Y];
     this->data[Z] += v.data[Z];
@@ -631,7 +667,7 @@ Vector3<Real>& Vector3<Real>::operator += (const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real>& Vector3<Real>::operator -= (const Vector3<Real>& v) {
+constexpr Vector3<Real>& Vector3<Real>::operator -= (const Vector3<Real>& v) {
     this->data[X] -= v.data[X];
     this->data[Y] -= v.data[Y];
     this->data[Z] -= v.data[Z];
@@ -639,7 +675,7 @@ Vector3<Real>& Vector3<Real>::operator -= (const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real>& Vector3<Real>::operator *= (const Vector3<Real>& v) {
+constexpr Vector3<Real>& Vector3<Real>::operator *= (const Vector3<Real>& v) {
     this->data[X] *= v.data[X];
     this->data[Y] *= v.data[Y];
     this->data[Z] *= v.data[Z];
@@ -647,7 +683,7 @@ Vector3<Real>& Vector3<Real>::operator *= (const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real>& Vector3<Real>::operator *= (Real scalar) {
+constexpr Vector3<Real>& Vector3<Real>::operator *= (Real scalar) {
     this->data[X] *= scalar;
     this->data[Y] *= scalar;
     this->data[Z] *= scalar;
@@ -655,7 +691,7 @@ Vector3<Real>& Vector3<Real>::operator *= (Real scalar) {
 }
 
 template <typename Real>
-bool Vector3<Real>::operator == (const Vector3<Real>& v) const {
+constexpr bool Vector3<Real>::operator == (const Vector3<Real>& v) const {
     if ( this->data[X] == v.data[X] && 
          this->data[Y] == v.data[Y] && 
          this->data[Z] == v.data[Z] ) return true;
@@ -663,8 +699,8 @@ bool Vector3<Real>::operator == (const Vector3<Real>& v) const {
 }
 
 template <typename Real>
-bool Vector3<Real>::operator != (const Vector3<Real>& v) const {
-    return !(*this == vector);
+constexpr bool Vector3<Real>::operator != (const Vector3<Real>& v) const {
+    return !(*this == v);
 }
 	
 template <typename Real>
@@ -692,7 +728,7 @@ bool Vector3<Real>::operator >= (const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::Add(const Vector3<Real>& u, const Vector3<Real>& v) {
+constexpr Vector3<Real> Vector3<Real>::Add(const Vector3<Real>& u, const Vector3<Real>& v) {
     Vector3<Real> result;
     result.data[X] = u.data[X] + v.data[X];
     result.data[Y] = u.data[Y] + v.data[Y];
@@ -701,7 +737,7 @@ Vector3<Real> Vector3<Real>::Add(const Vector3<Real>& u, const Vector3<Real>& v)
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::Subtract(const Vector3<Real>& u, const Vector3<Real>& v) {
+constexpr Vector3<Real> Vector3<Real>::Subtract(const Vector3<Real>& u, const Vector3<Real>& v) {
     Vector3<Real> result;
     result.data[X] = u.data[X] - v.data[X];
     result.data[Y] = u.data[Y] - v.data[Y];
@@ -710,7 +746,7 @@ Vector3<Real> Vector3<Real>::Subtract(const Vector3<Real>& u, const Vector3<Real
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::Multiply(Real scalar, const Vector3<Real>& v) {
+constexpr Vector3<Real> Vector3<Real>::Multiply(Real scalar, const Vector3<Real>& v) {
     Vector3<Real> result;
     result.data[X] = scalar * v.data[X];
     result.data[Y] = scalar * v.data[Y];
@@ -729,7 +765,7 @@ Vector3<Real> Vector3<Real>::Normalize(const Vector3<Real>& v) {
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::Cross(const Vector3<Real>& u, const Vector3<Real>& v) {
+constexpr Vector3<Real> Vector3<Real>::Cross(const Vector3<Real>& u, const Vector3<Real>& v) {
     Vector3<Real> result;
     result.data[X] = ((u.data[Y] * v.data[Z]) - (u.data[Z] * v.data[Y]));
     result.data[Y] = ((u.data[Z] * v.data[X]) - (u.data[X] * v.data[Z]));
@@ -739,7 +775,7 @@ Vector3<Real> Vector3<Real>::Cross(const Vector3<Real>& u, const Vector3<Real>&
 
 template <typename Real>
 Vector3<Real> Vector3<Real>::LinearInterpolation(const Vector3<Real>& u, const Vector3<Real>& v, Real t) {
-    return (a * t) + b * (Real(1) - t);
+    return u * (Real(1) - t) + v * t;
 }
 
 template <typename Real>
@@ -753,11 +789,11 @@ Vector3<Real> Vector3<Real>::Project(const Vector3<Real>& u, const Vector3<Real>
 
 template <typename Real>
 double Vector3<Real>::Angle(const Vector3<Real>& u, const Vector3<Real>& v) {
-    return std::acos((this->data[X] * vector.data[X] + this->data[Y] * vector.data[Y] + this->data[Z] * vector.data[Z]) / (this->norm() * vector.norm()));
+    return std::acos(Vector3<Real>::Dot(u, v) / (u.norm() * v.norm()));
 }
 
 template <typename Real>
-double Vector3<Real>::Dot(const Vector3<Real>& u, const Vector3<Real>& v) {
+constexpr double Vector3<Real>::Dot(const Vector3<Real>& u, const Vector3<Real>& v) {
     return u.x() * v.x() + u.y() * v.y() + u.z() * v.z();
 }
 
@@ -772,8 +808,9 @@ double Vector3<Real>::Norm(const Vector3<Real>& v) {
 }
 
 template <typename Real>
-double Vector3<Real>::NormSquared(const Vector3<Real>& v) {
-    return std::pow(v.data[X], Real(2)) + std::pow(v.data[Y], Real(2)) + std::pow(v.data[Z], Real(2));
+constexpr double Vector3<Real>::NormSquared(const Vector3<Real>& v) {
+    double x = v.data[X], y = v.data[Y], z = v.data[Z];
+    return x * x + y * y + z * z;
 }
 
 template <typename Real>
@@ -782,8 +819,8 @@ double Vector3<Real>::Length(const Vector3<Real>& v) {
 }
 
 template <typename Real>
-double Vector3<Real>::LengthSquared(const Vector3<Real>& v) {
-    return std::pow(v.data[X], Real(2)) + std::pow(v.data[Y], Real(2)) + std::pow(v.data[Z], Real(2));
+constexpr double Vector3<Real>::LengthSquared(const Vector3<Real>& v) {
+    return Vector3<Real>::NormSquared(v);
 }
 
 template <typename Real>
@@ -792,45 +829,101 @@ double Vector3<Real>::Distance(const Vector3<Real>& u, const Vector3<Real>& v) {
 }
 
 template <typename Real>
-double Vector3<Real>::DistanceSquared(const Vector3<Real>& u, const Vector3<Real>& v) {
-    return std::pow(u.data[X] - v.data[X], Real(2)) + std::pow(u.data[Y] - v.data[Y], Real(2)) + std::pow(u.data[Z] - v.data[Z], Real(2));
+constexpr double Vector3<Real>::DistanceSquared(const Vector3<Real>& u, const Vector3<Real>& v) {
+    double x = u.data[X] - v.data[X], y = u.data[Y] - v.data[Y], z = u.data[Z] - v.data[Z];
+    return x * x + y * y + z * z;
+}
+
+template <typename Real>
+Real Vector3<Real>::FastDot(const Vector3<Real>& u, const Vector3<Real>& v) {
+    return u.data[X] * v.data[X] + u.data[Y] * v.data[Y] + u.data[Z] * v.data[Z];
+}
+
+template <typename Real>
+Real Vector3<Real>::FastNorm(const Vector3<Real>& v) {
+    return static_cast<Real>(std::sqrt(Vector3<Real>::FastNormSquared(v)));
+}
+
+template <typename Real>
+Real Vector3<Real>::FastNormSquared(const Vector3<Real>& v) {
+    return v.data[X] * v.data[X] + v.data[Y] * v.data[Y] + v.data[Z] * v.data[Z];
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::Zero() {
+Real Vector3<Real>::FastDistance(const Vector3<Real>& u, const Vector3<Real>& v) {
+    return static_cast<Real>(std::sqrt(Vector3<Real>::FastDistanceSquared(u, v)));
+}
+
+template <typename Real>
+Real Vector3<Real>::FastDistanceSquared(const Vector3<Real>& u, const Vector3<Real>& v) {
+    Real x = u.data[X] - v.data[X], y = u.data[Y] - v.data[Y], z = u.data[Z] - v.data[Z];
+    return x * x + y * y + z * z;
+}
+
+template <typename Real>
+Vector3<Real> Vector3<Real>::FastNormalize(const Vector3<Real>& v) {
+    Real n2 = Vector3<Real>::FastNormSquared(v);
+    if ( n2 <= Real(0) ) return Vector3<Real>();
+
+    Real invLen = Vector3<Real>::InverseSqrt(n2);
+    return Vector3<Real>(v.data[X] * invLen, v.data[Y] * invLen, v.data[Z] * invLen);
+}
+
+template <typename Real>
+Real Vector3<Real>::InverseSqrt(Real x) {
+    return static_cast<Real>(Real(1) / std::sqrt(x));
+}
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+template <>
+inline float Vector3<float>::InverseSqrt(float x) {
+    float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return r * (1.5f - 0.5f * x * r * r);
+}
+#endif
+
+template <typename Real>
+constexpr Vector3<Real> Vector3<Real>::Zero() {
     return Vector3<Real>();
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::UnitX() {
+constexpr Vector3<Real> Vector3<Real>::UnitX() {
     return Vector3<Real>(Real(1), Real(0), Real(0));
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::UnitY() {
+constexpr Vector3<Real> Vector3<Real>::UnitY() {
     return Vector3<Real>(Real(0), Real(1), Real(0));
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::UnitZ() {
+constexpr Vector3<Real> Vector3<Real>::UnitZ() {
     return Vector3<Real>(Real(0), Real(0), Real(1));
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::UnitNX() {
+constexpr Vector3<Real> Vector3<Real>::UnitNX() {
     return Vector3<Real>(Real(-1), Real(0), Real(0));
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::UnitNY() {
+constexpr Vector3<Real> Vector3<Real>::UnitNY() {
     return Vector3<Real>(Real(0), Real(-1), Real(0));
 }
 
 template <typename Real>
-Vector3<Real> Vector3<Real>::UnitNZ() {
+constexpr Vector3<Real> Vector3<Real>::UnitNZ() {
     return Vector3<Real>(Real(0), Real(0), Real(-1));
 }
 
+template <typename Real>
+constexpr void Vector3<Real>::Swap(Real& a, Real& b) {
+    Real t = a;
+    a = b;
+    b = t;
+}
+
 typedef Vector3<long double> Vector3ld;
 typedef Vector3<double> Vector3d;
 typedef Vector3<float> Vector3f;
@@ -846,4 +939,8 @@ typedef Vector3<short> Vec3s;
 
 typedef Vector3<float> Vec3;
 
+/* Compile time checks: these only compile while the functions stay constexpr. */
+static_assert(Vector3<float>::Dot(Vector3<float>(1, 2, 3), Vector3<float>(4, 5, 6)) == 32.0, "[Vector3:Dot] Error: Not folded at compile time.");
+static_assert(Vector3<float>::Cross(Vector3<float>(1, 0, 0), Vector3<float>(0, 1, 0)) == Vector3<float>(0, 0, 1), "[Vector3:Cross] Error: Not folded at compile time.");
+
 #endif
@@ -29,6 +29,7 @@
 #include <iostream>
 #include <cmath>
 #include <type_traits>
+#include <stdexcept>
 #include <iomanip>
 #include "Vector3.h"
 
@@ -41,22 +42,22 @@ class Vector4;
  * See: http://www.parashift.com/c++-faq-lite/template-friends.html
  */
 template <typename Real>
-Vector4<Real> operator + (const Vector4<Real>& u, const Vector4<Real>& v);
+constexpr Vector4<Real> operator + (const Vector4<Real>& u, const Vector4<Real>& v);
 
 template <typename Real>
-Vector4<Real> operator - (const Vector4<Real>& u, const Vector4<Real>& v);
+constexpr Vector4<Real> operator - (const Vector4<Real>& u, const Vector4<Real>& v);
 
 template <typename Real>
-Vector4<Real> operator - (const Vector4<Real>& v);
+constexpr Vector4<Real> operator - (const Vector4<Real>& v);
 
 template <typename Real>
-Vector4<Real> operator * (const Vector4<Real>& v, Real scalar);
+constexpr Vector4<Real> operator * (const Vector4<Real>& v, Real scalar);
 
 template <typename Real>
-Vector4<Real> operator * (Real scalar, const Vector4<Real>& v);
+constexpr Vector4<Real> operator * (Real scalar, const Vector4<Real>& v);
 
 template <typename Real>
-Vector4<Real> operator / (const Vector4<Real>& v, Real scalar);
+constexpr Vector4<Real> operator / (const Vector4<Real>& v, Real scalar);
 
 template <typename Real>
 std::ostream& operator << (std::ostream& out, const Vector4<Real>& vector);
@@ -86,28 +87,27 @@ class Vector4 {
     enum Axis { X, Y, Z, W, COMPONENT_COUNT };
 
 public:
-    Vector4(Real w = Real(0), Real x = Real(0), Real y = Real(0), Real z = Real(0));
-    Vector4(const Vector4<Real>& v);
-    Vector4(const Vector3<Real>& v, Real w = Real(1));
-    Vector4(Real v[4]);
-    ~Vector4();
-
-    void add(const Vector4<Real>& v);
-    void subtract(const Vector4<Real>& v);
-    void multiply(Real scalar);
+    constexpr Vector4(Real w = Real(0), Real x = Real(0), Real y = Real(0), Real z = Real(0));
+    constexpr Vector4(const Vector4<Real>& v);
+    constexpr Vector4(const Vector3<Real>& v, Real w = Real(1));
+    constexpr Vector4(Real v[4]);
+
+    constexpr void add(const Vector4<Real>& v);
+    constexpr void subtract(const Vector4<Real>& v);
+    constexpr void multiply(Real scalar);
     void normalize();
-    void inverse();
+    constexpr void inverse();
 
-    void zero();
-    bool isZero(Real epsilon);
-    bool isEqual(const Vector4<Real>& v);
+    constexpr void zero();
+    constexpr bool isZero(Real epsilon);
+    constexpr bool isEqual(const Vector4<Real>& v);
     bool isEquivalent(const Vector4<Real>& v, Real epsilon) const;
 
     template <typename RealCastType>
     Vector4<RealCastType> cast();
 
     Vector4<Real> normalized() const;
-    double dot(const Vector4<Real>& v) const;
+    constexpr double dot(const Vector4<Real>& v) const;
     
     double magnitude() const;
     double length() const;
@@ -117,76 +117,86 @@ public:
     double distance(const Vector4<Real>& v) const;
     double distanceSquared(const Vector4<Real>& v) const;
 
-    void set(Real w, Real x, Real y, Real z);
-    void set(const Vector4<Real>& v);
-    void setW(Real w);
-    void setX(Real x);
-    void setY(Real y);
-    void setZ(Real z);
-
-    const Real& getW() const;
-    const Real& getX() const;
-    const Real& getY() const;
-    const Real& getZ() const;
-    const Real& w() const;
-    const Real& x() const;
-	const Real& y() const;
-	const Real& z() const;
-	
-    Real& getW();
-    Real& getX();
-    Real& getY();
-    Real& getZ();
-    Real& w();
-	Real& x();
-	Real& y();
-	Real& z();
-
-    const Real* const constData() const;
-    operator const Real* const () const;
-    Real operator () (const Vector4<Real>& v) const;
-    bool operator () (const Vector4<Real>& u, const Vector4<Real>& v) const;
-
-    Real& operator [] (std::size_t index);
-
-    friend Vector4<Real> operator + <> (const Vector4<Real>& u, const Vector4<Real>& v);
-    friend Vector4<Real> operator - <> (const Vector4<Real>& u, const Vector4<Real>& v);
-    friend Vector4<Real> operator - <> (const Vector4<Real>& v);
-    friend Vector4<Real> operator * <> (const Vector4<Real>& v, Real scalar);
-    friend Vector4<Real> operator * <> (Real scalar, const Vector4<Real>& v);
-    friend Vector4<Real> operator / <> (const Vector4<Real>& v, Real scalar);
+    constexpr void set(Real w, Real x, Real y, Real z);
+    constexpr void set(const Vector4<Real>& v);
+    constexpr void setW(Real w);
+    constexpr void setX(Real x);
+    constexpr void setY(Real y);
+    constexpr void setZ(Real z);
+
+    constexpr const Real& getW() const;
+    constexpr const Real& getX() const;
+    constexpr const Real& getY() const;
+    constexpr const Real& getZ() const;
+    constexpr const Real& w() const;
+    constexpr const Real& x() const;
+	constexpr const Real& y() const;
+	constexpr const Real& z() const;
+
+    constexpr Real& getW();
+    constexpr Real& getX();
+    constexpr Real& getY();
+    constexpr Real& getZ();
+    constexpr Real& w();
+	constexpr Real& x();
+	constexpr Real& y();
+	constexpr Real& z();
+
+    constexpr const Real* const constData() const;
+    constexpr operator const Real* const () const;
+    constexpr Real operator () (const Vector4<Real>& v) const;
+    constexpr bool operator () (const Vector4<Real>& u, const Vector4<Real>& v) const;
+
+    constexpr Real& operator [] (std::size_t index);
+
+    friend constexpr Vector4<Real> operator + <> (const Vector4<Real>& u, const Vector4<Real>& v);
+    friend constexpr Vector4<Real> operator - <> (const Vector4<Real>& u, const Vector4<Real>& v);
+    friend constexpr Vector4<Real> operator - <> (const Vector4<Real>& v);
+    friend constexpr Vector4<Real> operator * <> (const Vector4<Real>& v, Real scalar);
+    friend constexpr Vector4<Real> operator * <> (Real scalar, const Vector4<Real>& v);
+    friend constexpr Vector4<Real> operator / <> (const Vector4<Real>& v, Real scalar);
 
     friend std::ostream& operator << <> (std::ostream& out, const Vector4<Real>& v);
     friend std::istream& operator >> <> (std::istream& in, Vector4<Real>& v);
 
-    Vector4<Real> operator - (const Vector4<Real>& v) const;
-	Vector4<Real> operator + (const Vector4<Real>& v) const;
-	Vector4<Real> operator * (const Real& scalar) const;
-	Vector4<Real> operator * (const Vector4<Real>& v) const;
+    constexpr Vector4<Real> operator - (const Vector4<Real>& v) const;
+	constexpr Vector4<Real> operator + (const Vector4<Real>& v) const;
+	constexpr Vector4<Real> operator * (const Real& scalar) const;
+	constexpr Vector4<Real> operator * (const Vector4<Real>& v) const;
+
+    constexpr Vector4<Real>& operator = (const Vector4<Real>& v);
 
-    Vector4<Real>& operator = (const Vector4<Real>& v);
+    constexpr Vector4<Real>& operator += (const Vector4<Real>& v);
+    constexpr Vector4<Real>& operator -= (const Vector4<Real>& v);
+    constexpr Vector4<Real>& operator *= (const Vector4<Real>& v);
+    constexpr Vector4<Real>& operator *= (Real scalar);
 
-    Vector4<Real>& operator += (const Vector4<Real>& v);
-    Vector4<Real>& operator -= (const Vector4<Real>& v);
-    Vector4<Real>& operator *= (const Vector4<Real>& v);
-    Vector4<Real>& operator *= (Real scalar);
+    /* Evaluate an expression built with Lazy() (VectorExpression.h) in one pass, without temporaries. */
+    template <typename E>
+    constexpr Vector4(const VectorExpression<Real, 4, E>& e);
+    template <typename E>
+    constexpr Vector4<Real>& operator = (const VectorExpression<Real, 4, E>& e);
+    template <typename E>
+    constexpr Vector4<Real>& operator += (const VectorExpression<Real, 4, E>& e);
+    template <typename E>
+    constexpr Vector4<Real>& operator -= (const VectorExpression<Real, 4, E>& e);
 
-    bool operator == (const Vector4<Real>& v) const;
-	bool operator != (const Vector4<Real>& v) const;
+    constexpr bool operator == (const Vector4<Real>& v) const;
+	constexpr bool operator != (const Vector4<Real>& v) const;
 
     bool operator < (const Vector4<Real>& v);
     bool operator <= (const Vector4<Real>& v);
     bool operator > (const Vector4<Real>& v);
     bool operator >= (const Vector4<Real>& v);
 
-    static Vector4<Real> Add(const Vector4<Real>& u, const Vector4<Real>& v);
-    static Vector4<Real> Subtract(const Vector4<Real>& u, const Vector4<Real>& v);
-    static Vector4<Real> Multiply(Real scalar, const Vector4<Real>& v);
+    static constexpr Vector4<Real> Add(const Vector4<Real>& u, const Vector4<Real>& v);
+    static constexpr Vector4<Real> Subtract(const Vector4<Real>& u, const Vector4<Real>& v);
+    static constexpr Vector4<Real> Multiply(Real scalar, const Vector4<Real>& v);
     static Vector4<Real> Normalize(const Vector4<Real>& v);
     static Vector4<Real> LinearInterpolation(const Vector4<Real>& u, const Vector4<Real>& v, Real t);
     static Vector4<Real> Project(const Vector4<Real>& u, const Vector4<Real>& v);
 
-    static double Dot(const Vector4<Real>& u, const Vector4<Real>& v);
+    static constexpr double Dot(const Vector4<Real>& u, const Vector4<Real>& v);
     static double Magnitude(const Vector4<Real>& v);
     static double Norm(const Vector4<Real>& v);
     static double NormSquared(const Vector4<Real>& v);
@@ -195,22 +205,22 @@ public:
     static double Distance(const Vector4<Real>& u, const Vector4<Real>& v);
     static double DistanceSquared(const Vector4<Real>& u, const Vector4<Real>& v);
 
-    static Vector4<Real> Zero();
-    static Vector4<Real> UnitW();
-	static Vector4<Real> UnitX();
-	static Vector4<Real> UnitY();
-	static Vector4<Real> UnitZ();
-    static Vector4<Real> UnitNW();
-    static Vector4<Real> UnitNX();
-    static Vector4<Real> UnitNY();
-    static Vector4<Real> UnitNZ();
+    static constexpr Vector4<Real> Zero();
+    static constexpr Vector4<Real> UnitW();
+	static constexpr Vector4<Real> UnitX();
+	static constexpr Vector4<Real> UnitY();
+	static constexpr Vector4<Real> UnitZ();
+    static constexpr Vector4<Real> UnitNW();
+    static constexpr Vector4<Real> UnitNX();
+    static constexpr Vector4<Real> UnitNY();
+    static constexpr Vector4<Real> UnitNZ();
 
 protected:
     Real data[COMPONENT_COUNT];
 };
 
 template <typename Real>
-Vector4<Real>::Vector4(Real w, Real x, Real y, Real z) {
+constexpr Vector4<Real>::Vector4(Real w, Real x, Real y, Real z) : data() {
     this->data[W] = w;
     this->data[X] = x;
     this->data[Y] = y;
@@ -218,7 +228,7 @@ Vector4<Real>::Vector4(Real w, Real x, Real y, Real z) {
 }
 
 template <typename Real>
-Vector4<Real>::Vector4(const Vector4<Real>& v) {
+constexpr Vector4<Real>::Vector4(const Vector4<Real>& v) : data() {
     this->data[W] = v.data[W];
     this->data[X] = v.data[X];
     this->data[Y] = v.data[Y];
@@ -226,7 +236,7 @@ Vector4<Real>::Vector4(const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real>::Vector4(const Vector3<Real>& v, Real w) {
+constexpr Vector4<Real>::Vector4(const Vector3<Real>& v, Real w) : data() {
     this->data[W] = w;
     this->data[X] = v.x();
     this->data[Y] = v.y();
@@ -234,7 +244,7 @@ Vector4<Real>::Vector4(const Vector3<Real>& v, Real w) {
 }
 
 template <typename Real>
-Vector4<Real>::Vector4(Real v[4]) {
+constexpr Vector4<Real>::Vector4(Real v[4]) : data() {
     this->data[W] = v[0];
     this->data[X] = v[1];
     this->data[Y] = v[2];
@@ -242,10 +252,7 @@ Vector4<Real>::Vector4(Real v[4]) {
 }
 
 template <typename Real>
-Vector4<Real>::~Vector4() {}
-
-template <typename Real>
-void Vector4<Real>::add(const Vector4<Real>& v) {
+constexpr void Vector4<Real>::add(const Vector4<Real>& v) {
     this->data[W] += v.data[W];
     this->data[X] += v.data[X];
     this->data[Y] += v.data[Y];
@@ -253,7 +260,7 @@ void Vector4<Real>::add(const Vector4<Real>& v) {
 }
 
 template <typename Real>
-void Vector4<Real>::subtract(const Vector4<Real>& v) {
+constexpr void Vector4<Real>::subtract(const Vector4<Real>& v) {
     this->data[W] -= v.data[W];
     this->data[X] -= v.data[X];
     this->data[Y] -= v.data[Y];
@@ -261,7 +268,7 @@ void Vector4<Real>::subtract(const Vector4<Real>& v) {
 }
 
 template <typename Real>
-void Vector4<Real>::multiply(Real scalar) {
+constexpr void Vector4<Real>::multiply(Real scalar) {
     this->data[W] *= scalar;
     this->data[X] *= scalar;
     this->data[y] *= scalar;
@@ -278,7 +285,7 @@ void Vector4<Real>::normalize() {
 }
 
 template <typename Real>
-void Vector4<Real>::inverse() {
+constexpr void Vector4<Real>::inverse() {
     this->data[W] = -this->data[W];
     this->data[X] = -this->data[X];
     this->data[Y] = -this->data[Y];
@@ -286,7 +293,7 @@ void Vector4<Real>::inverse() {
 }
 
 template <typename Real>
-void Vector4<Real>::zero() {
+constexpr void Vector4<Real>::zero() {
     this->data[W] = Real(0);
     this->data[X] = Real(0);
     this->data[Y] = Real(0);
@@ -294,7 +301,7 @@ void Vector4<Real>::zero() {
 }
 
 template <typename Real>
-bool Vector4<Real>::isZero(Real epsilon) {
+constexpr bool Vector4<Real>::isZero(Real epsilon) {
     if ( (this->data[W] > -epsilon) && 
          (this->data[W] < epsilon ) &&
          (this->data[X] > -epsilon) && 
@@ -308,8 +315,8 @@ bool Vector4<Real>::isZero(Real epsilon) {
 }
 
 template <typename Real>
-bool Vector4<Real>::isEqual(const Vector4<Real>& v) {
-    if ( *this == vector ) return true;
+constexpr bool Vector4<Real>::isEqual(const Vector4<Real>& v) {
+    if ( *this == v ) return true;
     return false;
 }
 
@@ -332,7 +339,7 @@ Vector4<Real> Vector4<Real>::normalized() const {
 }
 
 template <typename Real>
-double Vector4<Real>::dot(const Vector4<Real>& v) const {
+constexpr double Vector4<Real>::dot(const Vector4<Real>& v) const {
     return Vector4<Real>::Dot(*this, v);
 }
 
@@ -372,7 +379,7 @@ double Vector4<Real>::distanceSquared(const Vector4<Real>& v) const {
 }
 
 template <typename Real>
-void Vector4<Real>::set(Real w, Real x, Real y, Real z) {
+constexpr void Vector4<Real>::set(Real w, Real x, Real y, Real z) {
     this->data[W] = w;
     this->data[X] = x;
     this->data[Y] = y;
@@ -380,7 +387,7 @@ void Vector4<Real>::set(Real w, Real x, Real y, Real z) {
 }
 
 template <typename Real>
-void Vector4<Real>::set(const Vector4<Real>& v) {
+constexpr void Vector4<Real>::set(const Vector4<Real>& v) {
     this->data[W] = v.data[W];
     this->data[X] = v.data[X];
     this->data[Y] = v.data[Y];
@@ -388,134 +395,134 @@ void Vector4<Real>::set(const Vector4<Real>& v) {
 }
 
 template <typename Real>
-void Vector4<Real>::setW(Real w) {
+constexpr void Vector4<Real>::setW(Real w) {
     this->data[W] = w;
 }
 
 template <typename Real>
-void Vector4<Real>::setX(Real x) {
+constexpr void Vector4<Real>::setX(Real x) {
     this->data[X] = x;
 }
 
 template <typename Real>
-void Vector4<Real>::setY(Real y) {
+constexpr void Vector4<Real>::setY(Real y) {
     this->data[Y] = y;
 }
 
 template <typename Real>
-void Vector4<Real>::setZ(Real z) {
+constexpr void Vector4<Real>::setZ(Real z) {
     this->data[Z] = z;
 }
 
 template <typename Real>
-const Real& Vector4<Real>::getW() const {
+constexpr const Real& Vector4<Real>::getW() const {
     return this->data[W];
 }
 
 template <typename Real>
-const Real& Vector4<Real>::getX() const {
+constexpr const Real& Vector4<Real>::getX() const {
     return this->data[X];
 }
 
 template <typename Real>
-const Real& Vector4<Real>::getY() const {
+constexpr const Real& Vector4<Real>::getY() const {
     return this->data[Y];
 }
 
 template <typename Real>
-const Real& Vector4<Real>::getZ() const {
+constexpr const Real& Vector4<Real>::getZ() const {
     return this->data[Z];
 }
 
 template <typename Real>
-const Real& Vector4<Real>::w() const {
+constexpr const Real& Vector4<Real>::w() const {
     return this->data[W];
 }
 
 template <typename Real>
-const Real& Vector4<Real>::x() const {
+constexpr const Real& Vector4<Real>::x() const {
     return this->data[X];
 }
 
 template <typename Real>
-const Real& Vector4<Real>::y() const {
+constexpr const Real& Vector4<Real>::y() const {
     return this->data[Y];
 }
 
 template <typename Real>
-const Real& Vector4<Real>::z() const {
+constexpr const Real& Vector4<Real>::z() const {
     return this->data[Z];
 }
 	
 template <typename Real>
-Real& Vector4<Real>::getW() {
+constexpr Real& Vector4<Real>::getW() {
     return this->data[W];
 }
 
 template <typename Real>
-Real& Vector4<Real>::getX() {
+constexpr Real& Vector4<Real>::getX() {
     return this->data[X];
 }
 
 template <typename Real>
-Real& Vector4<Real>::getY() {
+constexpr Real& Vector4<Real>::getY() {
     return this->data[y];
 }
 
 template <typename Real>
-Real& Vector4<Real>::getZ() {
+constexpr Real& Vector4<Real>::getZ() {
     return this->data[Z];
 }
 
 template <typename Real>
-Real& Vector4<Real>::w() {
+constexpr Real& Vector4<Real>::w() {
     return this->data[W];
 }
 
 template <typename Real>
-Real& Vector4<Real>::x() {
+constexpr Real& Vector4<Real>::x() {
     return this->data[X];
 }
 
 template <typename Real>
-Real& Vector4<Real>::y() {
+constexpr Real& Vector4<Real>::y() {
     return this->data[Y];
 }
 
 template <typename Real>
-Real& Vector4<Real>::z() {
+constexpr Real& Vector4<Real>::z() {
     return this->data[Z];
 }
 
 template <typename Real>
-const Real* const Vector4<Real>::constData() const {
+constexpr const Real* const Vector4<Real>::constData() const {
     return this->data;
 }
 
 template <typename Real>
-Vector4<Real>::operator const Real* const () const {
+constexpr Vector4<Real>::operator const Real* const () const {
     return this->data;
 }
 
 template <typename Real>
-Real Vector4<Real>::operator () (const Vector4<Real>& v) const {
+constexpr Real Vector4<Real>::operator () (const Vector4<Real>& v) const {
     return this->data[W] + this->data[X] + this->data[Y] + this->data[Z];
 }
 
 template <typename Real>
-bool Vector4<Real>::operator () (const Vector4<Real>& u, const Vector4<Real>& v) const {
+constexpr bool Vector4<Real>::operator () (const Vector4<Real>& u, const Vector4<Real>& v) const {
     if ( u.data[W] == v.data[W] && u.data[X] == v.data[X] && u.data[Y] == v.data[Y] && u.data[Z] == v.data[Z] ) return true;
     return false;
 }
 
 template <typename Real>
-Real& Vector4<Real>::operator [] (std::size_t index) {
-    if ( index >= COMPONENT_COUNT ) throw std::exception("[Vector4:[]] Error: Index out of bounds.");
+constexpr Real& Vector4<Real>::operator [] (std::size_t index) {
+    if ( index >= COMPONENT_COUNT ) throw std::out_of_range("[Vector4:[]] Error: Index out of bounds.");
     return this->data[index];
 }
 
 template <typename Real>
-Vector4<Real> operator + (const Vector4<Real>& u, const Vector4<Real>& v) {
+constexpr Vector4<Real> operator + (const Vector4<Real>& u, const Vector4<Real>& v) {
     Vector4<Real> result;
     result.data[Vector4<Real>::W] = u.data[Vector4<Real>::W] + v.data[Vector4<Real>::W];
     result.data[Vector4<Real>::X] = u.data[Vector4<Real>::X] + v.data[Vector4<Real>::X];
@@ -525,7 +532,7 @@ Vector4<Real> operator + (const Vector4<Real>& u, const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real> operator - (const Vector4<Real>& u, const Vector4<Real>& v) {
+constexpr Vector4<Real> operator - (const Vector4<Real>& u, const Vector4<Real>& v) {
     Vector4<Real> result;
     result.data[Vector4<Real>::W] = u.data[Vector4<Real>::W] - v.data[Vector4<Real>::W];
     result.data[Vector4<Real>::X] = u.data[Vector4<Real>::X] - v.data[Vector4<Real>::X];
@@ -535,12 +542,12 @@ Vector4<Real> operator - (const Vector4<Real>& u, const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real> operator - (const Vector4<Real>& v) {
+constexpr Vector4<Real> operator - (const Vector4<Real>& v) {
     return Vector4<Real>(-v.data[Vector4<Real>::W], -v.data[Vector4<Real>::X] -v.data[Vector4<Real>::Y], -v.data[Vector4<Real>::Z]);
 }
 
 template <typename Real>
-Vector4<Real> operator * (const Vector4<Real>& v, Real scalar) {
+constexpr Vector4<Real> operator * (const Vector4<Real>& v, Real scalar) {
     Vector4<Real> result;
     result.data[Vector4<Real>::W] = v.data[Vector4<Real>::W] * scalar;
     result.data[Vector4<Real>::X] = v.data[Vector4<Real>::X] * scalar;
@@ -550,7 +557,7 @@ Vector4<Real> operator * (const Vector4<Real>& v, Real scalar) {
 }
 
 template <typename Real>
-Vector4<Real> operator * (Real scalar, const Vector4<Real>& v) {
+constexpr Vector4<Real> operator * (Real scalar, const Vector4<Real>& v) {
     Vector4<Real> result;
     result.data[Vector4<Real>::W] = scalar * v.data[Vector4<Real>::W];
     result.data[Vector4<Real>::X] = scalar * v.data[Vector4<Real>::X];
@@ -560,7 +567,7 @@ Vector4<Real> operator * (Real scalar, const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real> operator / (const Vector4<Real>& v, Real scalar) {
+constexpr Vector4<Real> operator / (const Vector4<Real>& v, Real scalar) {
     Vector4<Real> result;
     result.data[Vector4<Real>::W] = v.data[Vector4<Real>::W] / scalar;
     result.data[Vector4<Real>::X] = v.data[Vector4<Real>::X] / scalar;
@@ -586,7 +593,7 @@ std::istream& operator >> (std::istream& in, Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::operator - (const Vector4<Real>& v) const {
+constexpr Vector4<Real> Vector4<Real>::operator - (const Vector4<Real>& v) const {
     Vector4<Real> result;
     result.data[W] = this->data[W] - v.data[W];
     result.data[X] = this->data[X] - v.data[X];
@@ -596,7 +603,7 @@ Vector4<Real> Vector4<Real>::operator - (const Vector4<Real>& v) const {
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::operator + (const Vector4<Real>& v) const {
+constexpr Vector4<Real> Vector4<Real>::operator + (const Vector4<Real>& v) const {
     Vector4<Real> result;
     result.data[W] = this->data[W] + v.data[W];
     result.data[X] = this->data[X] + v.data[X];
@@ -606,7 +613,7 @@ Vector4<Real> Vector4<Real>::operator + (const Vector4<Real>& v) const {
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::operator * (const Real& scalar) const {
+constexpr Vector4<Real> Vector4<Real>::operator * (const Real& scalar) const {
     Vector4<Real> result;
     result.data[W] = this->data[W] * scalar;
     result.data[X] = this->data[X] * scalar;
@@ -616,7 +623,7 @@ Vector4<Real> Vector4<Real>::operator * (const Real& scalar) const {
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::operator * (const Vector4<Real>& v) const {
+constexpr Vector4<Real> Vector4<Real>::operator * (const Vector4<Real>& v) const {
     Vector4<Real> result;
     result.data[W] = this->data[W] * v.data[W];
     result.data[X] = this->data[X] * v.data[X];
@@ -626,7 +633,7 @@ Vector4<Real> Vector4<Real>::operator * (const Vector4<Real>& v) const {
 }
 
 template <typename Real>
-Vector4<Real>& Vector4<Real>::operator = (const Vector4<Real>& v) {
+constexpr Vector4<Real>& Vector4<Real>::operator = (const Vector4<Real>& v) {
     if ( this == &v ) return *this;
     this->data[W] = v.data[W];
     this->data[X] = v.data[X];
@@ -636,7 +643,7 @@ Vector4<Real>& Vector4<Real>::operator = (const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real>& Vector4<Real>::operator += (const Vector4<Real>& v) {
+constexpr Vector4<Real>& Vector4<Real>::operator += (const Vector4<Real>& v) {
     this->data[W] += v.data[W];
     this->data[X] += v.data[X];
     this->data[Y] += v.data[Y];
@@ -645,7 +652,7 @@ Vector4<Real>& Vector4<Real>::operator += (const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real>& Vector4<Real>::operator -= (const Vector4<Real>& v) {
+constexpr Vector4<Real>& Vector4<Real>::operator -= (const Vector4<Real>& v) {
     this->data[W] -= v.data[W];
     this->data[X] -= v.data[X];
     this->data[Y] -= v.data[Y];
@@ -654,7 +661,7 @@ Vector4<Real>& Vector4<Real>::operator -= (const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real>& Vector4<Real>::operator *= (const Vector4<Real>& v) {
+constexpr Vector4<Real>& Vector4<Real>::operator *= (const Vector4<Real>& v) {
     this->data[W] *= v.data[W];
     this->data[X] *= v.data[X];
     this->data[Y] *= v.data[Y];
@@ -663,7 +670,7 @@ Vector4<Real>& Vector4<Real>::operator *= (const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real>& Vector4<Real>::operator *= (Real scalar) {
+constexpr Vector4<Real>& Vector4<Real>::operator *= (Real scalar) {
     this->data[W] *= scalar;
     this->data[X] *= scalar;
     this->data[Y] *= scalar;
@@ -672,7 +679,7 @@ Vector4<Real>& Vector4<Real>::operator *= (Real scalar) {
 }
 
 template <typename Real>
-bool Vector4<Real>::operator == (const Vector4<Real>& v) const {
+constexpr bool Vector4<Real>::operator == (const Vector4<Real>& v) const {
     if ( this->data[W] == v.data[W] &&
          this->data[X] == v.data[X] && 
          this->data[Y] == v.data[Y] && 
@@ -681,8 +688,8 @@ bool Vector4<Real>::operator == (const Vector4<Real>& v) const {
 }
 
 template <typename Real>
-bool Vector4<Real>::operator != (const Vector4<Real>& v) const {
-    return !(*this == vector);
+constexpr bool Vector4<Real>::operator != (const Vector4<Real>& v) const {
+    return !(*this == v);
 }
 
 template <typename Real>
@@ -710,7 +717,7 @@ bool Vector4<Real>::operator >= (const Vector4<Real>& v) {
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::Add(const Vector4<Real>& u, const Vector4<Real>& v) {
+constexpr Vector4<Real> Vector4<Real>::Add(const Vector4<Real>& u, const Vector4<Real>& v) {
     Vector4<Real> result;
     result.data[W] = u.data[W] + v.data[W];
     result.data[X] = u.data[X] + v.data[X];
@@ -720,7 +727,7 @@ Vector4<Real> Vector4<Real>::Add(const Vector4<Real>& u, const Vector4<Real>& v)
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::Subtract(const Vector4<Real>& u, const Vector4<Real>& v) {
+constexpr Vector4<Real> Vector4<Real>::Subtract(const Vector4<Real>& u, const Vector4<Real>& v) {
     Vector4<Real> result;
     result.data[W] = u.data[W] - v.data[W];
     result.data[X] = u.data[X] - v.data[X];
@@ -730,7 +737,7 @@ Vector4<Real> Vector4<Real>::Subtract(const Vector4<Real>& u, const Vector4<Real
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::Multiply(Real scalar, const Vector4<Real>& v) {
+constexpr Vector4<Real> Vector4<Real>::Multiply(Real scalar, const Vector4<Real>& v) {
     Vector4<Real> result = v;
     result.data[W] *= scalar;
     result.data[X] *= scalar;
@@ -752,7 +759,7 @@ Vector4<Real> Vector4<Real>::Normalize(const Vector4<Real>& v) {
 
 template <typename Real>
 Vector4<Real> Vector4<Real>::LinearInterpolation(const Vector4<Real>& u, const Vector4<Real>& v, Real t) {
-    return (a * t) + b * (Real(1) - t);
+    return u * (Real(1) - t) + v * t;
 }
 
 template <typename Real>
@@ -765,8 +772,8 @@ Vector4<Real> Vector4<Real>::Project(const Vector4<Real>& u, const Vector4<Real>
 }
 
 template <typename Real>
-double Vector4<Real>::Dot(const Vector4<Real>& u, const Vector4<Real>& v) {
-    return u.w() * v.w() + u.x() * v.x() + u.y() * v.y() + u.z() * v.y();
+constexpr double Vector4<Real>::Dot(const Vector4<Real>& u, const Vector4<Real>& v) {
+    return u.w() * v.w() + u.x() * v.x() + u.y() * v.y() + u.z() * v.z();
 }
 
 template <typename Real>
@@ -805,47 +812,47 @@ double Vector4<Real>::DistanceSquared(const Vector4<Real>& u, const Vector4<Real
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::Zero() {
+constexpr Vector4<Real> Vector4<Real>::Zero() {
     return Vector4<Real>();
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::UnitW() {
+constexpr Vector4<Real> Vector4<Real>::UnitW() {
     return Vector4<Real>(Real(1), Real(0), Real(0), Real(0));
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::UnitX() {
+constexpr Vector4<Real> Vector4<Real>::UnitX() {
     return Vector4<Real>(Real(0), Real(1), Real(0), Real(0));
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::UnitY() {
+constexpr Vector4<Real> Vector4<Real>::UnitY() {
     return Vector4<Real>(Real(0), Real(0), Real(1), Real(0));
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::UnitZ() {
+constexpr Vector4<Real> Vector4<Real>::UnitZ() {
     return Vector4<Real>(Real(0), Real(0), Real(0), Real(1));
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::UnitNW() {
+constexpr Vector4<Real> Vector4<Real>::UnitNW() {
     return Vector4<Real>(Real(-1), Real(0), Real(0), Real(0));
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::UnitNX() {
+constexpr Vector4<Real> Vector4<Real>::UnitNX() {
     return Vector4<Real>(Real(0), Real(-1), Real(0), Real(0));
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::UnitNY() {
+constexpr Vector4<Real> Vector4<Real>::UnitNY() {
     return Vector4<Real>(Real(0), Real(0), Real(-1), Real(0));
 }
 
 template <typename Real>
-Vector4<Real> Vector4<Real>::UnitNZ() {
+constexpr Vector4<Real> Vector4<Real>::UnitNZ() {
     return Vector4<Real>(Real(0), Real(0), Real(0), Real(-1));
 }
 
@@ -864,4 +871,7 @@ typedef Vector4<short> Vec4s;
 
 typedef Vector4<float> Vec4;
 
+/* Compile time checks: these only compile while the functions stay constexpr. */
+static_assert(Vector4<float>::Dot(Vector4<float>(1, 2, 3, 4), Vector4<float>(1, 2, 3, 4)) == 30.0, "[Vector4:Dot] Error: Not folded at compile time.");
+
 #endif
@@ -0,0 +1,569 @@
+#ifndef VECTOR_BATCH_H
+#define VECTOR_BATCH_H
+
+#include <cmath>
+#include <cstddef>
+#include "Vector3.h"
+
+/* 
+ * SSE2 is part of x64 and of /arch:SSE2 and -msse2. The AVX kernels are compiled when the compiler
+ * was told it may use AVX (/arch:AVX, -mavx), and on MSVC x64 always, since its AVX intrinsics do
+ * not need /arch:AVX. Whether they run is decided at run time by VectorBatch::HasAVX(), so the same
+ * executable still runs the SSE kernels on processors without AVX.
+ */
+#if defined(__AVX__) || (defined(_MSC_VER) && defined(_M_X64))
+#define VECTOR_BATCH_AVX
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VECTOR_BATCH_SSE
+#endif
+
+#if defined(VECTOR_BATCH_AVX)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(VECTOR_BATCH_SSE)
+#include <emmintrin.h>
+#endif
+
+/*
+ * PaddedVector3f: A float Vector3 padded to 16 bytes, so every vector is a single
+ * SSE register. Use it for arrays that are mostly processed by the batch kernels.
+ * The padding component is carried along by Axpy() and ignored otherwise.
+ */
+struct PaddedVector3f {
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+/*
+ * VectorBatch: Kernels over spans of three dimensional float vectors.
+ *
+ * The spans are given as a pointer to the first x component and the number of
+ * floats from one vector to the next (@stride). Plain Vector3f arrays have a stride
+ * of 3, PaddedVector3f arrays a stride of 4, and vectors inside larger structures,
+ * e.g. the positions of interleaved vertices, the size of the structure in floats.
+ *
+ * Vectors are processed eight (AVX, where HasAVX() allows it) or four (SSE) at a
+ * time in structure of arrays form. Strides of 3 and 4 are loaded with full width loads and shuffled, other
+ * strides are gathered component by component. The rest of a span that does not
+ * fill a register is processed with scalar code, which is also used when neither
+ * instruction set is available.
+ */
+class VectorBatch {
+public:
+    /* True when the AVX kernels are compiled in and the processor and the OS support them. Checked once. */
+    static bool HasAVX();
+
+    /* Normalize @count vectors in place. Zero vectors stay zero. @lengths, if not NULL, receives the length each vector had. */
+    static void Normalize(float* v, std::size_t count, std::size_t stride = 3, float* lengths = NULL);
+
+    /* @result[i] = dot(u[i], v[i]). Both spans share @stride, @result is contiguous. */
+    static void Dot(const float* u, const float* v, float* result, std::size_t count, std::size_t stride = 3);
+
+    /* @result[i] = |u[i] - v[i]|. Both spans share @stride, @result is contiguous. */
+    static void Distance(const float* u, const float* v, float* result, std::size_t count, std::size_t stride = 3);
+
+    /* y[i] += a * x[i]. Both spans share @stride. */
+    static void Axpy(float a, const float* x, float* y, std::size_t count, std::size_t stride = 3);
+
+    /* @result[i] = u[i] x v[i]. All three spans share @stride, @result may not overlap the others. */
+    static void Cross(const float* u, const float* v, float* result, std::size_t count, std::size_t stride = 3);
+
+    static void Normalize(Vector3<float>* v, std::size_t count, float* lengths = NULL);
+    static void Normalize(PaddedVector3f* v, std::size_t count, float* lengths = NULL);
+    static void Dot(const Vector3<float>* u, const Vector3<float>* v, float* result, std::size_t count);
+    static void Dot(const PaddedVector3f* u, const PaddedVector3f* v, float* result, std::size_t count);
+    static void Distance(const Vector3<float>* u, const Vector3<float>* v, float* result, std::size_t count);
+    static void Distance(const PaddedVector3f* u, const PaddedVector3f* v, float* result, std::size_t count);
+    static void Axpy(float a, const Vector3<float>* x, Vector3<float>* y, std::size_t count);
+    static void Axpy(float a, const PaddedVector3f* x, PaddedVector3f* y, std::size_t count);
+    static void Cross(const Vector3<float>* u, const Vector3<float>* v, Vector3<float>* result, std::size_t count);
+    static void Cross(const PaddedVector3f* u, const PaddedVector3f* v, PaddedVector3f* result, std::size_t count);
+
+    /* Scalar versions for other precisions, so generic code can call the kernels for any Real. */
+    template <typename Real>
+    static void Normalize(Vector3<Real>* v, std::size_t count, Real* lengths = NULL);
+    template <typename Real>
+    static void Dot(const Vector3<Real>* u, const Vector3<Real>* v, Real* result, std::size_t count);
+    template <typename Real>
+    static void Distance(const Vector3<Real>* u, const Vector3<Real>* v, Real* result, std::size_t count);
+    template <typename Real>
+    static void Axpy(Real a, const Vector3<Real>* x, Vector3<Real>* y, std::size_t count);
+    template <typename Real>
+    static void Cross(const Vector3<Real>* u, const Vector3<Real>* v, Vector3<Real>* result, std::size_t count);
+
+    /* Copy between the plain and the padded layout. The padding is set to zero. */
+    static void Pad(const Vector3<float>* v, PaddedVector3f* padded, std::size_t count);
+    static void Unpad(const PaddedVector3f* padded, Vector3<float>* v, std::size_t count);
+
+protected:
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+    /* Four vectors starting at @p into one register per component, and back. */
+    static void _Load4(const float* p, std::size_t stride, __m128& x, __m128& y, __m128& z);
+    static void _Store4(float* p, std::size_t stride, __m128 x, __m128 y, __m128 z);
+
+    /* Returns how many vectors were processed, always a multiple of four. */
+    static std::size_t _Normalize4(float* v, std::size_t count, std::size_t stride, float* lengths);
+    static std::size_t _Dot4(const float* u, const float* v, float* result, std::size_t count, std::size_t stride);
+    static std::size_t _Distance4(const float* u, const float* v, float* result, std::size_t count, std::size_t stride);
+    static std::size_t _Cross4(const float* u, const float* v, float* result, std::size_t count, std::size_t stride);
+#endif
+
+#if defined(VECTOR_BATCH_AVX)
+    static bool _DetectAVX();
+
+    static void _Load8(const float* p, std::size_t stride, __m256& x, __m256& y, __m256& z);
+    static void _Store8(float* p, std::size_t stride, __m256 x, __m256 y, __m256 z);
+
+    /* Returns how many vectors were processed, always a multiple of eight. */
+    static std::size_t _Normalize8(float* v, std::size_t count, std::size_t stride, float* lengths);
+    static std::size_t _Dot8(const float* u, const float* v, float* result, std::size_t count, std::size_t stride);
+    static std::size_t _Distance8(const float* u, const float* v, float* result, std::size_t count, std::size_t stride);
+    static std::size_t _Cross8(const float* u, const float* v, float* result, std::size_t count, std::size_t stride);
+#endif
+};
+
+static_assert(sizeof(Vector3<float>) == 3 * sizeof(float), "[VectorBatch] Error: Vector3<float> must consist of exactly three floats.");
+static_assert(sizeof(PaddedVector3f) == 4 * sizeof(float), "[VectorBatch] Error: PaddedVector3f must consist of exactly four floats.");
+
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+inline void VectorBatch::_Load4(const float* p, std::size_t stride, __m128& x, __m128& y, __m128& z) {
+    if ( stride == 3 ) {
+        /* a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3) */
+        __m128 a = _mm_loadu_ps(p);
+        __m128 b = _mm_loadu_ps(p + 4);
+        __m128 c = _mm_loadu_ps(p + 8);
+        __m128 bc = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 2, 2));
+        x = _mm_shuffle_ps(a, bc, _MM_SHUFFLE(3, 0, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+    else if ( stride == 4 ) {
+        __m128 r0 = _mm_loadu_ps(p);
+        __m128 r1 = _mm_loadu_ps(p + 4);
+        __m128 r2 = _mm_loadu_ps(p + 8);
+        __m128 r3 = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        x = r0;
+        y = r1;
+        z = r2;
+    }
+    else {
+        x = _mm_set_ps(p[3 * stride], p[2 * stride], p[stride], p[0]);
+        y = _mm_set_ps(p[3 * stride + 1], p[2 * stride + 1], p[stride + 1], p[1]);
+        z = _mm_set_ps(p[3 * stride + 2], p[2 * stride + 2], p[stride + 2], p[2]);
+    }
+}
+
+inline void VectorBatch::_Store4(float* p, std::size_t stride, __m128 x, __m128 y, __m128 z) {
+    if ( stride == 3 ) {
+        __m128 xy = _mm_unpacklo_ps(x, y);
+        __m128 a = _mm_shuffle_ps(xy, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+        __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        _mm_storeu_ps(p, a);
+        _mm_storeu_ps(p + 4, b);
+        _mm_storeu_ps(p + 8, c);
+        return;
+    }
+
+    /* Other layouts may hold data between the vectors, so only the components are written. */
+    float xs[4], ys[4], zs[4];
+    _mm_storeu_ps(xs, x);
+    _mm_storeu_ps(ys, y);
+    _mm_storeu_ps(zs, z);
+    for ( std::size_t i = 0; i < 4; i++ ) {
+        p[i * stride] = xs[i];
+        p[i * stride + 1] = ys[i];
+        p[i * stride + 2] = zs[i];
+    }
+}
+
+inline std::size_t VectorBatch::_Normalize4(float* v, std::size_t count, std::size_t stride, float* lengths) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 three_halves = _mm_set1_ps(1.5f);
+    const __m128 zero = _mm_setzero_ps();
+
+    std::size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128 x, y, z;
+        _Load4(v + i * stride, stride, x, y, z);
+
+        /* rsqrt is accurate to 12 bits, one Newton-Raphson step brings it close to full float precision. */
+        __m128 n2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        __m128 r = _mm_rsqrt_ps(n2);
+        r = _mm_mul_ps(r, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, n2), _mm_mul_ps(r, r))));
+        r = _mm_and_ps(r, _mm_cmpgt_ps(n2, zero));
+
+        _Store4(v + i * stride, stride, _mm_mul_ps(x, r), _mm_mul_ps(y, r), _mm_mul_ps(z, r));
+        if ( lengths != NULL )
+            _mm_storeu_ps(lengths + i, _mm_mul_ps(n2, r));
+    }
+
+    return i;
+}
+
+inline std::size_t VectorBatch::_Dot4(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128 ux, uy, uz, vx, vy, vz;
+        _Load4(u + i * stride, stride, ux, uy, uz);
+        _Load4(v + i * stride, stride, vx, vy, vz);
+        _mm_storeu_ps(result + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ux, vx), _mm_mul_ps(uy, vy)), _mm_mul_ps(uz, vz)));
+    }
+
+    return i;
+}
+
+inline std::size_t VectorBatch::_Distance4(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128 ux, uy, uz, vx, vy, vz;
+        _Load4(u + i * stride, stride, ux, uy, uz);
+        _Load4(v + i * stride, stride, vx, vy, vz);
+        __m128 dx = _mm_sub_ps(ux, vx);
+        __m128 dy = _mm_sub_ps(uy, vy);
+        __m128 dz = _mm_sub_ps(uz, vz);
+        _mm_storeu_ps(result + i, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz))));
+    }
+
+    return i;
+}
+
+inline std::size_t VectorBatch::_Cross4(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128 ux, uy, uz, vx, vy, vz;
+        _Load4(u + i * stride, stride, ux, uy, uz);
+        _Load4(v + i * stride, stride, vx, vy, vz);
+        _Store4(result + i * stride, stride,
+                _mm_sub_ps(_mm_mul_ps(uy, vz), _mm_mul_ps(uz, vy)),
+                _mm_sub_ps(_mm_mul_ps(uz, vx), _mm_mul_ps(ux, vz)),
+                _mm_sub_ps(_mm_mul_ps(ux, vy), _mm_mul_ps(uy, vx)));
+    }
+
+    return i;
+}
+#endif
+
+#if defined(VECTOR_BATCH_AVX)
+/* The CPU has AVX and the OS saves the ymm registers on context switches (OSXSAVE and XCR0 bits 1 and 2). */
+inline bool VectorBatch::_DetectAVX() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    unsigned int ecx = static_cast<unsigned int>(info[2]);
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if ( !__get_cpuid(1, &eax, &ebx, &ecx, &edx) ) return false;
+#endif
+    if ( (ecx & (1u << 27)) == 0 || (ecx & (1u << 28)) == 0 ) return false;
+
+#if defined(_MSC_VER)
+    unsigned long long xcr0 = _xgetbv(0);
+#else
+    unsigned int xcr0_low, xcr0_high;
+    __asm__ ("xgetbv" : "=a" (xcr0_low), "=d" (xcr0_high) : "c" (0));
+    unsigned long long xcr0 = xcr0_low;
+#endif
+    return (xcr0 & 0x6) == 0x6;
+}
+
+/* The 8 wide kernels end with vzeroupper, so SSE code compiled without VEX encoding runs at full speed after them. */
+inline void VectorBatch::_Load8(const float* p, std::size_t stride, __m256& x, __m256& y, __m256& z) {
+    __m128 x0, y0, z0, x1, y1, z1;
+    _Load4(p, stride, x0, y0, z0);
+    _Load4(p + 4 * stride, stride, x1, y1, z1);
+    x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+    y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+    z = _mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1);
+}
+
+inline void VectorBatch::_Store8(float* p, std::size_t stride, __m256 x, __m256 y, __m256 z) {
+    _Store4(p, stride, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+    _Store4(p + 4 * stride, stride, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+}
+
+inline std::size_t VectorBatch::_Normalize8(float* v, std::size_t count, std::size_t stride, float* lengths) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 three_halves = _mm256_set1_ps(1.5f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    std::size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 ) {
+        __m256 x, y, z;
+        _Load8(v + i * stride, stride, x, y, z);
+
+        __m256 n2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+        __m256 r = _mm256_rsqrt_ps(n2);
+        r = _mm256_mul_ps(r, _mm256_sub_ps(three_halves, _mm256_mul_ps(_mm256_mul_ps(half, n2), _mm256_mul_ps(r, r))));
+        r = _mm256_and_ps(r, _mm256_cmp_ps(n2, zero, _CMP_GT_OQ));
+
+        _Store8(v + i * stride, stride, _mm256_mul_ps(x, r), _mm256_mul_ps(y, r), _mm256_mul_ps(z, r));
+        if ( lengths != NULL )
+            _mm256_storeu_ps(lengths + i, _mm256_mul_ps(n2, r));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+inline std::size_t VectorBatch::_Dot8(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 ) {
+        __m256 ux, uy, uz, vx, vy, vz;
+        _Load8(u + i * stride, stride, ux, uy, uz);
+        _Load8(v + i * stride, stride, vx, vy, vz);
+        _mm256_storeu_ps(result + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ux, vx), _mm256_mul_ps(uy, vy)), _mm256_mul_ps(uz, vz)));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+inline std::size_t VectorBatch::_Distance8(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 ) {
+        __m256 ux, uy, uz, vx, vy, vz;
+        _Load8(u + i * stride, stride, ux, uy, uz);
+        _Load8(v + i * stride, stride, vx, vy, vz);
+        __m256 dx = _mm256_sub_ps(ux, vx);
+        __m256 dy = _mm256_sub_ps(uy, vy);
+        __m256 dz = _mm256_sub_ps(uz, vz);
+        _mm256_storeu_ps(result + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz))));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+inline std::size_t VectorBatch::_Cross8(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 ) {
+        __m256 ux, uy, uz, vx, vy, vz;
+        _Load8(u + i * stride, stride, ux, uy, uz);
+        _Load8(v + i * stride, stride, vx, vy, vz);
+        _Store8(result + i * stride, stride,
+                _mm256_sub_ps(_mm256_mul_ps(uy, vz), _mm256_mul_ps(uz, vy)),
+                _mm256_sub_ps(_mm256_mul_ps(uz, vx), _mm256_mul_ps(ux, vz)),
+                _mm256_sub_ps(_mm256_mul_ps(ux, vy), _mm256_mul_ps(uy, vx)));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+#endif
+
+inline bool VectorBatch::HasAVX() {
+#if defined(__AVX__)
+    return true;
+#elif defined(VECTOR_BATCH_AVX)
+    static const bool available = VectorBatch::_DetectAVX();
+    return available;
+#else
+    return false;
+#endif
+}
+
+inline void VectorBatch::Normalize(float* v, std::size_t count, std::size_t stride, float* lengths) {
+    std::size_t i = 0;
+#if defined(VECTOR_BATCH_AVX)
+    if ( VectorBatch::HasAVX() ) i += _Normalize8(v, count, stride, lengths);
+#endif
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+    i += _Normalize4(v + i * stride, count - i, stride, lengths != NULL ? lengths + i : NULL);
+#endif
+
+    for ( ; i < count; i++ ) {
+        float* p = v + i * stride;
+        float n = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        float r = (n > 0.0f) ? 1.0f / n : 0.0f;
+        p[0] *= r;
+        p[1] *= r;
+        p[2] *= r;
+        if ( lengths != NULL ) lengths[i] = n;
+    }
+}
+
+inline void VectorBatch::Dot(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+#if defined(VECTOR_BATCH_AVX)
+    if ( VectorBatch::HasAVX() ) i += _Dot8(u, v, result, count, stride);
+#endif
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+    i += _Dot4(u + i * stride, v + i * stride, result + i, count - i, stride);
+#endif
+
+    for ( ; i < count; i++ ) {
+        const float* a = u + i * stride;
+        const float* b = v + i * stride;
+        result[i] = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+}
+
+inline void VectorBatch::Distance(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+#if defined(VECTOR_BATCH_AVX)
+    if ( VectorBatch::HasAVX() ) i += _Distance8(u, v, result, count, stride);
+#endif
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+    i += _Distance4(u + i * stride, v + i * stride, result + i, count - i, stride);
+#endif
+
+    for ( ; i < count; i++ ) {
+        const float* a = u + i * stride;
+        const float* b = v + i * stride;
+        float dx = a[0] - b[0];
+        float dy = a[1] - b[1];
+        float dz = a[2] - b[2];
+        result[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+inline void VectorBatch::Axpy(float a, const float* x, float* y, std::size_t count, std::size_t stride) {
+    /* Packed layouts are one flat float array, no shuffling is needed. */
+    if ( stride == 3 || stride == 4 ) {
+        std::size_t n = count * stride;
+        std::size_t i = 0;
+#if defined(VECTOR_BATCH_AVX)
+        if ( VectorBatch::HasAVX() ) {
+            __m256 a8 = _mm256_set1_ps(a);
+            for ( ; i + 8 <= n; i += 8 )
+                _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(a8, _mm256_loadu_ps(x + i))));
+            _mm256_zeroupper();
+        }
+#endif
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+        __m128 a4 = _mm_set1_ps(a);
+        for ( ; i + 4 <= n; i += 4 )
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(a4, _mm_loadu_ps(x + i))));
+#endif
+        for ( ; i < n; i++ )
+            y[i] += a * x[i];
+        return;
+    }
+
+    for ( std::size_t i = 0; i < count; i++ ) {
+        const float* p = x + i * stride;
+        float* q = y + i * stride;
+        q[0] += a * p[0];
+        q[1] += a * p[1];
+        q[2] += a * p[2];
+    }
+}
+
+inline void VectorBatch::Cross(const float* u, const float* v, float* result, std::size_t count, std::size_t stride) {
+    std::size_t i = 0;
+#if defined(VECTOR_BATCH_AVX)
+    if ( VectorBatch::HasAVX() ) i += _Cross8(u, v, result, count, stride);
+#endif
+#if defined(VECTOR_BATCH_SSE) || defined(VECTOR_BATCH_AVX)
+    i += _Cross4(u + i * stride, v + i * stride, result + i * stride, count - i, stride);
+#endif
+
+    for ( ; i < count; i++ ) {
+        const float* a = u + i * stride;
+        const float* b = v + i * stride;
+        float* c = result + i * stride;
+        c[0] = a[1] * b[2] - a[2] * b[1];
+        c[1] = a[2] * b[0] - a[0] * b[2];
+        c[2] = a[0] * b[1] - a[1] * b[0];
+    }
+}
+
+inline void VectorBatch::Normalize(Vector3<float>* v, std::size_t count, float* lengths) {
+    if ( count > 0 ) VectorBatch::Normalize(&v[0][0], count, 3, lengths);
+}
+
+inline void VectorBatch::Normalize(PaddedVector3f* v, std::size_t count, float* lengths) {
+    if ( count > 0 ) VectorBatch::Normalize(&v[0].x, count, 4, lengths);
+}
+
+inline void VectorBatch::Dot(const Vector3<float>* u, const Vector3<float>* v, float* result, std::size_t count) {
+    if ( count > 0 ) VectorBatch::Dot(u[0].constData(), v[0].constData(), result, count, 3);
+}
+
+inline void VectorBatch::Dot(const PaddedVector3f* u, const PaddedVector3f* v, float* result, std::size_t count) {
+    if ( count > 0 ) VectorBatch::Dot(&u[0].x, &v[0].x, result, count, 4);
+}
+
+inline void VectorBatch::Distance(const Vector3<float>* u, const Vector3<float>* v, float* result, std::size_t count) {
+    if ( count > 0 ) VectorBatch::Distance(u[0].constData(), v[0].constData(), result, count, 3);
+}
+
+inline void VectorBatch::Distance(const PaddedVector3f* u, const PaddedVector3f* v, float* result, std::size_t count) {
+    if ( count > 0 ) VectorBatch::Distance(&u[0].x, &v[0].x, result, count, 4);
+}
+
+inline void VectorBatch::Axpy(float a, const Vector3<float>* x, Vector3<float>* y, std::size_t count) {
+    if ( count > 0 ) VectorBatch::Axpy(a, x[0].constData(), &y[0][0], count, 3);
+}
+
+inline void VectorBatch::Axpy(float a, const PaddedVector3f* x, PaddedVector3f* y, std::size_t count) {
+    if ( count > 0 ) VectorBatch::Axpy(a, &x[0].x, &y[0].x, count, 4);
+}
+
+inline void VectorBatch::Cross(const Vector3<float>* u, const Vector3<float>* v, Vector3<float>* result, std::size_t count) {
+    if ( count > 0 ) VectorBatch::Cross(u[0].constData(), v[0].constData(), &result[0][0], count, 3);
+}
+
+inline void VectorBatch::Cross(const PaddedVector3f* u, const PaddedVector3f* v, PaddedVector3f* result, std::size_t count) {
+    if ( count > 0 ) VectorBatch::Cross(&u[0].x, &v[0].x, &result[0].x, count, 4);
+}
+
+template <typename Real>
+void VectorBatch::Normalize(Vector3<Real>* v, std::size_t count, Real* lengths) {
+    for ( std::size_t i = 0; i < count; i++ ) {
+        Real n = Vector3<Real>::FastNorm(v[i]);
+        v[i] = Vector3<Real>::FastNormalize(v[i]);
+        if ( lengths != NULL ) lengths[i] = n;
+    }
+}
+
+template <typename Real>
+void VectorBatch::Dot(const Vector3<Real>* u, const Vector3<Real>* v, Real* result, std::size_t count) {
+    for ( std::size_t i = 0; i < count; i++ )
+        result[i] = Vector3<Real>::FastDot(u[i], v[i]);
+}
+
+template <typename Real>
+void VectorBatch::Distance(const Vector3<Real>* u, const Vector3<Real>* v, Real* result, std::size_t count) {
+    for ( std::size_t i = 0; i < count; i++ )
+        result[i] = Vector3<Real>::FastDistance(u[i], v[i]);
+}
+
+template <typename Real>
+void VectorBatch::Axpy(Real a, const Vector3<Real>* x, Vector3<Real>* y, std::size_t count) {
+    for ( std::size_t i = 0; i < count; i++ )
+        y[i] += x[i] * a;
+}
+
+template <typename Real>
+void VectorBatch::Cross(const Vector3<Real>* u, const Vector3<Real>* v, Vector3<Real>* result, std::size_t count) {
+    for ( std::size_t i = 0; i < count; i++ )
+        result[i] = Vector3<Real>::Cross(u[i], v[i]);
+}
+
+inline void VectorBatch::Pad(const Vector3<float>* v, PaddedVector3f* padded, std::size_t count) {
+    for ( std::size_t i = 0; i < count; i++ ) {
+        const float* p = v[i].constData();
+        padded[i].x = p[0];
+        padded[i].y = p[1];
+        padded[i].z = p[2];
+        padded[i].w = 0.0f;
+    }
+}
+
+inline void VectorBatch::Unpad(const PaddedVector3f* padded, Vector3<float>* v, std::size_t count) {
+    for ( std::size_t i = 0; i < count; i++ )
+        v[i].set(padded[i].x, padded[i].y, padded[i].z);
+}
+
+#endif
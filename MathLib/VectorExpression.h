@@ -0,0 +1,311 @@
+#ifndef VECTOR_EXPRESSION_H
+#define VECTOR_EXPRESSION_H
+
+#include <cstddef>
+#include <type_traits>
+#include "Vector3.h"
+#include "Vector4.h"
+
+/*
+ * VectorExpression: Opt-in expression templates for Vector3 and Vector4.
+ *
+ * The overloaded operators of Vector3 and Vector4 return a new vector for every
+ * operation, so k * (dc - dr) * u - v builds a temporary per operator. Wrapping
+ * an operand with Lazy() switches the expression to the operators below: they
+ * only record the operation, and the whole expression is evaluated component by
+ * component when it is assigned to a vector, without any temporary vector.
+ *
+ *     Vector3f a = (Lazy(force) / mass) * dt;
+ *     velocity += Lazy(force) / mass * dt;
+ *     position += Lazy(velocity) * dt - Lazy(correction);
+ *
+ * Once one operand is wrapped, plain vectors can be mixed in. Code that does not
+ * include this header, or does not call Lazy(), is unaffected.
+ *
+ * Every operation is componentwise, so a vector may appear on both sides of an
+ * assignment. An expression keeps references to its vectors and must not outlive
+ * the full expression it is written in; do not store one in an auto variable.
+ */
+template <typename Real, std::size_t N, typename Derived>
+class VectorExpression {
+public:
+    constexpr Real operator [] (std::size_t index) const { return static_cast<const Derived&>(*this).at(index); }
+};
+
+/* A vector leaf of an expression. */
+template <typename Real, std::size_t N>
+class VectorOperand : public VectorExpression< Real, N, VectorOperand<Real, N> > {
+public:
+    explicit constexpr VectorOperand(const Real* data) : data(data) {}
+    constexpr Real at(std::size_t index) const { return this->data[index]; }
+
+protected:
+    const Real* data;
+};
+
+template <typename Real, std::size_t N, typename L, typename R>
+class VectorSum : public VectorExpression< Real, N, VectorSum<Real, N, L, R> > {
+public:
+    constexpr VectorSum(const L& u, const R& v) : u(u), v(v) {}
+    constexpr Real at(std::size_t index) const { return this->u.at(index) + this->v.at(index); }
+
+protected:
+    L u;
+    R v;
+};
+
+template <typename Real, std::size_t N, typename L, typename R>
+class VectorDifference : public VectorExpression< Real, N, VectorDifference<Real, N, L, R> > {
+public:
+    constexpr VectorDifference(const L& u, const R& v) : u(u), v(v) {}
+    constexpr Real at(std::size_t index) const { return this->u.at(index) - this->v.at(index); }
+
+protected:
+    L u;
+    R v;
+};
+
+/* Componentwise product, the same as Vector3::operator * (const Vector3&). */
+template <typename Real, std::size_t N, typename L, typename R>
+class VectorProduct : public VectorExpression< Real, N, VectorProduct<Real, N, L, R> > {
+public:
+    constexpr VectorProduct(const L& u, const R& v) : u(u), v(v) {}
+    constexpr Real at(std::size_t index) const { return this->u.at(index) * this->v.at(index); }
+
+protected:
+    L u;
+    R v;
+};
+
+template <typename Real, std::size_t N, typename E>
+class VectorScale : public VectorExpression< Real, N, VectorScale<Real, N, E> > {
+public:
+    constexpr VectorScale(const E& v, Real scalar) : v(v), scalar(scalar) {}
+    constexpr Real at(std::size_t index) const { return this->v.at(index) * this->scalar; }
+
+protected:
+    E v;
+    Real scalar;
+};
+
+/* Divides every component, so the result matches Vector3::operator / exactly. */
+template <typename Real, std::size_t N, typename E>
+class VectorQuotient : public VectorExpression< Real, N, VectorQuotient<Real, N, E> > {
+public:
+    constexpr VectorQuotient(const E& v, Real scalar) : v(v), scalar(scalar) {}
+    constexpr Real at(std::size_t index) const { return this->v.at(index) / this->scalar; }
+
+protected:
+    E v;
+    Real scalar;
+};
+
+template <typename Real, std::size_t N, typename E>
+class VectorNegation : public VectorExpression< Real, N, VectorNegation<Real, N, E> > {
+public:
+    explicit constexpr VectorNegation(const E& v) : v(v) {}
+    constexpr Real at(std::size_t index) const { return -this->v.at(index); }
+
+protected:
+    E v;
+};
+
+/* The vector types that can take part in an expression without being wrapped. */
+template <typename V>
+struct VectorOperandTraits { static const bool IS_VECTOR = false; };
+
+template <typename Real>
+struct VectorOperandTraits< Vector3<Real> > {
+    static const bool IS_VECTOR = true;
+    static const std::size_t SIZE = 3;
+};
+
+template <typename Real>
+struct VectorOperandTraits< Vector4<Real> > {
+    static const bool IS_VECTOR = true;
+    static const std::size_t SIZE = 4;
+};
+
+/* Keeps a scalar parameter out of template argument deduction, so dt * Lazy(v) works for a double dt and float v. */
+template <typename T>
+struct NonDeduced { typedef T Type; };
+
+template <typename Real>
+constexpr VectorOperand<Real, 3> Lazy(const Vector3<Real>& v) {
+    return VectorOperand<Real, 3>(v.constData());
+}
+
+template <typename Real>
+constexpr VectorOperand<Real, 4> Lazy(const Vector4<Real>& v) {
+    return VectorOperand<Real, 4>(v.constData());
+}
+
+template <typename Real, std::size_t N, typename L, typename R>
+constexpr VectorSum<Real, N, L, R> operator + (const VectorExpression<Real, N, L>& u, const VectorExpression<Real, N, R>& v) {
+    return VectorSum<Real, N, L, R>(static_cast<const L&>(u), static_cast<const R&>(v));
+}
+
+template <typename Real, std::size_t N, typename L, typename V>
+constexpr typename std::enable_if< VectorOperandTraits<V>::IS_VECTOR, VectorSum< Real, N, L, VectorOperand<Real, N> > >::type
+operator + (const VectorExpression<Real, N, L>& u, const V& v) {
+    static_assert(VectorOperandTraits<V>::SIZE == N, "[VectorExpression:operator +] Error: Vector sizes do not match.");
+    return VectorSum< Real, N, L, VectorOperand<Real, N> >(static_cast<const L&>(u), VectorOperand<Real, N>(v.constData()));
+}
+
+template <typename Real, std::size_t N, typename V, typename R>
+constexpr typename std::enable_if< VectorOperandTraits<V>::IS_VECTOR, VectorSum< Real, N, VectorOperand<Real, N>, R > >::type
+operator + (const V& u, const VectorExpression<Real, N, R>& v) {
+    static_assert(VectorOperandTraits<V>::SIZE == N, "[VectorExpression:operator +] Error: Vector sizes do not match.");
+    return VectorSum< Real, N, VectorOperand<Real, N>, R >(VectorOperand<Real, N>(u.constData()), static_cast<const R&>(v));
+}
+
+template <typename Real, std::size_t N, typename L, typename R>
+constexpr VectorDifference<Real, N, L, R> operator - (const VectorExpression<Real, N, L>& u, const VectorExpression<Real, N, R>& v) {
+    return VectorDifference<Real, N, L, R>(static_cast<const L&>(u), static_cast<const R&>(v));
+}
+
+template <typename Real, std::size_t N, typename L, typename V>
+constexpr typename std::enable_if< VectorOperandTraits<V>::IS_VECTOR, VectorDifference< Real, N, L, VectorOperand<Real, N> > >::type
+operator - (const VectorExpression<Real, N, L>& u, const V& v) {
+    static_assert(VectorOperandTraits<V>::SIZE == N, "[VectorExpression:operator -] Error: Vector sizes do not match.");
+    return VectorDifference< Real, N, L, VectorOperand<Real, N> >(static_cast<const L&>(u), VectorOperand<Real, N>(v.constData()));
+}
+
+template <typename Real, std::size_t N, typename V, typename R>
+constexpr typename std::enable_if< VectorOperandTraits<V>::IS_VECTOR, VectorDifference< Real, N, VectorOperand<Real, N>, R > >::type
+operator - (const V& u, const VectorExpression<Real, N, R>& v) {
+    static_assert(VectorOperandTraits<V>::SIZE == N, "[VectorExpression:operator -] Error: Vector sizes do not match.");
+    return VectorDifference< Real, N, VectorOperand<Real, N>, R >(VectorOperand<Real, N>(u.constData()), static_cast<const R&>(v));
+}
+
+template <typename Real, std::size_t N, typename L, typename R>
+constexpr VectorProduct<Real, N, L, R> operator * (const VectorExpression<Real, N, L>& u, const VectorExpression<Real, N, R>& v) {
+    return VectorProduct<Real, N, L, R>(static_cast<const L&>(u), static_cast<const R&>(v));
+}
+
+template <typename Real, std::size_t N, typename L, typename V>
+constexpr typename std::enable_if< VectorOperandTraits<V>::IS_VECTOR, VectorProduct< Real, N, L, VectorOperand<Real, N> > >::type
+operator * (const VectorExpression<Real, N, L>& u, const V& v) {
+    static_assert(VectorOperandTraits<V>::SIZE == N, "[VectorExpression:operator *] Error: Vector sizes do not match.");
+    return VectorProduct< Real, N, L, VectorOperand<Real, N> >(static_cast<const L&>(u), VectorOperand<Real, N>(v.constData()));
+}
+
+template <typename Real, std::size_t N, typename V, typename R>
+constexpr typename std::enable_if< VectorOperandTraits<V>::IS_VECTOR, VectorProduct< Real, N, VectorOperand<Real, N>, R > >::type
+operator * (const V& u, const VectorExpression<Real, N, R>& v) {
+    static_assert(VectorOperandTraits<V>::SIZE == N, "[VectorExpression:operator *] Error: Vector sizes do not match.");
+    return VectorProduct< Real, N, VectorOperand<Real, N>, R >(VectorOperand<Real, N>(u.constData()), static_cast<const R&>(v));
+}
+
+template <typename Real, std::size_t N, typename E>
+constexpr VectorScale<Real, N, E> operator * (const VectorExpression<Real, N, E>& v, typename NonDeduced<Real>::Type scalar) {
+    return VectorScale<Real, N, E>(static_cast<const E&>(v), scalar);
+}
+
+template <typename Real, std::size_t N, typename E>
+constexpr VectorScale<Real, N, E> operator * (typename NonDeduced<Real>::Type scalar, const VectorExpression<Real, N, E>& v) {
+    return VectorScale<Real, N, E>(static_cast<const E&>(v), scalar);
+}
+
+template <typename Real, std::size_t N, typename E>
+constexpr VectorQuotient<Real, N, E> operator / (const VectorExpression<Real, N, E>& v, typename NonDeduced<Real>::Type scalar) {
+    return VectorQuotient<Real, N, E>(static_cast<const E&>(v), scalar);
+}
+
+template <typename Real, std::size_t N, typename E>
+constexpr VectorNegation<Real, N, E> operator - (const VectorExpression<Real, N, E>& v) {
+    return VectorNegation<Real, N, E>(static_cast<const E&>(v));
+}
+
+/* Reductions evaluate the expression once per component and return Real, like the Fast*() functions of Vector3. */
+template <typename Real, std::size_t N, typename L, typename R>
+constexpr Real Dot(const VectorExpression<Real, N, L>& u, const VectorExpression<Real, N, R>& v) {
+    Real result = Real(0);
+    for (std::size_t i = 0; i < N; i++)
+        result += u[i] * v[i];
+    return result;
+}
+
+template <typename Real, std::size_t N, typename E>
+constexpr Real NormSquared(const VectorExpression<Real, N, E>& v) {
+    Real result = Real(0);
+    for (std::size_t i = 0; i < N; i++) {
+        Real component = v[i];
+        result += component * component;
+    }
+    return result;
+}
+
+template <typename Real, std::size_t N, typename E>
+inline Real Norm(const VectorExpression<Real, N, E>& v) {
+    return static_cast<Real>(std::sqrt(NormSquared(v)));
+}
+
+/* Evaluation, declared in Vector3 and Vector4. Each is a single loop over the components. */
+template <typename Real>
+template <typename E>
+constexpr Vector3<Real>::Vector3(const VectorExpression<Real, 3, E>& e) : data() {
+    for (std::size_t i = 0; i < COMPONENT_COUNT; i++)
+        this->data[i] = e[i];
+}
+
+template <typename Real>
+template <typename E>
+constexpr Vector3<Real>& Vector3<Real>::operator = (const VectorExpression<Real, 3, E>& e) {
+    for (std::size_t i = 0; i < COMPONENT_COUNT; i++)
+        this->data[i] = e[i];
+    return *this;
+}
+
+template <typename Real>
+template <typename E>
+constexpr Vector3<Real>& Vector3<Real>::operator += (const VectorExpression<Real, 3, E>& e) {
+    for (std::size_t i = 0; i < COMPONENT_COUNT; i++)
+        this->data[i] += e[i];
+    return *this;
+}
+
+template <typename Real>
+template <typename E>
+constexpr Vector3<Real>& Vector3<Real>::operator -= (const VectorExpression<Real, 3, E>& e) {
+    for (std::size_t i = 0; i < COMPONENT_COUNT; i++)
+        this->data[i] -= e[i];
+    return *this;
+}
+
+template <typename Real>
+template <typename E>
+constexpr Vector4<Real>::Vector4(const VectorExpression<Real, 4, E>& e) : data() {
+    for (std::size_t i = 0; i < COMPONENT_COUNT; i++)
+        this->data[i] = e[i];
+}
+
+template <typename Real>
+template <typename E>
+constexpr Vector4<Real>& Vector4<Real>::operator = (const VectorExpression<Real, 4, E>& e) {
+    for (std::size_t i = 0; i < COMPONENT_COUNT; i++)
+        this->data[i] = e[i];
+    return *this;
+}
+
+template <typename Real>
+template <typename E>
+constexpr Vector4<Real>& Vector4<Real>::operator += (const VectorExpression<Real, 4, E>& e) {
+    for (std::size_t i = 0; i < COMPONENT_COUNT; i++)
+        this->data[i] += e[i];
+    return *this;
+}
+
+template <typename Real>
+template <typename E>
+constexpr Vector4<Real>& Vector4<Real>::operator -= (const VectorExpression<Real, 4, E>& e) {
+    for (std::size_t i = 0; i < COMPONENT_COUNT; i++)
+        this->data[i] -= e[i];
+    return *this;
+}
+
+/* Compile time check: an expression is evaluated by the constexpr constructor. */
+static_assert(Vector3<float>(Lazy(Vector3<float>(1, 2, 3)) * 2.0f - Vector3<float>(1, 1, 1)) == Vector3<float>(1, 3, 5),
+    "[VectorExpression] Error: Expressions are not folded at compile time.");
+
+#endif
\ No newline at end of file